@@ -0,0 +1,98 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+/* Shared by the benchmarks in this directory. Each benchmark is one program, built with every source file in src and run
+ * from the repository root so the demo files are found, eg:
+ *
+ * cc -O2 -Iinc -o bones bench/bones.c src/[A-Za-z]*.c -lm
+ * cl /O2 -Iinc bench\bones.c src\*.c */
+
+#ifndef SPINE_BENCH_H_
+#define SPINE_BENCH_H_
+
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 199309L
+#endif
+
+#include <spine/spine.h>
+#include <spine/extension.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+void _spAtlasPage_createTexture(spAtlasPage *self, const char *path) {
+	UNUSED(path);
+	self->width = 1;
+	self->height = 1;
+}
+
+void _spAtlasPage_disposeTexture(spAtlasPage *self) {
+	UNUSED(self);
+}
+
+char *_spUtil_readFile(const char *path, int *length) {
+	return _spReadFile(path, length);
+}
+
+/* Returns wall clock seconds. */
+double bench_now(void) {
+#ifdef _WIN32
+	LARGE_INTEGER counter, frequency;
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+	return (double) counter.QuadPart / (double) frequency.QuadPart;
+#else
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (double) now.tv_sec + (double) now.tv_nsec * 1e-9;
+#endif
+}
+
+/* Loads spineboy. The atlas must be disposed after the skeleton data. */
+spSkeletonData *bench_loadSkeletonData(spAtlas **atlas) {
+	spSkeletonJson *json;
+	spSkeletonData *skeletonData;
+	*atlas = spAtlas_createFromFile("demo/spineboy-pma.atlas", 0);
+	json = spSkeletonJson_create(*atlas);
+	skeletonData = spSkeletonJson_readSkeletonDataFile(json, "demo/spineboy-pro.json");
+	if (!skeletonData) {
+		printf("Error loading demo/spineboy-pro.json: %s\n", json->error);
+		exit(1);
+	}
+	spSkeletonJson_dispose(json);
+	return skeletonData;
+}
+
+#endif /* SPINE_BENCH_H_ */
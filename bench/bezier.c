@@ -0,0 +1,212 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+/* Measures each spBezierEvaluation on spineboy's rotate, translate and RGBA timelines, applying every timeline at evenly
+ * spaced times inside each of its bezier segments. The error is against the bezier solved in double precision from its
+ * control points. Uniform and analytic must be at least as accurate as sampled. Build with -DSPINE_NO_SIMD to measure the
+ * scalar Newton's method. */
+
+#include "bench.h"
+#include <math.h>
+
+#define STEPS 64
+#define REPEATS 40
+#define TYPES 3
+
+typedef struct {
+	int animation, timeline;
+	float time;
+} Sample;
+
+static const spTimelineType types[TYPES] = {SP_TIMELINE_ROTATE, SP_TIMELINE_TRANSLATE, SP_TIMELINE_RGBA};
+static const char *typeNames[TYPES] = {"rotate", "translate", "rgba"};
+static const char *evaluationNames[] = {"sampled", "uniform", "analytic"};
+
+static spSkeletonData *load(spAtlas *atlas, spBezierEvaluation evaluation) {
+	spSkeletonJson *json = spSkeletonJson_create(atlas);
+	spSkeletonData *skeletonData;
+	json->bezierEvaluation = evaluation;
+	skeletonData = spSkeletonJson_readSkeletonDataFile(json, "demo/spineboy-pro.json");
+	if (!skeletonData) {
+		printf("Error loading demo/spineboy-pro.json: %s\n", json->error);
+		exit(1);
+	}
+	spSkeletonJson_dispose(json);
+	return skeletonData;
+}
+
+static double getPoint(double p0, double p1, double p2, double p3, double t) {
+	double u = 1 - t;
+	return u * u * u * p0 + 3 * u * t * (u * p1 + t * p2) + t * t * t * p3;
+}
+
+/* The exact value of the bezier for the value offset at the time, from an analytic timeline's control points. */
+static double getExpected(spCurveTimeline *timeline, int frame, int valueOffset, float time) {
+	int entries = timeline->super.frameEntries, i;
+	float *frames = timeline->super.frames->items;
+	float *curve = timeline->curves->items + (int) timeline->curves->items[frame] - 2 + (valueOffset - 1) * 18;
+	double time1 = frames[frame * entries], time2 = frames[(frame + 1) * entries], low = 0, high = 1, t = 0.5;
+	for (i = 0; i < 60; i++) {
+		t = (low + high) / 2;
+		if (getPoint(time1, curve[0], curve[2], time2, t) < time)
+			low = t;
+		else
+			high = t;
+	}
+	return getPoint(frames[frame * entries + valueOffset], curve[1], curve[3], frames[(frame + 1) * entries + valueOffset],
+					t);
+}
+
+/* Returns the number of values the timeline applied to the skeleton. */
+static int getApplied(spTimeline *timeline, spSkeleton *skeleton, float *values) {
+	switch (timeline->type) {
+		case SP_TIMELINE_ROTATE: {
+			spBone *bone = skeleton->bones[((spRotateTimeline *) timeline)->boneIndex];
+			values[0] = bone->rotation - bone->data->rotation;
+			return 1;
+		}
+		case SP_TIMELINE_TRANSLATE: {
+			spBone *bone = skeleton->bones[((spTranslateTimeline *) timeline)->boneIndex];
+			values[0] = bone->x - bone->data->x;
+			values[1] = bone->y - bone->data->y;
+			return 2;
+		}
+		default: {
+			spColor *color = &skeleton->slots[((spRGBATimeline *) timeline)->slotIndex]->color;
+			values[0] = color->r;
+			values[1] = color->g;
+			values[2] = color->b;
+			values[3] = color->a;
+			return 4;
+		}
+	}
+}
+
+/* Collects the times inside the bezier segments of the timelines of the type converted to analytic, which are the ones
+ * converted by every evaluation. */
+static Sample *collectSamples(spSkeletonData *analytic, spTimelineType type, int *count) {
+	Sample *samples = 0;
+	int pass, a, i, frame, step;
+	for (pass = 0; pass < 2; pass++) {
+		*count = 0;
+		for (a = 0; a < analytic->animationsCount; a++) {
+			spTimelineArray *timelines = analytic->animations[a]->timelines;
+			for (i = 0; i < timelines->size; i++) {
+				spCurveTimeline *timeline = (spCurveTimeline *) timelines->items[i];
+				float *frames = timeline->super.frames->items;
+				int entries = timeline->super.frameEntries;
+				if (timeline->super.type != type || timeline->bezierEvaluation != SP_BEZIER_ANALYTIC) continue;
+				for (frame = 0; frame < timeline->super.frameCount - 1; frame++) {
+					float time1 = frames[frame * entries], time2 = frames[(frame + 1) * entries];
+					if (timeline->curves->items[frame] < 2) continue;
+					for (step = 1; step < STEPS; step++, (*count)++) {
+						if (!samples) continue;
+						samples[*count].animation = a;
+						samples[*count].timeline = i;
+						samples[*count].time = time1 + (time2 - time1) * step / STEPS;
+					}
+				}
+			}
+		}
+		if (!samples) samples = MALLOC(Sample, *count);
+	}
+	return samples;
+}
+
+static double getError(spSkeletonData *skeletonData, spSkeletonData *analytic, spSkeleton *skeleton, Sample *samples,
+					   int count) {
+	double maxError = 0;
+	int i, ii;
+	for (i = 0; i < count; i++) {
+		spTimeline *timeline = skeletonData->animations[samples[i].animation]->timelines->items[samples[i].timeline];
+		spCurveTimeline *reference = (spCurveTimeline *) analytic->animations[samples[i].animation]
+											 ->timelines->items[samples[i].timeline];
+		float values[4];
+		int frame = _spTimeline_search(reference->super.frames->items, reference->super.frames->size, samples[i].time,
+									   reference->super.frameEntries, 0) /
+					reference->super.frameEntries;
+		int n = (spTimeline_apply(timeline, skeleton, samples[i].time, samples[i].time, 0, 0, 1, SP_MIX_BLEND_SETUP,
+								  SP_MIX_DIRECTION_IN),
+				 getApplied(timeline, skeleton, values));
+		for (ii = 0; ii < n; ii++)
+			maxError = MAX(maxError, fabs(values[ii] - getExpected(reference, frame, ii + 1, samples[i].time)));
+	}
+	return maxError;
+}
+
+static double measure(spSkeletonData *skeletonData, spSkeleton *skeleton, Sample *samples, int count) {
+	double start = bench_now();
+	int repeat, i;
+	for (repeat = 0; repeat < REPEATS; repeat++) {
+		for (i = 0; i < count; i++) {
+			spTimeline *timeline = skeletonData->animations[samples[i].animation]->timelines->items[samples[i].timeline];
+			spTimeline_apply(timeline, skeleton, samples[i].time, samples[i].time, 0, 0, 1, SP_MIX_BLEND_SETUP,
+							 SP_MIX_DIRECTION_IN);
+		}
+	}
+	return (bench_now() - start) * 1e9 / ((double) REPEATS * count);
+}
+
+int main(void) {
+	spAtlas *atlas = spAtlas_createFromFile("demo/spineboy-pma.atlas", 0);
+	spSkeletonData *skeletonData[3];
+	spSkeleton *skeleton[3];
+	int type, evaluation, count, failed = 0;
+	for (evaluation = SP_BEZIER_SAMPLED; evaluation <= SP_BEZIER_ANALYTIC; evaluation++) {
+		skeletonData[evaluation] = load(atlas, (spBezierEvaluation) evaluation);
+		skeleton[evaluation] = spSkeleton_create(skeletonData[evaluation]);
+	}
+
+	for (type = 0; type < TYPES; type++) {
+		Sample *samples = collectSamples(skeletonData[SP_BEZIER_ANALYTIC], types[type], &count);
+		double sampledError = 0;
+		printf("%s, %d times\n", typeNames[type], count);
+		for (evaluation = SP_BEZIER_SAMPLED; evaluation <= SP_BEZIER_ANALYTIC; evaluation++) {
+			double error = getError(skeletonData[evaluation], skeletonData[SP_BEZIER_ANALYTIC], skeleton[evaluation],
+									samples, count);
+			double ns;
+			measure(skeletonData[evaluation], skeleton[evaluation], samples, count);
+			ns = MIN(measure(skeletonData[evaluation], skeleton[evaluation], samples, count),
+					 measure(skeletonData[evaluation], skeleton[evaluation], samples, count));
+			printf("  %-9s %6.1f ns per apply, max error %.3g\n", evaluationNames[evaluation], ns, error);
+			if (evaluation == SP_BEZIER_SAMPLED)
+				sampledError = error;
+			else if (error > sampledError)
+				failed = 1;
+		}
+		FREE(samples);
+	}
+
+	for (evaluation = SP_BEZIER_SAMPLED; evaluation <= SP_BEZIER_ANALYTIC; evaluation++) {
+		spSkeleton_dispose(skeleton[evaluation]);
+		spSkeletonData_dispose(skeletonData[evaluation]);
+	}
+	spAtlas_dispose(atlas);
+	return failed;
+}
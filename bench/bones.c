@@ -0,0 +1,188 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+/* Measures spSkeleton_updateWorldTransform, which computes bones at the same hierarchy depth together, against
+ * spBone_update called for each bone, and checks that each bone's world transform is within the documented tolerance of
+ * spBone_updateWorldTransformWith given the same parent. Build with -DSPINE_NO_SIMD to measure the scalar fallback. */
+
+#include "bench.h"
+#include <math.h>
+
+#define CHAINS 20
+#define CHAIN_LENGTH 15
+#define POSES 64
+#define ITERATIONS 20000
+
+/* Relative to the bone's scale times the parent's matrix, per level of the hierarchy. */
+#define TOLERANCE 2.4e-7
+
+static spSkeletonData *createRig(void) {
+	spSkeletonData *data = spSkeletonData_create();
+	int i, ii;
+	data->bonesCount = 1 + CHAINS * CHAIN_LENGTH;
+	data->bones = MALLOC(spBoneData *, data->bonesCount);
+	data->bones[0] = spBoneData_create(0, "root", 0);
+	for (i = 0; i < CHAINS; i++) {
+		spBoneData *parent = data->bones[0];
+		for (ii = 0; ii < CHAIN_LENGTH; ii++) {
+			int index = 1 + i * CHAIN_LENGTH + ii;
+			char name[32];
+			sprintf(name, "bone%d", index);
+			parent = data->bones[index] = spBoneData_create(index, name, parent);
+			parent->x = 10;
+			parent->rotation = (float) (i * 360 / CHAINS);
+		}
+	}
+	spSkeletonData_updateIndex(data);
+	return data;
+}
+
+static float randomRange(float min, float max) {
+	return min + (max - min) * (float) rand() / (float) RAND_MAX;
+}
+
+static void setPose(spSkeleton *skeleton, float *poses, int pose) {
+	int i;
+	float *values = poses + pose * skeleton->bonesCount * 5;
+	for (i = 1; i < skeleton->bonesCount; i++, values += 5) {
+		spBone *bone = skeleton->bones[i];
+		bone->rotation = values[0];
+		bone->scaleX = values[1];
+		bone->scaleY = values[2];
+		bone->shearX = values[3];
+		bone->shearY = values[4];
+	}
+}
+
+/* The update before bones were computed together: spBone_update for each bone in update order. */
+static void updateEachBone(spSkeleton *skeleton) {
+	_spSkeleton *internal = SUB_CAST(_spSkeleton, skeleton);
+	int i;
+	for (i = 0; i < skeleton->bonesCount; i++) {
+		spBone *bone = skeleton->bones[i];
+		bone->ax = bone->x;
+		bone->ay = bone->y;
+		bone->arotation = bone->rotation;
+		bone->ascaleX = bone->scaleX;
+		bone->ascaleY = bone->scaleY;
+		bone->ashearX = bone->shearX;
+		bone->ashearY = bone->shearY;
+	}
+	for (i = 0; i < internal->updateCacheCount; i++)
+		spBone_update((spBone *) internal->updateCache[i].object);
+}
+
+/* Returns the largest error of a bone's world transform relative to the bone's scale and its parent's matrix. */
+static double checkTolerance(spSkeleton *skeleton) {
+	double maxError = 0;
+	int i, ii;
+	for (i = 1; i < skeleton->bonesCount; i++) {
+		spBone *bone = skeleton->bones[i], *parent = bone->parent;
+		float actual[6], expected[6];
+		double scale = MAX(fabs(bone->ascaleX), fabs(bone->ascaleY));
+		double parentNorm = fabs(parent->a) + fabs(parent->b) + fabs(parent->c) + fabs(parent->d);
+		double translation = parentNorm * (fabs(bone->ax) + fabs(bone->ay));
+		actual[0] = bone->a;
+		actual[1] = bone->b;
+		actual[2] = bone->c;
+		actual[3] = bone->d;
+		actual[4] = bone->worldX;
+		actual[5] = bone->worldY;
+		spBone_updateWorldTransformWith(bone, bone->ax, bone->ay, bone->arotation, bone->ascaleX, bone->ascaleY,
+										bone->ashearX, bone->ashearY);
+		expected[0] = bone->a;
+		expected[1] = bone->b;
+		expected[2] = bone->c;
+		expected[3] = bone->d;
+		expected[4] = bone->worldX;
+		expected[5] = bone->worldY;
+		for (ii = 0; ii < 6; ii++) {
+			double error = fabs(actual[ii] - expected[ii]);
+			if (error == 0) continue;
+			error /= ii < 4 ? scale * parentNorm : translation;
+			maxError = MAX(maxError, error);
+		}
+		bone->a = actual[0];
+		bone->b = actual[1];
+		bone->c = actual[2];
+		bone->d = actual[3];
+		bone->worldX = actual[4];
+		bone->worldY = actual[5];
+	}
+	return maxError;
+}
+
+static double measure(spSkeleton *skeleton, float *poses, int eachBone) {
+	double start = bench_now();
+	int i;
+	for (i = 0; i < ITERATIONS; i++) {
+		setPose(skeleton, poses, i % POSES);
+		if (eachBone)
+			updateEachBone(skeleton);
+		else
+			spSkeleton_updateWorldTransform(skeleton, SP_PHYSICS_NONE);
+	}
+	return (bench_now() - start) * 1e9 / ITERATIONS;
+}
+
+int main(void) {
+	spSkeletonData *data = createRig();
+	spSkeleton *skeleton = spSkeleton_create(data);
+	float *poses = MALLOC(float, POSES * skeleton->bonesCount * 5);
+	double maxError = 0, eachBone, together;
+	int i;
+
+	for (i = 0; i < POSES * skeleton->bonesCount * 5; i += 5) {
+		poses[i] = randomRange(-720, 720);
+		poses[i + 1] = randomRange(0.5f, 1.5f);
+		poses[i + 2] = randomRange(-1.5f, 1.5f);
+		poses[i + 3] = randomRange(-30, 30);
+		poses[i + 4] = randomRange(-30, 30);
+	}
+	for (i = 0; i < POSES; i++) {
+		setPose(skeleton, poses, i);
+		spSkeleton_updateWorldTransform(skeleton, SP_PHYSICS_NONE);
+		maxError = MAX(maxError, checkTolerance(skeleton));
+	}
+
+	/* Warm up, then measure each way twice and keep the faster. */
+	measure(skeleton, poses, 0);
+	eachBone = MIN(measure(skeleton, poses, -1), measure(skeleton, poses, -1));
+	together = MIN(measure(skeleton, poses, 0), measure(skeleton, poses, 0));
+	printf("%d bones, %d at each depth\n", skeleton->bonesCount, CHAINS);
+	printf("spBone_update per bone:         %8.0f ns\n", eachBone);
+	printf("spSkeleton_updateWorldTransform: %8.0f ns (%.2fx)\n", together, eachBone / together);
+	printf("max error %.3g, tolerance %.3g\n", maxError, TOLERANCE);
+
+	spSkeleton_dispose(skeleton);
+	spSkeletonData_dispose(data);
+	FREE(poses);
+	return maxError <= TOLERANCE ? 0 : 1;
+}
@@ -0,0 +1,207 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+/* Measures deform timelines on a rig of unweighted 800 vertex meshes, where each key moves 40 vertices like an eyelid
+ * blink and the first and last keys are the setup pose. The keys are set once with spDeformTimeline_setFrameRange, which
+ * stores only the changed vertices, and once with spDeformTimeline_setFrame, which stores every vertex. Reports the
+ * memory of the keys and the time to apply them with set, replace and add blending. Both must deform the meshes the
+ * same. Build with -DSPINE_NO_SIMD to measure the scalar loops. */
+
+#include "bench.h"
+#include <math.h>
+
+#define MESHES 8
+#define VERTICES 800
+#define CHANGED 40
+#define KEYS 5
+#define KEY_TIME 0.25f
+#define STEPS 240
+#define REPEATS 200
+#define MODES 3
+#define TOLERANCE 1e-4
+
+typedef struct {
+	const char *name;
+	float alpha;
+	spMixBlend blend;
+} Mode;
+
+static const Mode modes[MODES] = {
+		{"set", 1, SP_MIX_BLEND_SETUP}, {"replace", 0.5f, SP_MIX_BLEND_REPLACE}, {"add", 1, SP_MIX_BLEND_ADD}};
+
+static spSkeletonData *createData(void) {
+	spSkeletonData *data = spSkeletonData_create();
+	int i;
+	data->bonesCount = 1;
+	data->bones = MALLOC(spBoneData *, 1);
+	data->bones[0] = spBoneData_create(0, "root", 0);
+	data->slotsCount = MESHES;
+	data->slots = MALLOC(spSlotData *, MESHES);
+	for (i = 0; i < MESHES; i++) {
+		char name[32];
+		sprintf(name, "face%d", i);
+		data->slots[i] = spSlotData_create(i, name, data->bones[0]);
+	}
+	spSkeletonData_updateIndex(data);
+	return data;
+}
+
+/* A grid of vertices, unweighted so the setup pose is the mesh's vertices. */
+static spMeshAttachment *createMesh(int index) {
+	spMeshAttachment *mesh;
+	char name[32];
+	int i;
+	sprintf(name, "face%d", index);
+	mesh = spMeshAttachment_create(name);
+	mesh->super.verticesCount = mesh->super.worldVerticesLength = VERTICES * 2;
+	mesh->super.vertices = MALLOC(float, VERTICES * 2);
+	for (i = 0; i < VERTICES; i++) {
+		mesh->super.vertices[i * 2] = (float) (i % 40) * 10;
+		mesh->super.vertices[i * 2 + 1] = (float) (i / 40) * 10;
+	}
+	return mesh;
+}
+
+/* Each mesh blinks a different run of vertices. */
+static spTimeline *createTimeline(spMeshAttachment *mesh, int slotIndex, int /*boolean*/ sparse) {
+	spDeformTimeline *timeline = spDeformTimeline_create(KEYS, VERTICES * 2, 0, slotIndex, SUPER(mesh));
+	int start = slotIndex * (VERTICES * 2 - CHANGED * 2) / MESHES, end = start, key, i;
+	float vertices[VERTICES * 2];
+	for (key = 0; key < KEYS; key++) {
+		memcpy(vertices, mesh->super.vertices, sizeof(vertices));
+		end = key == 0 || key == KEYS - 1 ? start : start + CHANGED * 2;
+		for (i = start; i < end; i++) vertices[i] += (float) (key * (i % 7)) - 9;
+		if (sparse)
+			spDeformTimeline_setFrameRange(timeline, key, key * KEY_TIME, vertices, start, end);
+		else
+			spDeformTimeline_setFrame(timeline, key, key * KEY_TIME, vertices);
+	}
+	return SUPER(SUPER(timeline));
+}
+
+static size_t getKeyBytes(spTimeline **timelines) {
+	size_t bytes = 0;
+	int i, key;
+	for (i = 0; i < MESHES; i++) {
+		spDeformTimeline *timeline = (spDeformTimeline *) timelines[i];
+		for (key = 0; key < KEYS; key++) {
+			int count = timeline->frameRanges ? timeline->frameRanges[key * 2 + 1] - timeline->frameRanges[key * 2]
+											  : timeline->frameVertices[key] ? timeline->frameVerticesCount
+																			 : 0;
+			bytes += sizeof(float) * count;
+		}
+		if (timeline->frameRanges) bytes += sizeof(int) * 2 * KEYS;
+	}
+	return bytes;
+}
+
+static void apply(spTimeline **timelines, spSkeleton *skeleton, float time, const Mode *mode) {
+	int i;
+	for (i = 0; i < MESHES; i++)
+		spTimeline_apply(timelines[i], skeleton, time, time, 0, 0, mode->alpha, mode->blend, SP_MIX_DIRECTION_IN);
+}
+
+static void reset(spSkeleton *skeleton) {
+	int i;
+	for (i = 0; i < MESHES; i++) skeleton->slots[i]->deformCount = 0;
+}
+
+/* Returns the time per timeline applied, stepping through the keys. */
+static double measure(spTimeline **timelines, spSkeleton *skeleton, const Mode *mode) {
+	double start;
+	int repeat, step;
+	reset(skeleton);
+	start = bench_now();
+	for (repeat = 0; repeat < REPEATS; repeat++)
+		for (step = 0; step < STEPS; step++) apply(timelines, skeleton, step * (KEYS - 1) * KEY_TIME / STEPS, mode);
+	return (bench_now() - start) * 1e9 / ((double) REPEATS * STEPS * MESHES);
+}
+
+/* Returns the largest difference between the sparse and dense deforms, stepping past both ends of the keys. */
+static double getError(spTimeline **sparse, spSkeleton *sparseSkeleton, spTimeline **dense, spSkeleton *denseSkeleton,
+					   const Mode *mode) {
+	double maxError = 0;
+	int step, i, ii;
+	reset(sparseSkeleton);
+	reset(denseSkeleton);
+	for (step = -2; step <= STEPS + 2; step++) {
+		float time = step * (KEYS - 1) * KEY_TIME / STEPS;
+		apply(sparse, sparseSkeleton, time, mode);
+		apply(dense, denseSkeleton, time, mode);
+		for (i = 0; i < MESHES; i++) {
+			spSlot *sparseSlot = sparseSkeleton->slots[i], *denseSlot = denseSkeleton->slots[i];
+			if (sparseSlot->deformCount != denseSlot->deformCount) return HUGE_VAL;
+			for (ii = 0; ii < sparseSlot->deformCount; ii++)
+				maxError = MAX(maxError, fabs(sparseSlot->deform[ii] - denseSlot->deform[ii]));
+		}
+	}
+	return maxError;
+}
+
+int main(void) {
+	spSkeletonData *skeletonData = createData();
+	spSkeleton *sparseSkeleton = spSkeleton_create(skeletonData), *denseSkeleton = spSkeleton_create(skeletonData);
+	spMeshAttachment *meshes[MESHES];
+	spTimeline *sparse[MESHES], *dense[MESHES];
+	size_t sparseBytes, denseBytes;
+	double maxError = 0;
+	int i;
+	for (i = 0; i < MESHES; i++) {
+		meshes[i] = createMesh(i);
+		spSlot_setAttachment(sparseSkeleton->slots[i], SUPER(SUPER(meshes[i])));
+		spSlot_setAttachment(denseSkeleton->slots[i], SUPER(SUPER(meshes[i])));
+		sparse[i] = createTimeline(meshes[i], i, 1);
+		dense[i] = createTimeline(meshes[i], i, 0);
+	}
+
+	sparseBytes = getKeyBytes(sparse);
+	denseBytes = getKeyBytes(dense);
+	printf("%d meshes, %d vertices, %d changed per key\n", MESHES, VERTICES, CHANGED);
+	printf("  keys     dense %7d bytes, sparse %7d bytes\n", (int) denseBytes, (int) sparseBytes);
+	for (i = 0; i < MODES; i++) {
+		double denseNs, sparseNs, error = getError(sparse, sparseSkeleton, dense, denseSkeleton, &modes[i]);
+		measure(dense, denseSkeleton, &modes[i]);
+		denseNs = MIN(measure(dense, denseSkeleton, &modes[i]), measure(dense, denseSkeleton, &modes[i]));
+		measure(sparse, sparseSkeleton, &modes[i]);
+		sparseNs = MIN(measure(sparse, sparseSkeleton, &modes[i]), measure(sparse, sparseSkeleton, &modes[i]));
+		printf("  %-8s dense %7.1f ns per apply, sparse %7.1f ns per apply, max error %.3g\n", modes[i].name, denseNs,
+			   sparseNs, error);
+		maxError = MAX(maxError, error);
+	}
+
+	for (i = 0; i < MESHES; i++) {
+		spTimeline_dispose(sparse[i]);
+		spTimeline_dispose(dense[i]);
+	}
+	spSkeleton_dispose(sparseSkeleton);
+	spSkeleton_dispose(denseSkeleton);
+	for (i = 0; i < MESHES; i++) spAttachment_dispose(SUPER(SUPER(meshes[i])));
+	spSkeletonData_dispose(skeletonData);
+	return maxError <= TOLERANCE && sparseBytes < denseBytes ? 0 : 1;
+}
@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+/* Measures an animation of rotate timelines played forward at twice its key rate, with 10 to 10000 keys per timeline,
+ * applied with a frame cursor for each timeline as spAnimationState does and without, which binary searches every apply.
+ * The binary search grows with the logarithm of the keys while the cursor's cost per apply stays flat, until the frames
+ * no longer fit in the cache. Both must apply the same rotations at every time. */
+
+#include "bench.h"
+
+#define SIZES 4
+#define TIMELINES 16
+#define KEY_TIME (1 / 30.0f)
+#define STEP (KEY_TIME / 2)
+#define APPLIES 4000000
+
+static const int keys[SIZES] = {10, 100, 1000, 10000};
+
+static spSkeletonData *createData(void) {
+	spSkeletonData *data = spSkeletonData_create();
+	int i;
+	data->bonesCount = TIMELINES;
+	data->bones = MALLOC(spBoneData *, TIMELINES);
+	data->bones[0] = spBoneData_create(0, "root", 0);
+	for (i = 1; i < TIMELINES; i++) {
+		char name[32];
+		sprintf(name, "bone%d", i);
+		data->bones[i] = spBoneData_create(i, name, data->bones[0]);
+	}
+	spSkeletonData_updateIndex(data);
+	return data;
+}
+
+/* Each bone gets a timeline. The key times are jittered so the timelines don't share a branch pattern when searched. */
+static void createTimelines(spTimeline **timelines, int keysCount) {
+	int i, ii;
+	srand(1);
+	for (i = 0; i < TIMELINES; i++) {
+		spRotateTimeline *timeline = spRotateTimeline_create(keysCount, 0, i);
+		for (ii = 0; ii < keysCount; ii++) {
+			float jitter = KEY_TIME / 2 * (float) rand() / (float) RAND_MAX;
+			spRotateTimeline_setFrame(timeline, ii, ii * KEY_TIME + jitter, (float) ((ii + i) % 8) * 15);
+		}
+		timelines[i] = SUPER(SUPER(timeline));
+	}
+}
+
+/* Clears the skeleton's cursor afterward, as spAnimationState does, so applying without cursors searches. */
+static void apply(spTimeline **timelines, int *cursors, spSkeleton *skeleton, float time) {
+	_spTimeline_applyBatch(timelines, cursors, TIMELINES, skeleton, time, time, 0, 0, 1, SP_MIX_BLEND_SETUP,
+						   SP_MIX_DIRECTION_IN);
+	SUB_CAST(_spSkeleton, skeleton)->timelineCursor = 0;
+}
+
+/* Plays the timelines from the start, looping when they end. cursors may be 0 to search without them. */
+static double measure(spTimeline **timelines, int *cursors, spSkeleton *skeleton) {
+	float duration = spTimeline_getDuration(timelines[0]), time = 0;
+	double start = bench_now();
+	int i;
+	for (i = 0; i < APPLIES / TIMELINES; i++) {
+		apply(timelines, cursors, skeleton, time);
+		time += STEP;
+		if (time > duration) time = 0;
+	}
+	return (bench_now() - start) * 1e9 / (APPLIES / TIMELINES * TIMELINES);
+}
+
+/* Returns the number of rotations the cursors applied differently than the binary search. */
+static int getMismatches(spTimeline **timelines, spSkeleton *skeleton) {
+	float duration = spTimeline_getDuration(timelines[0]), time, rotations[TIMELINES];
+	int cursors[TIMELINES] = {0}, mismatches = 0, i;
+	for (time = -STEP; time <= duration + STEP; time += STEP / 3) {
+		apply(timelines, 0, skeleton, time);
+		for (i = 0; i < TIMELINES; i++) rotations[i] = skeleton->bones[i]->rotation;
+		apply(timelines, cursors, skeleton, time);
+		for (i = 0; i < TIMELINES; i++)
+			if (skeleton->bones[i]->rotation != rotations[i]) mismatches++;
+	}
+	return mismatches;
+}
+
+int main(void) {
+	spSkeletonData *skeletonData = createData();
+	spSkeleton *skeleton = spSkeleton_create(skeletonData);
+	double cursorMin = 0, cursorMax = 0;
+	int i, ii, mismatches = 0;
+	for (i = 0; i < SIZES; i++) {
+		spTimeline *timelines[TIMELINES];
+		int cursors[TIMELINES] = {0};
+		double searchNs, cursorNs;
+		createTimelines(timelines, keys[i]);
+		mismatches += getMismatches(timelines, skeleton);
+		measure(timelines, 0, skeleton);
+		searchNs = MIN(measure(timelines, 0, skeleton), measure(timelines, 0, skeleton));
+		measure(timelines, cursors, skeleton);
+		cursorNs = MIN(measure(timelines, cursors, skeleton), measure(timelines, cursors, skeleton));
+		printf("%5d keys: search %5.1f ns per apply, cursor %5.1f ns per apply\n", keys[i], searchNs, cursorNs);
+		cursorMin = i ? MIN(cursorMin, cursorNs) : cursorNs;
+		cursorMax = i ? MAX(cursorMax, cursorNs) : cursorNs;
+		for (ii = 0; ii < TIMELINES; ii++) spTimeline_dispose(timelines[ii]);
+	}
+	printf("cursor slowest/fastest: %.2fx, mismatches: %d\n", cursorMax / cursorMin, mismatches);
+
+	spSkeleton_dispose(skeleton);
+	spSkeletonData_dispose(skeletonData);
+	return mismatches ? 1 : 0;
+}
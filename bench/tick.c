@@ -0,0 +1,133 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+/* Measures how spTickPool_tick scales from 1 thread to the number of processors, or to the thread count given as the
+ * first argument. Each configuration ticks the same instances from the same start, and the listener notifications must
+ * arrive in the same order for every thread count. Link with -lpthread where needed. */
+
+#include "bench.h"
+
+#define INSTANCES 2000
+#define WARMUP_FRAMES 10
+#define FRAMES 200
+
+typedef struct {
+	unsigned int hash;
+	int count;
+} Notifications;
+
+static void listener(spAnimationState *state, spEventType type, spTrackEntry *entry, spEvent *event) {
+	Notifications *notifications = (Notifications *) state->userData;
+	unsigned int value = (unsigned int) type * 31 + (unsigned int) entry->trackIndex;
+	if (event) value = value * 31 + (unsigned int) event->data->intValue + (unsigned int) (event->time * 1000);
+	notifications->hash = (notifications->hash ^ value) * 16777619u;
+	notifications->count++;
+}
+
+static void createInstances(spSkeletonData *skeletonData, spAnimationStateData *stateData, spTickInstance *instances,
+							Notifications *notifications) {
+	static const char *names[] = {"walk", "run", "idle", "jump", "shoot"};
+	int i;
+	srand(1);
+	for (i = 0; i < INSTANCES; i++) {
+		spTrackEntry *entry;
+		instances[i].skeleton = spSkeleton_create(skeletonData);
+		instances[i].state = spAnimationState_create(stateData);
+		instances[i].state->listener = listener;
+		instances[i].state->userData = notifications;
+		entry = spAnimationState_setAnimationByName(instances[i].state, 0, names[rand() % 3], -1);
+		entry->trackTime = (float) rand() / (float) RAND_MAX;
+		spAnimationState_addAnimationByName(instances[i].state, 1, names[3 + rand() % 2], 0, 0.5f + (float) (rand() % 4));
+	}
+}
+
+static void disposeInstances(spTickInstance *instances) {
+	int i;
+	for (i = 0; i < INSTANCES; i++) {
+		instances[i].state->listener = 0;
+		spAnimationState_dispose(instances[i].state);
+		spSkeleton_dispose(instances[i].skeleton);
+	}
+}
+
+/* Doubles the thread count, ending with maxThreads. */
+static int nextThreadsCount(int threadsCount, int maxThreads) {
+	return threadsCount == maxThreads ? maxThreads + 1 : MIN(threadsCount * 2, maxThreads);
+}
+
+int main(int argc, char **argv) {
+	spAtlas *atlas;
+	spSkeletonData *skeletonData = bench_loadSkeletonData(&atlas);
+	spAnimationStateData *stateData = spAnimationStateData_create(skeletonData);
+	spTickInstance *instances = MALLOC(spTickInstance, INSTANCES);
+	Notifications notifications, first = {0, 0};
+	spTickPool *pool;
+	double start, seconds, baseline = 0;
+	int i, threadsCount, maxThreads;
+
+	if (argc > 1)
+		maxThreads = atoi(argv[1]);
+	else {
+		pool = spTickPool_create(0);
+		maxThreads = pool->threadsCount;
+		spTickPool_dispose(pool);
+	}
+	stateData->defaultMix = 0.2f;
+
+	printf("%d instances, %d frames\n", INSTANCES, FRAMES);
+	for (threadsCount = 1; threadsCount <= maxThreads; threadsCount = nextThreadsCount(threadsCount, maxThreads)) {
+		pool = spTickPool_create(threadsCount);
+		notifications.hash = 2166136261u;
+		notifications.count = 0;
+		createInstances(skeletonData, stateData, instances, &notifications);
+		for (i = 0; i < WARMUP_FRAMES; i++)
+			spTickPool_tick(pool, instances, INSTANCES, 1 / 60.0f, SP_PHYSICS_UPDATE);
+		start = bench_now();
+		for (i = 0; i < FRAMES; i++)
+			spTickPool_tick(pool, instances, INSTANCES, 1 / 60.0f, SP_PHYSICS_UPDATE);
+		seconds = bench_now() - start;
+		if (threadsCount == 1) {
+			baseline = seconds;
+			first = notifications;
+		}
+		printf("%2d threads: %8.0f instance ticks/s, %.2fx, %d notifications%s\n", pool->threadsCount,
+			   INSTANCES * FRAMES / seconds, baseline / seconds, notifications.count,
+			   notifications.hash == first.hash && notifications.count == first.count ? "" : ", ORDER DIFFERS");
+		disposeInstances(instances);
+		spTickPool_dispose(pool);
+		if (notifications.hash != first.hash || notifications.count != first.count) return 1;
+	}
+
+	FREE(instances);
+	spAnimationStateData_dispose(stateData);
+	spSkeletonData_dispose(skeletonData);
+	spAtlas_dispose(atlas);
+	return 0;
+}
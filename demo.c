@@ -201,10 +201,10 @@ typedef struct SkeletonDrawable {
 
 				spRegionAttachment_computeWorldVertices(regionAttachment, slot, vertices, 0, 2);
 				verticesCount = 4;
-				uvs = regionAttachment->uvs;
+				uvs = spRegionAttachment_getUVs(regionAttachment, slot);
 				indices = quadIndices;
 				indicesCount = 6;
-				texture = (texture_t *) ((spAtlasRegion *) regionAttachment->rendererObject)->page->rendererObject;
+				texture = (texture_t *) ((spAtlasRegion *) spRegionAttachment_getRendererObject(regionAttachment, slot))->page->rendererObject;
 
 			} else if (attachment->type == SP_ATTACHMENT_MESH) {
 				spMeshAttachment *mesh = (spMeshAttachment *) attachment;
@@ -219,10 +219,10 @@ typedef struct SkeletonDrawable {
 				if (mesh->super.worldVerticesLength > SPINE_MESH_VERTEX_COUNT_MAX) continue;
 				spVertexAttachment_computeWorldVertices(SUPER(mesh), slot, 0, mesh->super.worldVerticesLength, self->worldVertices, 0, 2);
 				verticesCount = mesh->super.worldVerticesLength >> 1;
-				uvs = mesh->uvs;
+				uvs = spMeshAttachment_getUVs(mesh, slot);
 				indices = mesh->triangles;
 				indicesCount = mesh->trianglesCount;
-				texture = (texture_t *) ((spAtlasRegion *) mesh->rendererObject)->page->rendererObject;
+				texture = (texture_t *) ((spAtlasRegion *) spMeshAttachment_getRendererObject(mesh, slot))->page->rendererObject;
 
 			} else if (attachment->type == SP_ATTACHMENT_CLIPPING) {
 				spClippingAttachment *clip = (spClippingAttachment *) slot->attachment;
@@ -37,6 +37,7 @@
 #include <spine/Sequence.h>
 #include <spine/Array.h>
 #include <stdint.h>
+#include <stddef.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -56,6 +57,9 @@ typedef struct spAnimation {
 
 	spTimelineArray *timelines;
 	spPropertyIdArray *timelineIds;
+	/* Open addressing set of the timelineIds, 0 for empty buckets, so spAnimation_hasTimeline does not scan them. */
+	spPropertyId *timelineIdSet;
+	int timelineIdSetMask;
 } spAnimation;
 
 typedef enum {
@@ -192,9 +196,34 @@ SP_API float spTimeline_getDuration(const spTimeline *self);
 
 /**/
 
+/* How the BEZIER_SIZE floats stored for each bezier in spCurveTimeline curves are evaluated. */
+typedef enum {
+	SP_BEZIER_SAMPLED, /* 9 x, y points at even steps along the curve, scanned for the time. */
+	SP_BEZIER_UNIFORM, /* 18 values at even steps of time, indexed directly by the segment's percent of time. A bezier
+						* the steps would follow less closely than 0.5% of its value range, eg at a vertical tangent, is
+						* stored analytic instead. */
+	SP_BEZIER_ANALYTIC /* The control points cx1, cy1, cx2, cy2 and 13 starting guesses, solved for the time with Newton's
+						* method. The values of translate, scale, shear, color and constraint timelines are solved
+						* together with SSE where available. */
+} spBezierEvaluation;
+
 typedef struct spCurveTimeline {
 	spTimeline super;
 	spFloatArray *curves; /* type, x, y, ... */
+	spBezierEvaluation bezierEvaluation;
+
+	/* If not 0, the bezier samples were moved out of curves by spAnimation_quantizeCurves. Each x, y is stored as an 8 or
+	 * 16 bit fraction of its segment's duration and value change, mapped through the timeline's min and range. */
+	void *quantizedCurves;
+	int quantizedBits;
+	float quantizedTimeMin, quantizedTimeRange;
+	float quantizedValueMin, quantizedValueRange;
+
+	/* If not 0, the frames were moved out of frames by spAnimation_quantizeCurves, which leaves frames empty: its items
+	 * are 0 and its size is 0, while frameCount is kept. Each entry is stored as a 16 bit fraction of the range of its
+	 * column, eg the times or the red values, from the min and range for each of the frameEntries columns. */
+	unsigned short *quantizedFrames;
+	float *quantizedFrameMin, *quantizedFrameRange;
 } spCurveTimeline;
 
 SP_API void spCurveTimeline_setLinear(spCurveTimeline *self, int frameIndex);
@@ -226,6 +255,34 @@ typedef struct spCurveTimeline spCurveTimeline2;
 
 SP_API void spCurveTimeline2_setFrame(spCurveTimeline1 *self, int frame, float time, float value1, float value2);
 
+typedef struct spCurveQuantizeReport {
+	size_t bytesSaved;
+	float maxTimeError; /* Seconds. */
+	float maxValueError; /* In the units of the timeline's values, eg degrees or pixels. */
+} spCurveQuantizeReport;
+
+/* Stores the bezier samples of the animation's curve timelines with the specified number of bits, 8 or 16, and their
+ * frames with 16 bits, then adds the memory saved and the largest error to the report, which may be 0. Must be called after
+ * all frames and beziers are set. A timeline with a bezier between two equal values that does not stay flat, or not using
+ * SP_BEZIER_SAMPLED, keeps its beziers at full precision. Deform timelines, timelines with 4 keys or fewer, and timelines
+ * where two keys would decode to the same time keep their frames at full precision. Times round down, so a key is never
+ * found later than its time. The frames of a quantized timeline are gone: its frames array is left empty, and its frames
+ * must not be read or set afterward, eg with sp*Timeline_setFrame. */
+SP_API void spAnimation_quantizeCurves(spAnimation *animation, int bits, spCurveQuantizeReport *report);
+
+/* Removes keys the animation's curve timelines reproduce within the tolerance without them. Returns the number of keys
+ * removed plus the number of beziers made linear, so 0 means the animation is unchanged. The tolerance is in degrees for
+ * rotate and shear and in units for translate. Other values, which are mostly from 0 to 1, use 1/100th of it. Beziers that
+ * stay that close to a straight line become linear. Linear and stepped keys are removed. Bone timelines that hold the
+ * setup pose for their whole duration are removed, so their properties are no longer keyed by the animation when mixing.
+ * Timelines with frames quantized by spAnimation_quantizeCurves are left unchanged. Must be called before the animation is
+ * given to an animation state. */
+SP_API int spAnimation_optimize(spAnimation *self, float tolerance);
+
+/* Converts the beziers of the animation's curve timelines from SP_BEZIER_SAMPLED to the specified evaluation. Timelines
+ * already converted, or with beziers or frames quantized by spAnimation_quantizeCurves, are left unchanged. */
+SP_API void spAnimation_setBezierEvaluation(spAnimation *self, spBezierEvaluation evaluation);
+
 /**/
 
 typedef struct spRotateTimeline {
@@ -402,6 +459,9 @@ typedef struct spAttachmentTimeline {
 	spTimeline super;
 	int slotIndex;
 	char **attachmentNames;
+	/* For each frame, the key of the attachment each skeleton resolves for its skin, or -1 to look up the name. Set by the
+	 * loaders, 0 to look up every name. */
+	int *attachmentKeys;
 } spAttachmentTimeline;
 
 SP_API spAttachmentTimeline *spAttachmentTimeline_create(int framesCount, int SlotIndex);
@@ -416,6 +476,9 @@ typedef struct spDeformTimeline {
 	spCurveTimeline super;
 	int frameVerticesCount;
 	float **frameVertices;
+	/* If not 0, the start and end for each frame of the vertices that differ from the setup pose. Only those are in
+	 * frameVertices, the others are the attachment's vertices, or 0 if it is weighted. */
+	int *frameRanges;
 	int slotIndex;
 	spAttachment *attachment;
 } spDeformTimeline;
@@ -426,6 +489,13 @@ spDeformTimeline_create(int framesCount, int frameVerticesCount, int bezierCount
 
 SP_API void spDeformTimeline_setFrame(spDeformTimeline *self, int frameIndex, float time, float *vertices);
 
+/* Like spDeformTimeline_setFrame, but only the vertices from start to end differ from the setup pose. If they are fewer
+ * than half, only those are stored and the timeline uses frameRanges.
+ * @param vertices All frameVerticesCount values. */
+SP_API void
+spDeformTimeline_setFrameRange(spDeformTimeline *self, int frameIndex, float time, const float *vertices, int start,
+							   int end);
+
 /**/
 
 typedef struct spSequenceTimeline {
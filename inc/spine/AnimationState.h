@@ -35,6 +35,7 @@
 #include <spine/AnimationStateData.h>
 #include <spine/Event.h>
 #include <spine/Array.h>
+#include <spine/Physics.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -55,6 +56,14 @@ typedef struct spTrackEntry spTrackEntry;
 typedef void (*spAnimationStateListener)(spAnimationState *state, spEventType type, spTrackEntry *entry,
 										 spEvent *event);
 
+/* A notification returned by spAnimationState_drainEvents. The event is 0 unless the type is SP_ANIMATION_EVENT. */
+typedef struct spAnimationStateEvent {
+	spEventType type;
+	int trackIndex;
+	spTrackEntry *entry;
+	spEvent *event;
+} spAnimationStateEvent;
+
 _SP_ARRAY_DECLARE_TYPE(spTrackEntryArray, spTrackEntry*)
 
 struct spTrackEntry {
@@ -78,6 +87,7 @@ struct spTrackEntry {
 	spTrackEntryArray *timelineHoldMix;
 	float *timelinesRotation;
 	int timelinesRotationCount;
+	int *timelineCursors;
 	void *rendererObject;
 	void *userData;
 };
@@ -96,6 +106,9 @@ struct spAnimationState {
 	void *userData;
 
 	int unkeyedState;
+
+	/* When true, notifications are kept for spAnimationState_drainEvents instead of being sent to the listeners. */
+	int /*boolean*/ eventStream;
 };
 
 /* @param data May be 0 for no mixing. */
@@ -107,6 +120,29 @@ SP_API void spAnimationState_update(spAnimationState *self, float delta);
 
 SP_API int /**bool**/ spAnimationState_apply(spAnimationState *self, struct spSkeleton *skeleton);
 
+/* A skeleton and the animation state that poses it. */
+typedef struct spTickInstance {
+	struct spSkeleton *skeleton;
+	spAnimationState *state;
+} spTickInstance;
+
+/** Updates each instance from start (inclusive) to end (exclusive) by delta seconds: spAnimationState_update,
+ * spAnimationState_apply, spSkeleton_update and spSkeleton_updateWorldTransform. Listeners are not notified, their
+ * notifications stay queued until spAnimationState_deliverTickEvents. Disjoint ranges may be ticked by different
+ * threads at the same time, as long as no skeleton or animation state appears more than once. spTickPool does this with
+ * its own worker threads. */
+SP_API void spAnimationState_tickInstances(spTickInstance *instances, int start, int end, float delta, spPhysics physics);
+
+/** Notifies the listeners queued by spAnimationState_tickInstances on the calling thread, one instance after another
+ * in array order. */
+SP_API void spAnimationState_deliverTickEvents(spTickInstance *instances, int count);
+
+/** Returns the notifications queued since the last call when eventStream is true, in the order the listeners would
+ * have received them. The array and the track entries of its SP_ANIMATION_DISPOSE notifications stay valid until the
+ * next call, which must come regularly because disposed entries are only freed then. The array's storage is reused, so
+ * draining allocates nothing once it has grown to the largest batch. */
+SP_API const spAnimationStateEvent *spAnimationState_drainEvents(spAnimationState *self, int *count);
+
 SP_API void spAnimationState_clearTracks(spAnimationState *self);
 
 SP_API void spAnimationState_clearTrack(spAnimationState *self, int trackIndex);
@@ -140,6 +176,20 @@ SP_API spTrackEntry *spAnimationState_getCurrent(spAnimationState *self, int tra
 
 SP_API void spAnimationState_clearListenerNotifications(spAnimationState *self);
 
+typedef struct spTrackEntryPoolStats {
+	int freeCount; /* Disposed entries waiting to be reused. */
+	int created;   /* Entries allocated since the state was created. */
+	int reused;    /* Entries taken from the pool instead of being allocated. */
+	size_t bytes;  /* Memory held by the free entries and their arrays. */
+} spTrackEntryPoolStats;
+
+/** Disposed track entries are kept by the animation state, with the capacity of their arrays, and reused by the next
+ * animations set or added. */
+SP_API void spAnimationState_getTrackEntryPoolStats(spAnimationState *self, spTrackEntryPoolStats *stats);
+
+/** Frees pooled track entries until at most maxFree remain. */
+SP_API void spAnimationState_trimTrackEntryPool(spAnimationState *self, int maxFree);
+
 SP_API float spTrackEntry_getAnimationTime(spTrackEntry *entry);
 
 SP_API void spTrackEntry_resetRotationDirections(spTrackEntry *entry);
@@ -154,7 +204,7 @@ SP_API int/*bool*/  spTrackEntry_isNextReady(spTrackEntry *entry);
 
 SP_API void spAnimationState_clearNext(spAnimationState *self, spTrackEntry *entry);
 
-/** Use this to dispose static memory before your app exits to appease your memory leak detector*/
+/** Does nothing, the empty animation is disposed with its spAnimationStateData. Kept for compatibility. */
 SP_API void spAnimationState_disposeStatics(void);
 
 #ifdef __cplusplus
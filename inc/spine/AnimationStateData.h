@@ -42,6 +42,8 @@ typedef struct spAnimationStateData {
 	spSkeletonData *skeletonData;
 	float defaultMix;
 	const void *entries;
+	void *holdCache;
+	spAnimation *emptyAnimation; /* Played by the states' empty animation entries. */
 } spAnimationStateData;
 
 SP_API spAnimationStateData *spAnimationStateData_create(spSkeletonData *skeletonData);
@@ -55,6 +57,15 @@ SP_API void spAnimationStateData_setMix(spAnimationStateData *self, spAnimation
 /* Returns 0 if there is no mixing between the animations. */
 SP_API float spAnimationStateData_getMix(spAnimationStateData *self, spAnimation *from, spAnimation *to);
 
+/* Animation states using this data share the timeline modes computed for each layout of the animations on their
+ * tracks, so states playing the same transitions compute them once. At most maxLayouts are kept, 0 disables sharing.
+ * The default is 256. Clears the cache, so it must not be called while the states are being applied. */
+SP_API void spAnimationStateData_setHoldCacheSize(spAnimationStateData *self, int maxLayouts);
+
+/* Must be called when the timelines of an animation used by the states change. Not safe while the states are being
+ * applied. */
+SP_API void spAnimationStateData_clearHoldCache(spAnimationStateData *self);
+
 #ifdef __cplusplus
 }
 #endif
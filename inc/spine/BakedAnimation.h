@@ -0,0 +1,74 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_BAKEDANIMATION_H_
+#define SPINE_BAKEDANIMATION_H_
+
+#include <spine/dll.h>
+#include <spine/Animation.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct spSkeleton;
+
+/* Bone world transforms of an animation sampled at a fixed rate, with constraints and physics resolved, so skeletons can
+ * be posed without applying timelines or computing world transforms. Only bones are baked: slot colors, attachments,
+ * deform, and draw order are left as they are. */
+typedef struct spBakedAnimation {
+	spAnimation *animation;
+	float fps;
+	int framesCount;
+	int bonesCount;
+	/* For each frame, a, b, c, d, worldX, worldY for each bone. */
+	float *frames;
+} spBakedAnimation;
+
+/* Samples the animation from the setup pose at i / fps, and at the duration for the last frame, leaving the skeleton in
+ * the pose of the last frame. The world transforms are baked relative to the skeleton's x and y, but include its scale.
+ * @param fps Samples per second, eg 30. Returns 0 if fps is not > 0. */
+SP_API spBakedAnimation *spBakedAnimation_create(struct spSkeleton *skeleton, spAnimation *animation, float fps);
+
+SP_API void spBakedAnimation_dispose(spBakedAnimation *self);
+
+/* Returns the number of bytes used by the baked animation. */
+SP_API size_t spBakedAnimation_getMemorySize(const spBakedAnimation *self);
+
+/* Sets the world transforms of the skeleton's bones by interpolating linearly between the two baked frames around the
+ * time, offset by the skeleton's x and y. The time reaches the last frame at the animation's duration. Use this instead of spAnimationState_apply and
+ * spSkeleton_updateWorldTransform. */
+SP_API void spBakedAnimation_apply(const spBakedAnimation *self, struct spSkeleton *skeleton, float time, int /*boolean*/ loop);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_BAKEDANIMATION_H_ */
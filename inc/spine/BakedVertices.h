@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#ifndef SPINE_BAKEDVERTICES_H_
+#define SPINE_BAKEDVERTICES_H_
+
+#include <spine/dll.h>
+#include <spine/Animation.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct spSkeleton;
+
+/* The final world vertices, UVs, colors, and draw order of an animation sampled at a fixed rate, in a flat format that
+ * can be written to a file and used in place, eg from a memory mapped file, without parsing. All fields are 32 bit or
+ * smaller in the byte order of the machine that baked them, and offsets are in bytes. */
+
+#define SP_BAKED_VERTICES_VERSION 1
+
+typedef struct spBakedVerticesHeader {
+	char magic[4]; /* "SPBV" */
+	int version;
+	int size; /* Total bytes, including the header. */
+	float fps;
+	float duration;
+	int framesCount;
+	int pagesCount;
+	int pagesOffset; /* From the header, pagesCount offsets from the header of the atlas page names. */
+	int framesOffset; /* From the header, framesCount offsets from the header of the spBakedVerticesFrame. */
+} spBakedVerticesHeader;
+
+typedef struct spBakedVerticesFrame {
+	int drawsCount;
+	int verticesCount;
+	int indicesCount;
+	int drawsOffset; /* From the frame, drawsCount spBakedVerticesDraw. */
+	int verticesOffset; /* From the frame, verticesCount spBakedVertex. */
+	int indicesOffset; /* From the frame, indicesCount unsigned short. */
+} spBakedVerticesFrame;
+
+/* Triangles of consecutive slots that share an atlas page and blend mode. Indices are relative to firstVertex. */
+typedef struct spBakedVerticesDraw {
+	int page;
+	int blendMode; /* spBlendMode */
+	int firstVertex;
+	int verticesCount;
+	int firstIndex;
+	int indicesCount;
+} spBakedVerticesDraw;
+
+typedef struct spBakedVertex {
+	float x, y;
+	float u, v;
+	unsigned int color; /* Skeleton, slot, and attachment color multiplied, RGBA8 with red in the lowest byte. */
+} spBakedVertex;
+
+/* Samples the animation from the setup pose at i / fps, and at the duration for the last frame, clipping as rendering
+ * would, and returns the baked data, which starts with its header, or 0 if fps is not > 0. The skeleton is left in the
+ * pose of the last frame. Dark colors are not baked. Region and mesh attachments
+ * must have spAtlasRegion renderer objects, as set by spAtlasAttachmentLoader. */
+SP_API spBakedVerticesHeader *spBakedVertices_bake(struct spSkeleton *skeleton, spAnimation *animation, float fps);
+
+/* Disposes data returned by spBakedVertices_bake. */
+SP_API void spBakedVertices_dispose(spBakedVerticesHeader *self);
+
+/* Returns the header of baked data in memory, eg read or mapped from a file, or 0 if the data is invalid or has another
+ * version. The memory must be 4 byte aligned and is used in place. */
+SP_API const spBakedVerticesHeader *spBakedVertices_open(const void *memory, int size);
+
+SP_API const char *spBakedVertices_getPageName(const spBakedVerticesHeader *self, int page);
+
+/* Returns the frame nearest the time. The last frame is at the duration, so a looping time nears it at the end of each
+ * loop. */
+SP_API const spBakedVerticesFrame *spBakedVertices_getFrame(const spBakedVerticesHeader *self, float time, int /*boolean*/ loop);
+
+SP_API const spBakedVerticesDraw *spBakedVerticesFrame_getDraws(const spBakedVerticesFrame *self);
+
+SP_API const spBakedVertex *spBakedVerticesFrame_getVertices(const spBakedVerticesFrame *self);
+
+SP_API const unsigned short *spBakedVerticesFrame_getIndices(const spBakedVerticesFrame *self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_BAKEDVERTICES_H_ */
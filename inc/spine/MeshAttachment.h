@@ -45,6 +45,8 @@ typedef struct spMeshAttachment spMeshAttachment;
 struct spMeshAttachment {
 	spVertexAttachment super;
 
+	/* With a sequence, the renderer object, region and UVs stay at the setup region and no longer follow the sequence
+	 * frame a slot shows. Renderers must use spMeshAttachment_getRendererObject and spMeshAttachment_getUVs instead. */
 	void *rendererObject;
 	spTextureRegion *region;
 	spSequence *sequence;
@@ -52,7 +54,7 @@ struct spMeshAttachment {
 	char *path;
 
 	float *regionUVs;
-	float *uvs;
+	float *uvs; /* See rendererObject. */
 
 	int trianglesCount;
 	unsigned short *triangles;
@@ -71,8 +73,19 @@ struct spMeshAttachment {
 
 SP_API spMeshAttachment *spMeshAttachment_create(const char *name);
 
+/* Computes the UVs. If the attachment has a sequence, they are computed for every region of the sequence and the
+ * attachment is set to the setup region. The loaders call this, so the tables exist before rendering. If the region is
+ * 0, the UVs are the region UVs. */
 SP_API void spMeshAttachment_updateRegion(spMeshAttachment *self);
 
+/* Returns the UVs for the region the slot currently shows. If the sequence's tables were not computed by
+ * spMeshAttachment_updateRegion, eg by a custom attachment loader, returns the attachment's own UVs. */
+SP_API float *spMeshAttachment_getUVs(spMeshAttachment *self, spSlot *slot);
+
+/* Returns the renderer object for the region the slot currently shows, or the attachment's own if the sequence's tables
+ * were not computed. */
+SP_API void *spMeshAttachment_getRendererObject(spMeshAttachment *self, spSlot *slot);
+
 SP_API void spMeshAttachment_setParentMesh(spMeshAttachment *self, spMeshAttachment *parentMesh);
 
 SP_API spMeshAttachment *spMeshAttachment_newLinkedMesh(spMeshAttachment *self);
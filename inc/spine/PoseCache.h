@@ -0,0 +1,82 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef SPINE_POSECACHE_H_
+#define SPINE_POSECACHE_H_
+
+#include <spine/dll.h>
+#include <spine/Animation.h>
+#include <spine/SkeletonData.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct spSkeleton;
+struct spSkin;
+
+/* Local poses of animations sampled once per time bucket and shared by all skeletons of the same skeleton data that play
+ * an animation at the same bucket. Each pose holds the values the animation's timelines key: bone transforms and inherit,
+ * slot colors, attachments, sequence indices and deform, constraint mixes, and draw order. Least recently used poses are
+ * discarded to stay within the memory limit. */
+typedef struct spPoseCache {
+	spSkeletonData *data;
+	float fps;
+	size_t maxBytes;
+
+	int hits, misses, evictions;
+	int entriesCount;
+	size_t bytes; /* Used by the cached poses and the layouts of the properties their animations key. */
+} spPoseCache;
+
+/* @param fps Time buckets per second, eg 30. If 0, poses are cached for each exact time.
+ * @param maxBytes The memory the cached poses may use, including the layout kept for each animation with cached poses. */
+SP_API spPoseCache *spPoseCache_create(spSkeletonData *data, float fps, size_t maxBytes);
+
+SP_API void spPoseCache_dispose(spPoseCache *self);
+
+/* Discards all cached poses. The hit, miss, and eviction counts are kept. */
+SP_API void spPoseCache_clear(spPoseCache *self);
+
+/* Sets the properties the animation keys to the pose it has at the start of the time's bucket, as spAnimation_apply
+ * would from the setup pose, mixed from the current values by alpha. Attachments, draw order, sequence indices, inherit,
+ * and IK bend direction, compress, and stretch are set regardless of alpha. Events and physics resets are not fired. The
+ * pose is sampled for the skeleton's skin on a miss.
+ * @param skeleton Created from the cache's skeleton data. */
+SP_API void
+spPoseCache_apply(spPoseCache *self, struct spSkeleton *skeleton, spAnimation *animation, float time, int /*boolean*/ loop,
+				  float alpha);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_POSECACHE_H_ */
@@ -46,6 +46,9 @@ typedef struct spRegionAttachment {
 	float x, y, scaleX, scaleY, rotation, width, height;
 	spColor color;
 
+	/* With a sequence, the renderer object, region, offset and UVs stay at the setup region and no longer follow the
+	 * sequence frame a slot shows. Renderers must use spRegionAttachment_getRendererObject and spRegionAttachment_getUVs
+	 * instead. */
 	void *rendererObject;
 	spTextureRegion *region;
 	spSequence *sequence;
@@ -56,8 +59,19 @@ typedef struct spRegionAttachment {
 
 SP_API spRegionAttachment *spRegionAttachment_create(const char *name);
 
+/* Computes the vertex offsets and UVs. If the attachment has a sequence, they are computed for every region of the
+ * sequence and the attachment is set to the setup region. The loaders call this, so the tables exist before rendering.
+ * If the region is 0, the UVs span the whole texture. */
 SP_API void spRegionAttachment_updateRegion(spRegionAttachment *self);
 
+/* Returns the UVs for the region the slot currently shows. If the sequence's tables were not computed by
+ * spRegionAttachment_updateRegion, eg by a custom attachment loader, returns the attachment's own UVs. */
+SP_API float *spRegionAttachment_getUVs(spRegionAttachment *self, spSlot *slot);
+
+/* Returns the renderer object for the region the slot currently shows, or the attachment's own if the sequence's tables
+ * were not computed. */
+SP_API void *spRegionAttachment_getRendererObject(spRegionAttachment *self, spSlot *slot);
+
 SP_API void spRegionAttachment_computeWorldVertices(spRegionAttachment *self, spSlot *slot, float *vertices, int offset,
 													int stride);
 
@@ -48,6 +48,15 @@ typedef struct spSequence {
 	int digits;
 	int setupIndex;
 	spTextureRegionArray *regions;
+
+	/* The UVs for each region, uvsCount per region, and for region attachments the 8 vertex offsets for each region.
+	 * Computed when the attachment is loaded or copied, by spRegionAttachment_updateRegion or
+	 * spMeshAttachment_updateRegion, which must be called again if the regions or the attachment's geometry change.
+	 * Rendering only reads them. If they are 0, the getters use the attachment's own UVs and offsets, and
+	 * spSequence_apply computes them. */
+	float *uvs;
+	float *offsets;
+	int uvsCount;
 } spSequence;
 
 SP_API spSequence *spSequence_create(int numRegions);
@@ -56,6 +65,12 @@ SP_API void spSequence_dispose(spSequence *self);
 
 SP_API spSequence *spSequence_copy(spSequence *self);
 
+/* Returns the index of the region the slot currently shows. */
+SP_API int spSequence_resolveIndex(spSequence *self, spSlot *slot);
+
+/* Sets the attachment's region, renderer object and UVs to the region the slot currently shows. This modifies the
+ * attachment, which may be shared by many skeletons. Renderers should instead use the slot based getters, eg
+ * spRegionAttachment_getUVs. */
 SP_API void spSequence_apply(spSequence *self, spSlot *slot, spAttachment *attachment);
 
 SP_API void spSequence_getPath(spSequence *self, const char *basePath, int index, char *path);
@@ -31,6 +31,7 @@
 #define SPINE_SKELETON_H_
 
 #include <spine/dll.h>
+#include <stddef.h>
 #include <spine/SkeletonData.h>
 #include <spine/Slot.h>
 #include <spine/Skin.h>
@@ -47,6 +48,7 @@ typedef struct spSkeleton {
 	spSkeletonData *data;
 
 	int bonesCount;
+	/* The bones are stored contiguously in bone index order, so bones[i] == bones[0] + i. */
 	spBone **bones;
 	spBone *root;
 
@@ -76,16 +78,44 @@ typedef struct spSkeleton {
 
 SP_API spSkeleton *spSkeleton_create(spSkeletonData *data);
 
+/* Returns the number of bytes spSkeleton_createInBlock needs for a skeleton of the data. */
+SP_API size_t spSkeleton_getBlockSize(const spSkeletonData *data);
+
+/* Creates a skeleton whose bones, slots, constraints, and arrays are laid out in one contiguous block.
+ * @param memory spSkeleton_getBlockSize bytes aligned as by malloc, which the caller frees after spSkeleton_dispose. May
+ * be 0 to have the skeleton allocate the block, then spSkeleton_dispose frees it. */
+SP_API spSkeleton *spSkeleton_createInBlock(spSkeletonData *data, void *memory);
+
+/* Creates a skeleton in one block with the same pose, attachments, draw order, and update cache as the source, without
+ * sorting or setting the setup pose again. Any skeleton can be the source, it does not need to have been created in a
+ * block. */
+SP_API spSkeleton *spSkeleton_clone(const spSkeleton *source);
+
+/* Like spSkeleton_clone, using memory as for spSkeleton_createInBlock.
+ * @param memory spSkeleton_getBlockSize bytes for the source's data, or 0. */
+SP_API spSkeleton *spSkeleton_cloneInBlock(const spSkeleton *source, void *memory);
+
 SP_API void spSkeleton_dispose(spSkeleton *self);
 
-/* Caches information about bones and constraints. Must be called if bones or constraints, or weighted path attachments
- * are added or removed. */
+/* Caches information about bones and constraints, and the attachments animations set for the skin. Must be called if
+ * bones or constraints, or weighted path attachments are added or removed, or attachments are added to or removed from
+ * the skin or the default skin. */
 SP_API void spSkeleton_updateCache(spSkeleton *self);
 
 SP_API void spSkeleton_updateWorldTransform(const spSkeleton *self, spPhysics physics);
 
+/* Like spSkeleton_updateWorldTransform, but bones whose local pose, inherit mode and parent did not change since the
+ * previous call keep their world transform. Bones affected by constraints are always computed. World transforms must
+ * not be changed by other means between calls. Returns the number of bones that were skipped. */
+SP_API int spSkeleton_updateWorldTransformIncremental(const spSkeleton *self, spPhysics physics);
+
 SP_API void spSkeleton_update(spSkeleton *self, float delta);
 
+/* Sets whether the y-axis points down for this skeleton. Until this is called, the skeleton uses spBone_isYDown. */
+SP_API void spSkeleton_setYDown(spSkeleton *self, int/*bool*/ yDown);
+
+SP_API int/*bool*/ spSkeleton_isYDown(const spSkeleton *self);
+
 /* Sets the bones, constraints, and slots to their setup pose values. */
 SP_API void spSkeleton_setToSetupPose(const spSkeleton *self);
 /* Sets the bones and constraints to their setup pose values. */
@@ -101,7 +131,8 @@ SP_API spSlot *spSkeleton_findSlot(const spSkeleton *self, const char *slotName)
 
 /* Sets the skin used to look up attachments before looking in the SkeletonData defaultSkin. Attachments from the new skin are
  * attached if the corresponding attachment from the old skin was attached. If there was no old skin, each slot's setup mode
- * attachment is attached from the new skin.
+ * attachment is attached from the new skin. Setting the same skin again only looks up the attachments again, which must be
+ * done after a skin's attachments are changed other than by spSkin functions, eg through spSkin_getAttachments.
  * @param skin May be 0.*/
 SP_API void spSkeleton_setSkin(spSkeleton *self, spSkin *skin);
 /* Returns 0 if the skin was not found. See spSkeleton_setSkin.
@@ -117,6 +148,10 @@ spSkeleton_getAttachmentForSlotIndex(const spSkeleton *self, int slotIndex, cons
 /* Returns 0 if the slot or attachment was not found.
  * @param attachmentName May be 0. */
 SP_API int spSkeleton_setAttachment(spSkeleton *self, const char *slotName, const char *attachmentName);
+/* Returns 0 if the slot or attachment was not found.
+ * @param slotIndex From spSkeletonData_findSlotIndex, may be -1.
+ * @param attachmentName May be 0. */
+SP_API int spSkeleton_setAttachmentForSlotIndex(spSkeleton *self, int slotIndex, const char *attachmentName);
 
 /* Returns 0 if the IK constraint was not found. */
 SP_API spIkConstraint *spSkeleton_findIkConstraint(const spSkeleton *self, const char *constraintName);
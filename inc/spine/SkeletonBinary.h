@@ -35,6 +35,7 @@
 #include <spine/AttachmentLoader.h>
 #include <spine/SkeletonData.h>
 #include <spine/Atlas.h>
+#include <spine/Animation.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -46,6 +47,11 @@ typedef struct spSkeletonBinary {
 	float scale;
 	spAttachmentLoader *attachmentLoader;
 	char *error;
+	/* 0 keeps curve timelines at full precision, 8 or 16 quantizes their bezier curves, and their frames to 16 bits, as
+	 * animations are read, see spAnimation_quantizeCurves. The report is reset by each read. */
+	int curveBits;
+	spCurveQuantizeReport curveReport;
+	spBezierEvaluation bezierEvaluation; /* Applied to animations as they are read, see spAnimation_setBezierEvaluation. */
 } spSkeletonBinary;
 
 SP_API spSkeletonBinary *spSkeletonBinary_createWithLoader(spAttachmentLoader *attachmentLoader);
@@ -90,10 +90,23 @@ SP_API spSkeletonData *spSkeletonData_create(void);
 
 SP_API void spSkeletonData_dispose(spSkeletonData *self);
 
+/* Builds the hashed name index used by the find functions. The loaders call this, it only needs to be called again after
+ * the bones, slots, skins, events, animations, or constraints are changed. Until then, the find functions search linearly
+ * any array whose size differs from when the index was built. Renaming or replacing an item without changing the size of
+ * its array leaves the index stale, so the item is not found by its new name. */
+SP_API void spSkeletonData_updateIndex(spSkeletonData *self);
+
 SP_API spBoneData *spSkeletonData_findBone(const spSkeletonData *self, const char *boneName);
 
+/* Returns the index of the bone, which can be kept to access spSkeleton bones without a lookup, or -1 if the bone was
+ * not found. */
+SP_API int spSkeletonData_findBoneIndex(const spSkeletonData *self, const char *boneName);
+
 SP_API spSlotData *spSkeletonData_findSlot(const spSkeletonData *self, const char *slotName);
 
+/* Returns the index of the slot or -1 if the slot was not found. */
+SP_API int spSkeletonData_findSlotIndex(const spSkeletonData *self, const char *slotName);
+
 SP_API spSkin *spSkeletonData_findSkin(const spSkeletonData *self, const char *skinName);
 
 SP_API spEventData *spSkeletonData_findEvent(const spSkeletonData *self, const char *eventName);
@@ -102,13 +115,25 @@ SP_API spAnimation *spSkeletonData_findAnimation(const spSkeletonData *self, con
 
 SP_API spIkConstraintData *spSkeletonData_findIkConstraint(const spSkeletonData *self, const char *constraintName);
 
+/* Returns the index of the constraint or -1 if the constraint was not found. */
+SP_API int spSkeletonData_findIkConstraintIndex(const spSkeletonData *self, const char *constraintName);
+
 SP_API spTransformConstraintData *
 spSkeletonData_findTransformConstraint(const spSkeletonData *self, const char *constraintName);
 
+/* Returns the index of the constraint or -1 if the constraint was not found. */
+SP_API int spSkeletonData_findTransformConstraintIndex(const spSkeletonData *self, const char *constraintName);
+
 SP_API spPathConstraintData *spSkeletonData_findPathConstraint(const spSkeletonData *self, const char *constraintName);
 
+/* Returns the index of the constraint or -1 if the constraint was not found. */
+SP_API int spSkeletonData_findPathConstraintIndex(const spSkeletonData *self, const char *constraintName);
+
 SP_API spPhysicsConstraintData *spSkeletonData_findPhysicsConstraint(const spSkeletonData *self, const char *constraintName);
 
+/* Returns the index of the constraint or -1 if the constraint was not found. */
+SP_API int spSkeletonData_findPhysicsConstraintIndex(const spSkeletonData *self, const char *constraintName);
+
 #ifdef __cplusplus
 }
 #endif
@@ -47,6 +47,11 @@ typedef struct spSkeletonJson {
 	float scale;
 	spAttachmentLoader *attachmentLoader;
 	char *error;
+	/* 0 keeps curve timelines at full precision, 8 or 16 quantizes their bezier curves, and their frames to 16 bits, as
+	 * animations are read, see spAnimation_quantizeCurves. The report is reset by each read. */
+	int curveBits;
+	spCurveQuantizeReport curveReport;
+	spBezierEvaluation bezierEvaluation; /* Applied to animations as they are read, see spAnimation_setBezierEvaluation. */
 } spSkeletonJson;
 
 SP_API spSkeletonJson *spSkeletonJson_createWithLoader(spAttachmentLoader *attachmentLoader);
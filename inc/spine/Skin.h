@@ -88,13 +88,14 @@ typedef struct {
 	spSkin super;
 	_Entry *entries; /* entries list stored for getting attachment name by attachment index */
 	_SkinHashTableEntry *entriesHashTable[SKIN_ENTRIES_HASH_TABLE_SIZE]; /* hashtable for fast attachment lookup */
+	int modifications; /* Incremented when the attachments change, so skeletons using the skin look them up again. */
 } _spSkin;
 
 SP_API spSkin *spSkin_create(const char *name);
 
 SP_API void spSkin_dispose(spSkin *self);
 
-/* The Skin owns the attachment. */
+/* The Skin owns the attachment. Skeletons using the skin look up their attachments again. */
 SP_API void spSkin_setAttachment(spSkin *self, int slotIndex, const char *name, spAttachment *attachment);
 /* Returns 0 if the attachment was not found. */
 SP_API spAttachment *spSkin_getAttachment(const spSkin *self, int slotIndex, const char *name);
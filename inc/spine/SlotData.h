@@ -51,6 +51,7 @@ typedef struct spSlotData {
 	spColor *darkColor;
 	spBlendMode blendMode;
     int/*bool*/  visible;
+	int deformCapacity; /* The most deform vertices the animations key for the slot, set by the loaders. */
 } spSlotData;
 
 SP_API spSlotData *spSlotData_create(const int index, const char *name, spBoneData *boneData);
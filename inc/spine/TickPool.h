@@ -0,0 +1,69 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef SPINE_TICKPOOL_H_
+#define SPINE_TICKPOOL_H_
+
+#include <spine/dll.h>
+#include <spine/AnimationState.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Worker threads that tick skeleton instances with spAnimationState_tickInstances. The instances are split into chunks
+ * of chunkSize, and each thread is given an equal share of the chunks. A thread that finishes its share steals chunks
+ * from the shares of the others. The calling thread works too. Listeners are notified on the calling thread after all
+ * instances are ticked, so their order does not depend on the number of threads.
+ *
+ * The worker threads use pthreads, or the Windows API on Windows. When SPINE_NO_THREADS is defined, the pool has no
+ * worker threads and ticks on the calling thread. */
+typedef struct spTickPool {
+	int threadsCount; /* Including the calling thread. */
+	int chunkSize; /* Instances claimed at a time, 16 by default. */
+} spTickPool;
+
+/* @param threadsCount The threads to tick with, including the calling thread. If <= 0, one per processor. If worker
+ * threads cannot be started, threadsCount is the number that were, plus one. */
+SP_API spTickPool *spTickPool_create(int threadsCount);
+
+SP_API void spTickPool_dispose(spTickPool *self);
+
+/* Ticks each instance as spAnimationState_tickInstances does, then notifies the listeners as
+ * spAnimationState_deliverTickEvents does, and returns. No skeleton or animation state may appear more than once. Must
+ * not be called by more than one thread at a time. */
+SP_API void
+spTickPool_tick(spTickPool *self, spTickInstance *instances, int count, float delta, spPhysics physics);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SPINE_TICKPOOL_H_ */
@@ -178,6 +178,7 @@ void _spFree(void *ptr);
 
 float _spRandom(void);
 
+/* The allocator and random functions are shared by all threads and should be set before any other call. */
 SP_API void _spSetMalloc(void *(*_malloc)(size_t size));
 
 SP_API void _spSetDebugMalloc(void *(*_malloc)(size_t size, const char *file, int line));
@@ -190,6 +191,15 @@ SP_API void _spSetRandom(float (*_random)(void));
 
 char *_spReadFile(const char *path, int *length);
 
+/* Returns the counter's value and increments it, atomically where the compiler supports it. */
+int _spNextId(volatile long *counter);
+
+/* Sets target to value if it is expected, atomically where the compiler supports it. Returns true if it was set. */
+int /*boolean*/ _spCompareAndSwap(void *volatile *target, void *expected, void *value);
+
+/* Sets the counter to value if it is expected, atomically where the compiler supports it. Returns true if it was set. */
+int /*boolean*/ _spCompareAndSwapCount(volatile long *counter, long expected, long value);
+
 
 /*
  * Math utilities
@@ -216,6 +226,47 @@ typedef union _spEventQueueItem {
 
 typedef struct _spAnimationState _spAnimationState;
 
+#define SP_HOLD_KEY_TRACK 1          /* The first entry of a track, the one mixed from the longest. */
+#define SP_HOLD_KEY_COMPUTED 2       /* The entry's timeline modes are computed, it is not added to another entry. */
+#define SP_HOLD_KEY_HOLD_PREVIOUS 4
+#define SP_HOLD_KEY_MIXING 8         /* The entry's mix duration is > 0. */
+
+/* A track entry of an animation state, in the order the timeline modes are computed. */
+typedef struct _spHoldKey {
+	spAnimation *animation;
+	int flags;
+	int timelinesCount; /* The animation's timelines, which spAnimation_optimize may change after modes are computed. */
+} _spHoldKey;
+
+/* The timeline modes computed for a layout of track entries. */
+typedef struct _spHoldLayout {
+	struct _spHoldLayout *next;
+	unsigned int hash;
+	int keysCount;
+	_spHoldKey *keys;
+	/* The timeline modes of each computed entry in turn. For HOLD_MIX, the bits above the mode are how many times
+	 * mixingTo is followed from the entry to reach its hold mix entry. */
+	int *modes;
+} _spHoldLayout;
+
+_spHoldLayout *_spHoldLayout_create(const _spHoldKey *keys, int keysCount, unsigned int hash, int modesCount);
+
+const _spHoldLayout *
+_spAnimationStateData_findHoldLayout(spAnimationStateData *self, const _spHoldKey *keys, int keysCount, unsigned int hash);
+
+/* Returns true if the cache is disabled or full, so a new layout would not be kept. */
+int /*boolean*/ _spAnimationStateData_isHoldCacheFull(spAnimationStateData *self);
+
+/* Shares the layout with the animation states using this data, or disposes it if the cache is disabled or full. Safe to
+ * call from threads ticking different animation states. */
+void _spAnimationStateData_addHoldLayout(spAnimationStateData *self, _spHoldLayout *layout);
+
+typedef struct _spTrackEntry {
+	spTrackEntry super;
+	int timelinesRotationCapacity;
+	int timelineCursorsCapacity;
+} _spTrackEntry;
+
 typedef struct _spEventQueue {
 	_spAnimationState *state;
 	_spEventQueueItem *objects;
@@ -229,16 +280,135 @@ struct _spAnimationState {
 
 	int eventsCount;
 	spEvent **events;
+	int eventsCapacity;
 
 	_spEventQueue *queue;
 
+	spAnimationStateEvent *stream; /* Filled until the next drain, which hands it out and fills drainedStream. */
+	int streamCount;
+	int streamCapacity;
+	spAnimationStateEvent *drainedStream;
+	int drainedStreamCapacity;
+	spTrackEntry **disposedEntries; /* The first drainedEntriesCount were in the last batch drained. */
+	int disposedEntriesCount;
+	int disposedEntriesCapacity;
+	int drainedEntriesCount;
+
+	spTrackEntry *trackEntryPool; /* Disposed entries to reuse, linked through next. */
+	int trackEntryPoolCount;
+	int trackEntriesCreated;
+	int trackEntriesReused;
+
 	spPropertyId *propertyIDs;
 	int propertyIDsCount;
 	int propertyIDsCapacity;
+	int *propertyIDsSet; /* Index + 1 into propertyIDs, or 0 for an empty bucket. */
+	int propertyIDsSetMask;
+
+	_spHoldKey *holdKeys; /* The layout of the track entries when the timeline modes were last computed. */
+	spTrackEntry **holdEntries;
+	int holdKeysCapacity;
 
 	int /*boolean*/ animationsChanged;
 };
 
+/**/
+
+typedef enum {
+	SP_UPDATE_BONE,
+	SP_UPDATE_IK_CONSTRAINT,
+	SP_UPDATE_PATH_CONSTRAINT,
+	SP_UPDATE_TRANSFORM_CONSTRAINT,
+	SP_UPDATE_PHYSICS_CONSTRAINT
+} _spUpdateType;
+
+typedef struct {
+	_spUpdateType type;
+	void *object;
+	/* For SP_UPDATE_BONE, the number of updates starting with this one that are for bones at the same hierarchy
+	 * depth and can be computed together, else 1. */
+	int count;
+} _spUpdate;
+
+/* A bone's local pose as of the last incremental world transform update. */
+typedef struct {
+	float x, y, rotation, scaleX, scaleY, shearX, shearY;
+	spInherit inherit;
+	int /*boolean*/ constrained; /* Modified by a constraint, directly or through a parent. */
+	int /*boolean*/ dirty;
+} _spBonePose;
+
+typedef struct _spSkeleton {
+	spSkeleton super;
+
+	int updateCacheCount;
+	int updateCacheCapacity;
+	_spUpdate *updateCache;
+
+	/* The bones, contiguous in bone index order, and the children arrays of all bones. */
+	spBone *bonesBlock;
+	spBone **childrenBlock;
+
+	/* State for spSkeleton_updateWorldTransformIncremental, valid only if lastPosesValid. */
+	_spBonePose *lastPoses;
+	int /*boolean*/ lastPosesValid;
+	float lastX, lastY, lastScaleX, lastScaleY;
+	int /*boolean*/ lastYDown;
+
+	int /*boolean*/ hasYDown, yDown;
+
+	/* Frame cursor for the timeline spAnimationState is applying, or 0. */
+	int *timelineCursor;
+
+	/* The attachment for each of the skeleton data's attachment keys, resolved for the skin by spSkeleton_updateCache.
+	 * Resolved again when the skin or default skin, or their modifications, differ from the ones resolved. */
+	int attachmentsCount;
+	spAttachment **attachments;
+	spSkin *resolvedSkin, *resolvedDefaultSkin;
+	int resolvedSkinModifications, resolvedDefaultSkinModifications;
+
+	/* The memory holding the skeleton and the objects it owns if created by spSkeleton_createInBlock, else 0. */
+	void *block;
+	int /*boolean*/ ownsBlock;
+} _spSkeleton;
+
+/* Open addressing hash table from names to indices in one of the spSkeletonData arrays. */
+typedef struct {
+	int count; /* Size of the array when the index was built. */
+	int mask; /* Bucket count - 1, the bucket count is a power of two. */
+	int *buckets; /* Index + 1, or 0 for an empty bucket. */
+	const char **names; /* Names by index, owned by the items. */
+} _spNameIndex;
+
+typedef struct _spSkeletonData {
+	spSkeletonData super;
+
+	_spNameIndex bones, slots, skins, events, animations;
+	_spNameIndex ikConstraints, transformConstraints, pathConstraints, physicsConstraints;
+
+	/* Each distinct slot and attachment name used by a slot's setup pose or an attachment timeline. */
+	int attachmentKeysCount;
+	int *attachmentKeySlots;
+	const char **attachmentKeyNames; /* Owned by the slot data or timeline. */
+	int *setupAttachmentKeys; /* For each slot, or -1 if it has no setup attachment. */
+} _spSkeletonData;
+
+/* Assigns a key to each slot and attachment name the setup pose and attachment timelines use, so skeletons can resolve
+ * them once for their skin instead of looking them up each time they are applied. Called by the loaders. */
+void _spSkeletonData_updateAttachmentKeys(spSkeletonData *self);
+
+/* Sets each slot's deformCapacity to the most vertices its deform timelines key. Slots are given deform buffers this size
+ * when a skeleton is created, so applying deform timelines never allocates. Called by the loaders. */
+void _spSkeletonData_updateDeformCapacities(spSkeletonData *self);
+
+/* Returns the attachment resolved by spSkeleton_updateCache for the key, or looks the name up if the key is -1 or not yet
+ * resolved. Resolves the keys again first if the skin or default skin changed. Returns 0 if the name is 0. */
+spAttachment *
+_spSkeleton_getAttachmentForKey(const spSkeleton *self, int slotIndex, int key, const char *attachmentName);
+
+/* Returns the slot's setup pose attachment for the skeleton's skin. */
+spAttachment *_spSkeleton_getSetupAttachment(const spSkeleton *self, const spSlotData *slotData);
+
 
 /**/
 
@@ -270,6 +440,54 @@ void _spVertexAttachment_init(spVertexAttachment *self);
 
 void _spVertexAttachment_deinit(spVertexAttachment *self);
 
+/**/
+
+/* Initializes a bone in memory owned by the caller, which must be zeroed. */
+void _spBone_init(spBone *self, spBoneData *data, struct spSkeleton *skeleton, spBone *parent);
+
+/* Initializes a slot in memory owned by the caller, which must be zeroed. darkColor is used if the data has a dark color. */
+void _spSlot_init(spSlot *self, spSlotData *data, spBone *bone, spColor *darkColor);
+
+/* Initialize constraints in memory owned by the caller, which must be zeroed. bones must have room for the data's bones. */
+void _spIkConstraint_init(spIkConstraint *self, spIkConstraintData *data, const struct spSkeleton *skeleton, spBone **bones);
+
+void _spTransformConstraint_init(spTransformConstraint *self, spTransformConstraintData *data,
+								 const struct spSkeleton *skeleton, spBone **bones);
+
+void _spPathConstraint_init(spPathConstraint *self, spPathConstraintData *data, const struct spSkeleton *skeleton,
+							spBone **bones);
+
+void _spPathConstraint_disposeBuffers(spPathConstraint *self);
+
+void _spPhysicsConstraint_init(spPhysicsConstraint *self, spPhysicsConstraintData *data, struct spSkeleton *skeleton);
+
+/**/
+
+/* For frames baked at i / fps, except the last, which is baked at the duration, returns the last frame at or before the
+ * time and sets alpha to how far the time is from that frame to the next. */
+int _spBakedAnimation_findFrame(float time, float fps, float duration, int framesCount, float *alpha);
+
+/**/
+
+/* Returns the index into frames of the last frame whose time is <= time, or 0 if time is before the first frame. Each
+ * frame is step floats, starting with its time. cursor may be 0, else it is the frame number found by the previous
+ * search of the same frames and is checked first, then updated. */
+int _spTimeline_search(const float *frames, int framesSize, float time, int step, int *cursor);
+
+float _spCurveTimeline1_getCurveValue(spCurveTimeline1 *self, float time, int *cursor);
+
+/* The time of the first frame, for timelines whose frames may be quantized by spAnimation_quantizeCurves. */
+float _spCurveTimeline_getStart(const spCurveTimeline *self);
+
+/* Hashes a property ID for the open addressing sets of spAnimation and the animation state. */
+unsigned int _spPropertyId_hash(spPropertyId id);
+
+/* Applies timelines that all have the same type, calling the type's apply function directly. cursors may be 0, else it
+ * has a frame cursor for each timeline, which is set on the skeleton while the timeline is applied. */
+void _spTimeline_applyBatch(spTimeline **timelines, int *cursors, int count, struct spSkeleton *skeleton, float lastTime,
+							float time, spEvent **firedEvents, int *eventsCount, float alpha, spMixBlend blend,
+							spMixDirection direction);
+
 #ifdef __cplusplus
 }
 #endif
@@ -39,6 +39,8 @@
 #include <spine/AtlasAttachmentLoader.h>
 #include <spine/Attachment.h>
 #include <spine/AttachmentLoader.h>
+#include <spine/BakedAnimation.h>
+#include <spine/BakedVertices.h>
 #include <spine/Bone.h>
 #include <spine/BoneData.h>
 #include <spine/RegionAttachment.h>
@@ -48,6 +50,7 @@
 #include <spine/ClippingAttachment.h>
 #include <spine/Physics.h>
 #include <spine/PointAttachment.h>
+#include <spine/PoseCache.h>
 #include <spine/Skeleton.h>
 #include <spine/SkeletonBounds.h>
 #include <spine/SkeletonData.h>
@@ -57,6 +60,7 @@
 #include <spine/Slot.h>
 #include <spine/SlotData.h>
 #include <spine/SkeletonClipping.h>
+#include <spine/TickPool.h>
 #include <spine/Event.h>
 #include <spine/EventData.h>
 
@@ -27,15 +27,49 @@
  * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  *****************************************************************************/
 
+#include <float.h>
 #include <limits.h>
 #include <spine/Animation.h>
 #include <spine/IkConstraint.h>
 #include <spine/extension.h>
 
+/* Deform blending and analytic beziers use SSE when available. Define SPINE_NO_SIMD to always use the scalar loops. */
+#if !defined(SPINE_NO_SIMD) && (defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1))
+#include <xmmintrin.h>
+#define ANIMATION_SSE
+#endif
+
 _SP_ARRAY_IMPLEMENT_TYPE(spPropertyIdArray, spPropertyId)
 
 _SP_ARRAY_IMPLEMENT_TYPE(spTimelineArray, spTimeline *)
 
+unsigned int _spPropertyId_hash(spPropertyId id) {
+	return ((unsigned int) (id >> 32) * 0x9e3779b1u) ^ ((unsigned int) id * 0x85ebca77u);
+}
+
+static void _spAnimation_updateTimelineIds(spAnimation *self) {
+	spTimelineArray *timelines = self->timelines;
+	int i, ii, size = 4;
+
+	self->timelineIds->size = 0;
+	for (i = 0; i < timelines->size; i++) {
+		spPropertyIdArray_addAllValues(self->timelineIds, timelines->items[i]->propertyIds, 0,
+									   timelines->items[i]->propertyIdsCount);
+	}
+
+	while (size < self->timelineIds->size << 1) size <<= 1;
+	FREE(self->timelineIdSet);
+	self->timelineIdSet = CALLOC(spPropertyId, size);
+	self->timelineIdSetMask = size - 1;
+	for (i = 0; i < self->timelineIds->size; i++) {
+		spPropertyId id = self->timelineIds->items[i];
+		for (ii = _spPropertyId_hash(id) & self->timelineIdSetMask; self->timelineIdSet[ii];
+			 ii = (ii + 1) & self->timelineIdSetMask)
+			if (self->timelineIdSet[ii] == id) break;
+		self->timelineIdSet[ii] = id;
+	}
+}
+
 spAnimation *spAnimation_create(const char *name, spTimelineArray *timelines, float duration) {
 	int i, n, totalCount = 0;
 	spAnimation *self = NEW(spAnimation);
@@ -43,14 +77,20 @@ spAnimation *spAnimation_create(const char *name, spTimelineArray *timelines, fl
 	self->timelines = timelines != NULL ? timelines : spTimelineArray_create(1);
 	timelines = self->timelines;
 
+	/* Group the timelines by type so they are applied in batches. The sort is stable and the types are ordered so
+	 * attachment timelines still come before the deform and sequence timelines that depend on them. */
+	for (i = 1, n = timelines->size; i < n; i++) {
+		spTimeline *timeline = timelines->items[i];
+		int ii = i;
+		for (; ii > 0 && timelines->items[ii - 1]->type > timeline->type; ii--)
+			timelines->items[ii] = timelines->items[ii - 1];
+		timelines->items[ii] = timeline;
+	}
+
 	for (i = 0, n = timelines->size; i < n; i++)
 		totalCount += timelines->items[i]->propertyIdsCount;
 	self->timelineIds = spPropertyIdArray_create(totalCount);
-
-	for (i = 0, n = timelines->size; i < n; i++) {
-		spPropertyIdArray_addAllValues(self->timelineIds, timelines->items[i]->propertyIds, 0,
-									   timelines->items[i]->propertyIdsCount);
-	}
+	_spAnimation_updateTimelineIds(self);
 	self->duration = duration;
 	return self;
 }
@@ -61,63 +101,78 @@ void spAnimation_dispose(spAnimation *self) {
 		spTimeline_dispose(self->timelines->items[i]);
 	spTimelineArray_dispose(self->timelines);
 	spPropertyIdArray_dispose(self->timelineIds);
+	FREE(self->timelineIdSet);
 	FREE(self->name);
 	FREE(self);
 }
 
 int /*bool*/ spAnimation_hasTimeline(spAnimation *self, spPropertyId *ids, int idsCount) {
-	int i, n, ii;
-	for (i = 0, n = self->timelineIds->size; i < n; i++) {
-		for (ii = 0; ii < idsCount; ii++) {
-			if (self->timelineIds->items[i] == ids[ii]) return 1;
-		}
+	int i, ii;
+	for (i = 0; i < idsCount; i++) {
+		for (ii = _spPropertyId_hash(ids[i]) & self->timelineIdSetMask; self->timelineIdSet[ii];
+			 ii = (ii + 1) & self->timelineIdSetMask)
+			if (self->timelineIdSet[ii] == ids[i]) return 1;
 	}
 	return 0;
 }
 
 void spAnimation_apply(const spAnimation *self, spSkeleton *skeleton, float lastTime, float time, int loop, spEvent **events,
 					   int *eventsCount, float alpha, spMixBlend blend, spMixDirection direction) {
-	int i, n = self->timelines->size;
+	int i, count, n = self->timelines->size;
+	spTimeline **timelines = self->timelines->items;
 
 	if (loop && self->duration) {
 		time = FMOD(time, self->duration);
 		if (lastTime > 0) lastTime = FMOD(lastTime, self->duration);
 	}
 
-	for (i = 0; i < n; ++i)
-		spTimeline_apply(self->timelines->items[i], skeleton, lastTime, time, events, eventsCount, alpha, blend,
-						 direction);
-}
-
-static int search(spFloatArray
-						  *values,
-				  float time) {
-	int i, n;
-	float *items = values->items;
-	for (
-			i = 1, n = values->size;
-			i < n;
-			i++)
-		if (items[i] > time) return i - 1;
-	return values->size - 1;
-}
-
-static int search2(spFloatArray
-						   *values,
-				   float time,
-				   int step) {
-	int i, n;
-	float *items = values->items;
-	for (
-			i = step, n = values->size;
-			i < n;
-			i += step)
-		if (items[i] > time) return i -
-									step;
-	return values->size -
-		   step;
+	for (i = 0; i < n; i += count) {
+		count = 1;
+		while (i + count < n && timelines[i + count]->type == timelines[i]->type) count++;
+		_spTimeline_applyBatch(timelines + i, 0, count, skeleton, lastTime, time, events, eventsCount, alpha, blend,
+							   direction);
+	}
+}
+
+int _spTimeline_search(const float *frames, int framesSize, float time, int step, int *cursor) {
+	int low = 0, high = framesSize / step - 1, middle;
+	if (cursor) {
+		/* Time usually moves forward by less than a frame, so try the cached frame and the one after it. Seeks, loops
+		 * and reverse playback fall through to the full search. */
+		low = *cursor;
+		if (low <= high && frames[low * step] <= time) {
+			if (low == high || frames[(low + 1) * step] > time) return low * step;
+			if (low + 1 == high || frames[(low + 2) * step] > time) {
+				*cursor = low + 1;
+				return *cursor * step;
+			}
+		}
+		low = 0;
+	}
+	/* Binary search for the last frame with a time <= the given time. Frame 0 is returned if the time is before the
+	 * first frame. */
+	while (low < high) {
+		middle = (low + high + 1) >> 1;
+		if (frames[middle * step] > time)
+			high = middle - 1;
+		else
+			low = middle;
+	}
+	if (cursor) *cursor = low;
+	return low * step;
+}
+
+static int search(spFloatArray *values, float time, int *cursor) {
+	return _spTimeline_search(values->items, values->size, time, 1, cursor);
+}
+
+static int search2(spFloatArray *values, float time, int step, int *cursor) {
+	return _spTimeline_search(values->items, values->size, time, step, cursor);
 }
 
+/* The frame cursor spAnimationState set for the timeline being applied, or 0. */
+#define CURSOR(SKELETON) (SUB_CAST(_spSkeleton, SKELETON)->timelineCursor)
+
 /**/
 
 void _spTimeline_init(spTimeline *self,
@@ -167,7 +222,13 @@ void spTimeline_setBezier(spTimeline *self, int bezier, int frame, float value,
 		self->vtable.setBezier(self, bezier, frame, value, time1, value1, cx1, cy1, cx2, cy2, time2, value2);
 }
 
+/* Multiplying first keeps the min and max codes exact, so the -1 or 1 bend direction and 0 or 1 flags decode exactly. */
+#define QUANTIZED_FRAME(self, k, column) \
+	((self)->quantizedFrameMin[column] + (float) (self)->quantizedFrames[k] * (self)->quantizedFrameRange[column] / 65535.0f)
+
 float spTimeline_getDuration(const spTimeline *self) {
+	if (!self->frames->items) /* Quantized by spAnimation_quantizeCurves. */
+		return QUANTIZED_FRAME(SUB_CAST(spCurveTimeline, self), (self->frameCount - 1) * self->frameEntries, 0);
 	return self->frames->items[self->frames->size - self->frameEntries];
 }
 
@@ -201,6 +262,55 @@ void _spCurveTimeline_init(spCurveTimeline *self,
 
 void _spCurveTimeline_dispose(spTimeline *self) {
 	spFloatArray_dispose(SUB_CAST(spCurveTimeline, self)->curves);
+	FREE(SUB_CAST(spCurveTimeline, self)->quantizedCurves);
+	FREE(SUB_CAST(spCurveTimeline, self)->quantizedFrames);
+	FREE(SUB_CAST(spCurveTimeline, self)->quantizedFrameMin);
+	FREE(SUB_CAST(spCurveTimeline, self)->quantizedFrameRange);
+}
+
+/* Enough for the entries of two frames of the timeline with the most, spRGBA2Timeline. */
+#define FRAME_WINDOW 16
+
+float _spCurveTimeline_getStart(const spCurveTimeline *self) {
+	return self->quantizedFrames ? self->quantizedFrameMin[0] : self->super.frames->items[0];
+}
+
+/* Returns the entries of the frame at index i followed by those of the next frame, if there is one. Quantized frames are
+ * decoded into the window, which holds FRAME_WINDOW floats. */
+static const float *_spCurveTimeline_getFrames(const spCurveTimeline *self, int i, float *window) {
+	int entries = self->super.frameEntries, n, ii;
+	if (!self->quantizedFrames) return self->super.frames->items + i;
+	n = MIN(entries << 1, self->super.frameCount * entries - i);
+	for (ii = 0; ii < n; ii++)
+		window[ii] = QUANTIZED_FRAME(self, i + ii, ii < entries ? ii : ii - entries);
+	return window;
+}
+
+/* Same as _spTimeline_search, decoding the times of quantized frames. */
+static int _spCurveTimeline_search(const spCurveTimeline *self, float time, int step, int *cursor) {
+	const unsigned short *frames = self->quantizedFrames;
+	int low = 0, high = self->super.frameCount * self->super.frameEntries / step - 1, middle;
+	if (!frames) return _spTimeline_search(self->super.frames->items, self->super.frames->size, time, step, cursor);
+	if (cursor) {
+		low = *cursor;
+		if (low <= high && QUANTIZED_FRAME(self, low * step, 0) <= time) {
+			if (low == high || QUANTIZED_FRAME(self, (low + 1) * step, 0) > time) return low * step;
+			if (low + 1 == high || QUANTIZED_FRAME(self, (low + 2) * step, 0) > time) {
+				*cursor = low + 1;
+				return *cursor * step;
+			}
+		}
+		low = 0;
+	}
+	while (low < high) {
+		middle = (low + high + 1) >> 1;
+		if (QUANTIZED_FRAME(self, middle * step, 0) > time)
+			high = middle - 1;
+		else
+			low = middle;
+	}
+	if (cursor) *cursor = low;
+	return low * step;
 }
 
 void _spCurveTimeline_setBezier(spTimeline *timeline, int bezier, int frame, float value, float time1, float value1,
@@ -231,14 +341,181 @@ void _spCurveTimeline_setBezier(spTimeline *timeline, int bezier, int frame, flo
 	}
 }
 
-float _spCurveTimeline_getBezierValue(spCurveTimeline *self, float time, int frameIndex, int valueOffset, int i) {
+#define QUANTIZED_SAMPLE(self, k) ((self)->quantizedBits == 8 ? ((unsigned char *) (self)->quantizedCurves)[k] / 255.0f \
+													   : ((unsigned short *) (self)->quantizedCurves)[k] / 65535.0f)
+#define QUANTIZED_TIME(self, k, time1, duration) \
+	((time1) + ((self)->quantizedTimeMin + QUANTIZED_SAMPLE(self, k) * (self)->quantizedTimeRange) * (duration))
+#define QUANTIZED_VALUE(self, k, value1, change) \
+	((value1) + ((self)->quantizedValueMin + QUANTIZED_SAMPLE(self, k) * (self)->quantizedValueRange) * (change))
+
+static float _spCurveTimeline_getQuantizedValue(spCurveTimeline *self, float time, float time1, float value1, float time2,
+												float value2, int i) {
+	float duration = time2 - time1, change = value2 - value1;
+	float x, y, px = time1, py = value1;
+	int n;
+	i -= self->super.frameCount;
+	for (n = i + BEZIER_SIZE; i < n; i += 2) {
+		x = QUANTIZED_TIME(self, i, time1, duration);
+		y = QUANTIZED_VALUE(self, i + 1, value1, change);
+		if (x >= time) return x > px ? py + (time - px) / (x - px) * (y - py) : y;
+		px = x;
+		py = y;
+	}
+	return py + (time - px) / (time2 - px) * (value2 - py);
+}
+
+#define BEZIER_UNIFORM_STEPS (BEZIER_SIZE + 1)
+
+/* An analytic bezier stores cx1, cy1, cx2, cy2, then the curve parameter at the BEZIER_GUESS_STEPS - 1 inner even steps of
+ * time, which Newton's method starts from, then BEZIER_ANALYTIC. A uniform bezier whose table would be too coarse, eg at
+ * a vertical tangent, is stored the same way. */
+#define BEZIER_GUESS_STEPS (BEZIER_SIZE - 4)
+#define BEZIER_ANALYTIC FLT_MAX
+
+/* The largest error of a uniform table, as a fraction of the bezier's value range, before it is stored analytic. */
+#define BEZIER_UNIFORM_TOLERANCE 0.005f
+
+static float _spBezier_getPoint(float p0, float p1, float p2, float p3, float t) {
+	float u = 1 - t;
+	return u * u * u * p0 + 3 * u * t * (u * p1 + t * p2) + t * t * t * p3;
+}
+
+/* Returns the curve parameter where the x of the bezier is the specified x, with the x values relative to the first
+ * point. Newton's method starts from the parameter t. A step that leaves the bracket around the solution bisects it
+ * instead, for flat spots. */
+static float _spBezier_solve(float x1, float x2, float x3, float x, float t) {
+	float low = 0, high = 1, next, error, slope, u, epsilon = ABS(x3) * 0.00001f;
+	int i;
+	for (i = 0; i < 32; i++) {
+		error = _spBezier_getPoint(0, x1, x2, x3, t) - x;
+		if (ABS(error) <= epsilon) break;
+		if (error < 0)
+			low = t;
+		else
+			high = t;
+		u = 1 - t;
+		slope = 3 * (u * u * x1 + 2 * u * t * (x2 - x1) + t * t * (x3 - x2));
+		next = slope != 0 ? t - error / slope : low;
+		t = next > low && next < high ? next : (low + high) * 0.5f;
+	}
+	return t;
+}
+
+/* Returns the curve parameter stored for the percent of time by _spCurveTimeline_setAnalytic. */
+static float _spBezier_guess(const float *guesses, float percent) {
+	float step = percent * BEZIER_GUESS_STEPS, before, after;
+	int index = (int) step;
+	if (index < 0) index = 0;
+	else if (index > BEZIER_GUESS_STEPS - 1) index = BEZIER_GUESS_STEPS - 1;
+	before = index == 0 ? 0 : guesses[index - 1];
+	after = index == BEZIER_GUESS_STEPS - 1 ? 1 : guesses[index];
+	return before + (step - index) * (after - before);
+}
+
+static float _spBezier_evaluate(const float *curve, float time, float time1, float value1, float time2, float value2) {
+	float duration = time2 - time1, x = time - time1;
+	float t = _spBezier_solve(curve[0] - time1, curve[2] - time1, duration, x, _spBezier_guess(curve + 4, x / duration));
+	return _spBezier_getPoint(value1, curve[1], curve[3], value2, t);
+}
+
+/* Returns the value for the percent of time from a uniform bezier's table of BEZIER_SIZE values. */
+static float _spBezier_interpolate(const float *table, float percent, float value1, float value2) {
+	float before, after;
+	int step;
+	percent *= BEZIER_UNIFORM_STEPS;
+	step = (int) percent;
+	if (step < 0) step = 0;
+	else if (step > BEZIER_SIZE) step = BEZIER_SIZE;
+	before = step == 0 ? value1 : table[step - 1];
+	after = step == BEZIER_SIZE ? value2 : table[step];
+	return before + (percent - step) * (after - before);
+}
+
+/* Evaluates a bezier stored by spAnimation_setBezierEvaluation. */
+static float _spCurveTimeline_evaluateBezier(spCurveTimeline *self, float time, float time1, float value1, float time2,
+											 float value2, int i) {
+	float *curves = self->curves->items;
+	if (self->bezierEvaluation == SP_BEZIER_UNIFORM && curves[i + BEZIER_SIZE - 1] != BEZIER_ANALYTIC)
+		return _spBezier_interpolate(curves + i, (time - time1) / (time2 - time1), value1, value2);
+	return _spBezier_evaluate(curves + i, time, time1, value1, time2, value2);
+}
+
+#ifdef ANIMATION_SSE
+/* Evaluates 2 to 4 analytic beziers of the same frame, one per SSE lane, with Newton's method as in _spBezier_solve. */
+static void _spCurveTimeline_evaluateBeziers4(spCurveTimeline *self, float time, const float *frames, int valueOffset,
+											  int i, int count, float *values) {
+	const float *curves = self->curves->items;
+	int entries = self->super.frameEntries, lane, iteration;
+	float time1 = frames[0], duration = frames[entries] - time1, percent = (time - time1) / duration;
+	float x1[4], x2[4], y0[4], y1[4], y2[4], y3[4], guesses[4], result[4];
+	__m128 t, low = _mm_setzero_ps(), high = _mm_set1_ps(1), one = high, three = _mm_set1_ps(3);
+	__m128 x = _mm_set1_ps(time - time1), x3 = _mm_set1_ps(duration), epsilon = _mm_set1_ps(ABS(duration) * 0.00001f);
+	__m128 zero = low, vx1, vx2, u, error, slope, next, done, inside, below;
+	for (lane = 0; lane < 4; lane++) {
+		/* Unused lanes repeat the last bezier, so they converge with it. */
+		int channel = lane < count ? lane : count - 1;
+		const float *curve = curves + i + channel * BEZIER_SIZE;
+		x1[lane] = curve[0] - time1;
+		y1[lane] = curve[1];
+		x2[lane] = curve[2] - time1;
+		y2[lane] = curve[3];
+		y0[lane] = frames[valueOffset + channel];
+		y3[lane] = frames[entries + valueOffset + channel];
+		guesses[lane] = _spBezier_guess(curve + 4, percent);
+	}
+	vx1 = _mm_loadu_ps(x1);
+	vx2 = _mm_loadu_ps(x2);
+	t = _mm_loadu_ps(guesses);
+	for (iteration = 0; iteration < 32; iteration++) {
+		u = _mm_sub_ps(one, t);
+		/* 3ut(u x1 + t x2) + t^3 x3 - x */
+		error = _mm_sub_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(three, _mm_mul_ps(u, t)),
+												 _mm_add_ps(_mm_mul_ps(u, vx1), _mm_mul_ps(t, vx2))),
+									  _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), x3)),
+						   x);
+		done = _mm_cmple_ps(_mm_max_ps(error, _mm_sub_ps(zero, error)), epsilon);
+		if (_mm_movemask_ps(done) == 15) break;
+		below = _mm_cmplt_ps(error, zero);
+		low = _mm_or_ps(_mm_and_ps(below, t), _mm_andnot_ps(below, low));
+		high = _mm_or_ps(_mm_andnot_ps(below, t), _mm_and_ps(below, high));
+		/* 3(u^2 x1 + 2ut(x2 - x1) + t^2(x3 - x2)) */
+		slope = _mm_mul_ps(three, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(u, u), vx1),
+														_mm_mul_ps(_mm_mul_ps(_mm_add_ps(u, u), t), _mm_sub_ps(vx2, vx1))),
+											 _mm_mul_ps(_mm_mul_ps(t, t), _mm_sub_ps(x3, vx2))));
+		/* A zero slope gives an infinity or NaN, which is outside the bracket. */
+		next = _mm_sub_ps(t, _mm_div_ps(error, slope));
+		inside = _mm_and_ps(_mm_cmpgt_ps(next, low), _mm_cmplt_ps(next, high));
+		next = _mm_or_ps(_mm_and_ps(inside, next), _mm_andnot_ps(inside, _mm_mul_ps(_mm_add_ps(low, high), _mm_set1_ps(0.5f))));
+		t = _mm_or_ps(_mm_and_ps(done, t), _mm_andnot_ps(done, next));
+	}
+	/* u^3 y0 + 3ut(u y1 + t y2) + t^3 y3 */
+	u = _mm_sub_ps(one, t);
+	_mm_storeu_ps(result, _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_mul_ps(_mm_mul_ps(u, u), u), _mm_loadu_ps(y0)),
+												_mm_mul_ps(_mm_mul_ps(three, _mm_mul_ps(u, t)),
+														   _mm_add_ps(_mm_mul_ps(u, _mm_loadu_ps(y1)),
+																	  _mm_mul_ps(t, _mm_loadu_ps(y2))))),
+									 _mm_mul_ps(_mm_mul_ps(_mm_mul_ps(t, t), t), _mm_loadu_ps(y3))));
+	for (lane = 0; lane < count; lane++)
+		values[lane] = result[lane];
+}
+#endif
+
+/* The frames are from _spCurveTimeline_getFrames. */
+float _spCurveTimeline_getBezierValue(spCurveTimeline *self, float time, const float *frames, int valueOffset, int i) {
 	float *curves = self->curves->items;
-	float *frames = SUPER(self)->frames->items;
 	float x, y;
-	int n;
+	int entries = self->super.frameEntries, n;
+	if (self->quantizedCurves) {
+		return _spCurveTimeline_getQuantizedValue(self, time, frames[0], frames[valueOffset], frames[entries],
+												  frames[entries + valueOffset], i);
+	}
+	if (self->bezierEvaluation != SP_BEZIER_SAMPLED) {
+		return _spCurveTimeline_evaluateBezier(self, time, frames[0], frames[valueOffset], frames[entries],
+											   frames[entries + valueOffset], i);
+	}
 	if (curves[i] > time) {
-		x = frames[frameIndex];
-		y = frames[frameIndex + valueOffset];
+		x = frames[0];
+		y = frames[valueOffset];
 		return y + (time - x) / (curves[i] - x) * (curves[i + 1] - y);
 	}
 	n = i + BEZIER_SIZE;
@@ -249,10 +526,38 @@ float _spCurveTimeline_getBezierValue(spCurveTimeline *self, float time, int fra
 			return y + (time - x) / (curves[i] - x) * (curves[i + 1] - y);
 		}
 	}
-	frameIndex += self->super.frameEntries;
 	x = curves[n - 2];
 	y = curves[n - 1];
-	return y + (time - x) / (frames[frameIndex] - x) * (frames[frameIndex + valueOffset] - y);
+	return y + (time - x) / (frames[entries] - x) * (frames[entries + valueOffset] - y);
+}
+
+/* Evaluates the beziers of count values that follow each other in the frames, from the value offset, and in the curves.
+ * Analytic beziers, including the uniform beziers stored analytic, are solved up to 4 at a time with SSE. */
+static void _spCurveTimeline_getBezierValues(spCurveTimeline *self, float time, const float *frames, int valueOffset,
+											 int i, int count, float *values) {
+	int channel = 0;
+#ifdef ANIMATION_SSE
+	if (self->bezierEvaluation != SP_BEZIER_SAMPLED && !self->quantizedCurves) {
+		float *curves = self->curves->items;
+		int lanes, lane;
+		for (; count - channel >= 2; channel += lanes) {
+			lanes = MIN(count - channel, 4);
+			for (lane = 0; lane < lanes; lane++)
+				if (curves[i + (channel + lane + 1) * BEZIER_SIZE - 1] != BEZIER_ANALYTIC) break;
+			if (lane < lanes) {
+				values[channel] = _spCurveTimeline_getBezierValue(self, time, frames, valueOffset + channel,
+																  i + channel * BEZIER_SIZE);
+				lanes = 1;
+				continue;
+			}
+			_spCurveTimeline_evaluateBeziers4(self, time, frames, valueOffset + channel, i + channel * BEZIER_SIZE, lanes,
+											  values + channel);
+		}
+	}
+#endif
+	for (; channel < count; channel++)
+		values[channel] = _spCurveTimeline_getBezierValue(self, time, frames, valueOffset + channel,
+														  i + channel * BEZIER_SIZE);
 }
 
 void spCurveTimeline_setLinear(spCurveTimeline *self, int frame) {
@@ -263,6 +568,472 @@ void spCurveTimeline_setStepped(spCurveTimeline *self, int frame) {
 	self->curves->items[frame] = CURVE_STEPPED;
 }
 
+static int _spCurveTimeline_getBezierChannels(spCurveTimeline *self) {
+	switch (self->super.type) {
+		case SP_TIMELINE_DEFORM:
+			return 1;
+		case SP_TIMELINE_IKCONSTRAINT:
+			return 2; /* Mix and softness, the other entries are stepped. */
+		default:
+			return self->super.frameEntries - 1;
+	}
+}
+
+/* Returns false if a bezier can't be expressed relative to its segment. */
+static int /*boolean*/ _spCurveTimeline_quantize(spCurveTimeline *self, int bits, spCurveQuantizeReport *report) {
+	float *frames = self->super.frames->items, *curves = self->curves->items;
+	int frameCount = self->super.frameCount, entries = self->super.frameEntries;
+	int channels = _spCurveTimeline_getBezierChannels(self);
+	int deform = self->super.type == SP_TIMELINE_DEFORM;
+	int samplesCount = self->curves->size - frameCount;
+	float timeMin = 0, timeMax = 1, valueMin = 0, valueMax = 1, scale = bits == 8 ? 255.0f : 65535.0f;
+	int pass, frame, channel, i, n;
+
+	if (samplesCount == 0 || self->bezierEvaluation != SP_BEZIER_SAMPLED) return 1;
+	self->quantizedBits = bits;
+	for (pass = 0; pass < 2; pass++) {
+		if (pass == 1) {
+			self->quantizedTimeMin = timeMin;
+			self->quantizedTimeRange = timeMax - timeMin;
+			self->quantizedValueMin = valueMin;
+			self->quantizedValueRange = valueMax - valueMin;
+			self->quantizedCurves = bits == 8 ? (void *) CALLOC(unsigned char, samplesCount)
+											  : (void *) CALLOC(unsigned short, samplesCount);
+		}
+		for (frame = 0; frame < frameCount; frame++) {
+			int curveType = (int) curves[frame];
+			float time1, time2, duration;
+			if (curveType < CURVE_BEZIER) continue;
+			if (frame == frameCount - 1) return 0;
+			time1 = frames[frame * entries];
+			time2 = frames[(frame + 1) * entries];
+			duration = time2 - time1;
+			if (duration <= 0) return 0;
+			for (channel = 0; channel < channels; channel++) {
+				float value1 = deform ? 0 : frames[frame * entries + channel + 1];
+				float value2 = deform ? 1 : frames[(frame + 1) * entries + channel + 1];
+				float change = value2 - value1;
+				i = curveType - CURVE_BEZIER + channel * BEZIER_SIZE;
+				for (n = i + BEZIER_SIZE; i < n; i += 2) {
+					float x = (curves[i] - time1) / duration, y;
+					if (change != 0)
+						y = (curves[i + 1] - value1) / change;
+					else if (curves[i + 1] == value1)
+						y = 0;
+					else
+						return 0;
+					if (pass == 0) {
+						timeMin = MIN(timeMin, x);
+						timeMax = MAX(timeMax, x);
+						valueMin = MIN(valueMin, y);
+						valueMax = MAX(valueMax, y);
+					} else {
+						int k = i - frameCount;
+						unsigned int qx = (unsigned int) ((x - timeMin) / self->quantizedTimeRange * scale + 0.5f);
+						unsigned int qy = (unsigned int) ((y - valueMin) / self->quantizedValueRange * scale + 0.5f);
+						if (bits == 8) {
+							((unsigned char *) self->quantizedCurves)[k] = (unsigned char) qx;
+							((unsigned char *) self->quantizedCurves)[k + 1] = (unsigned char) qy;
+						} else {
+							((unsigned short *) self->quantizedCurves)[k] = (unsigned short) qx;
+							((unsigned short *) self->quantizedCurves)[k + 1] = (unsigned short) qy;
+						}
+						if (report) {
+							float timeError = ABS(QUANTIZED_TIME(self, k, time1, duration) - curves[i]);
+							float valueError = ABS(QUANTIZED_VALUE(self, k + 1, value1, change) - curves[i + 1]);
+							report->maxTimeError = MAX(report->maxTimeError, timeError);
+							report->maxValueError = MAX(report->maxValueError, valueError);
+						}
+					}
+				}
+			}
+		}
+	}
+
+	self->curves->items = REALLOC(self->curves->items, float, frameCount);
+	self->curves->size = self->curves->capacity = frameCount;
+	if (report) report->bytesSaved += samplesCount * (sizeof(float) - bits / 8);
+	return 1;
+}
+
+/* Returns false if the frames can't be quantized without two frames at different times decoding to the same time. */
+static int /*boolean*/ _spCurveTimeline_quantizeFrames(spCurveTimeline *self, spCurveQuantizeReport *report) {
+	float *frames = self->super.frames->items;
+	int entries = self->super.frameEntries, size = self->super.frames->size, column, i;
+	float timeError = 0, valueError = 0;
+
+	/* Deform frames are only times, and the deform apply function reads them in place. With 4 frames or fewer, the min
+	 * and range for each column take more memory than the 16 bit entries save. */
+	if (self->super.type == SP_TIMELINE_DEFORM || self->super.frameCount <= 4) return 1;
+	self->quantizedFrames = MALLOC(unsigned short, size);
+	self->quantizedFrameMin = MALLOC(float, entries);
+	self->quantizedFrameRange = MALLOC(float, entries);
+	for (column = 0; column < entries; column++) {
+		float min = frames[column], max = min;
+		for (i = column + entries; i < size; i += entries) {
+			min = MIN(min, frames[i]);
+			max = MAX(max, frames[i]);
+		}
+		if (!(max - min <= FLT_MAX)) return 0;
+		self->quantizedFrameMin[column] = min;
+		self->quantizedFrameRange[column] = max - min;
+		for (i = column; i < size; i += entries) {
+			float error;
+			self->quantizedFrames[i] = (unsigned short) (max > min ? (frames[i] - min) / (max - min) * 65535 + 0.5f : 0);
+			/* A time rounds down, so a key is still found at its own time, eg when a stepped key is applied exactly. */
+			if (column == 0) {
+				while (self->quantizedFrames[i] > 0 && QUANTIZED_FRAME(self, i, 0) > frames[i])
+					self->quantizedFrames[i]--;
+			}
+			error = ABS(QUANTIZED_FRAME(self, i, column) - frames[i]);
+			if (column == 0) {
+				if (i > 0 && frames[i] > frames[i - entries] &&
+					QUANTIZED_FRAME(self, i, 0) <= QUANTIZED_FRAME(self, i - entries, 0))
+					return 0;
+				timeError = MAX(timeError, error);
+			} else
+				valueError = MAX(valueError, error);
+		}
+	}
+
+	if (report) {
+		report->bytesSaved += size * (sizeof(float) - sizeof(unsigned short)) - entries * 2 * sizeof(float);
+		report->maxTimeError = MAX(report->maxTimeError, timeError);
+		report->maxValueError = MAX(report->maxValueError, valueError);
+	}
+	FREE(self->super.frames->items);
+	self->super.frames->items = 0;
+	self->super.frames->size = 0;
+	self->super.frames->capacity = 0;
+	return 1;
+}
+
+void spAnimation_quantizeCurves(spAnimation *animation, int bits, spCurveQuantizeReport *report) {
+	int i;
+	if (bits <= 0) return;
+	bits = bits > 8 ? 16 : 8;
+	for (i = 0; i < animation->timelines->size; i++) {
+		spTimeline *timeline = animation->timelines->items[i];
+		spCurveTimeline *self;
+		if (!timeline->vtable.setBezier) continue;
+		self = SUB_CAST(spCurveTimeline, timeline);
+		if (self->quantizedFrames) continue;
+		if (!self->quantizedCurves && !_spCurveTimeline_quantize(self, bits, report)) {
+			FREE(self->quantizedCurves);
+			self->quantizedCurves = 0;
+		}
+		/* The bezier samples are relative to the frames, so the frames are quantized last. */
+		if (!_spCurveTimeline_quantizeFrames(self, report)) {
+			FREE(self->quantizedFrames);
+			FREE(self->quantizedFrameMin);
+			FREE(self->quantizedFrameRange);
+			self->quantizedFrames = 0;
+			self->quantizedFrameMin = 0;
+			self->quantizedFrameRange = 0;
+		}
+	}
+}
+
+static float _spCurveTimeline_getOptimizeTolerance(spCurveTimeline *self, float tolerance) {
+	switch (self->super.type) {
+		case SP_TIMELINE_ROTATE:
+		case SP_TIMELINE_TRANSLATE:
+		case SP_TIMELINE_TRANSLATEX:
+		case SP_TIMELINE_TRANSLATEY:
+		case SP_TIMELINE_SHEAR:
+		case SP_TIMELINE_SHEARX:
+		case SP_TIMELINE_SHEARY:
+			return tolerance;
+		default:
+			/* Scales, colors, mixes and the physics values are mostly from 0 to 1. */
+			return tolerance * 0.01f;
+	}
+}
+
+/* The value a relative bone timeline's keys have when they pose the setup pose, or -1 for other timelines. */
+static float _spCurveTimeline_getSetupValue(spCurveTimeline *self) {
+	switch (self->super.type) {
+		case SP_TIMELINE_ROTATE:
+		case SP_TIMELINE_TRANSLATE:
+		case SP_TIMELINE_TRANSLATEX:
+		case SP_TIMELINE_TRANSLATEY:
+		case SP_TIMELINE_SHEAR:
+		case SP_TIMELINE_SHEARX:
+		case SP_TIMELINE_SHEARY:
+			return 0;
+		case SP_TIMELINE_SCALE:
+		case SP_TIMELINE_SCALEX:
+		case SP_TIMELINE_SCALEY:
+			return 1;
+		default:
+			return -1;
+	}
+}
+
+static void _spCurveTimeline_getBezierSample(spCurveTimeline *self, int i, float time1, float value1, float time2,
+											 float value2, float *x, float *y) {
+	if (self->quantizedCurves) {
+		i -= self->super.frameCount;
+		*x = QUANTIZED_TIME(self, i, time1, time2 - time1);
+		*y = QUANTIZED_VALUE(self, i + 1, value1, value2 - value1);
+	} else {
+		*x = self->curves->items[i];
+		*y = self->curves->items[i + 1];
+	}
+}
+
+/* Returns true if the bezier from the frame is within the tolerance of a straight line for every value. */
+static int /*boolean*/ _spCurveTimeline_isBezierLinear(spCurveTimeline *self, int frame, int channels, float tolerance) {
+	float *frames = self->super.frames->items;
+	int entries = self->super.frameEntries, channel, i, n;
+	float time1 = frames[frame * entries], time2 = frames[(frame + 1) * entries];
+	if (time2 <= time1 || self->bezierEvaluation != SP_BEZIER_SAMPLED) return 0;
+	for (channel = 0; channel < channels; channel++) {
+		float value1 = frames[frame * entries + channel + 1], value2 = frames[(frame + 1) * entries + channel + 1];
+		i = (int) self->curves->items[frame] - CURVE_BEZIER + channel * BEZIER_SIZE;
+		for (n = i + BEZIER_SIZE; i < n; i += 2) {
+			float x, y;
+			_spCurveTimeline_getBezierSample(self, i, time1, value1, time2, value2, &x, &y);
+			if (ABS(y - (value1 + (x - time1) / (time2 - time1) * (value2 - value1))) > tolerance) return 0;
+		}
+	}
+	return -1;
+}
+
+/* Returns true if the frames after keep up to and including frame can be removed, so keep's curve runs to the frame after
+ * them. Only linear and stepped frames are removed. Both curves are piecewise linear, so comparing them on either side of
+ * each removed frame and of the frame after them finds the largest error. */
+static int /*boolean*/ _spCurveTimeline_canRemove(spCurveTimeline *self, int keep, int frame, int channels, float tolerance) {
+	float *frames = self->super.frames->items, *curves = self->curves->items;
+	int entries = self->super.frameEntries, stepped = curves[keep] == CURVE_STEPPED, next = frame + 1, offset, i;
+	float time1 = frames[keep * entries], time2 = frames[next * entries];
+	if (time2 <= time1) return 0;
+	for (i = keep; i <= frame; i++)
+		if (curves[i] >= CURVE_BEZIER) return 0;
+	for (offset = 1; offset < entries; offset++) {
+		float value1 = frames[keep * entries + offset], value2 = frames[next * entries + offset];
+		for (i = keep + 1; i <= next; i++) {
+			float value = frames[i * entries + offset], before, after;
+			if (offset > channels) {
+				/* Entries without a curve, such as the IK bend direction, are applied as keyed. */
+				if (i < next && value != value1) return 0;
+				continue;
+			}
+			before = stepped ? value1 : value1 + (frames[i * entries] - time1) / (time2 - time1) * (value2 - value1);
+			after = i == next ? value2 : before;
+			if (ABS(after - value) > tolerance) return 0;
+			if (curves[i - 1] == CURVE_STEPPED) value = frames[(i - 1) * entries + offset];
+			if (ABS(before - value) > tolerance) return 0;
+		}
+	}
+	return -1;
+}
+
+/* Returns the number of frames removed plus the number of beziers made linear. */
+static int _spCurveTimeline_optimize(spCurveTimeline *self, float tolerance) {
+	spTimeline *timeline = SUPER(self);
+	int frameCount = timeline->frameCount, entries = timeline->frameEntries;
+	int channels = _spCurveTimeline_getBezierChannels(self);
+	int elementSize = self->quantizedCurves ? self->quantizedBits / 8 : (int) sizeof(float);
+	int keep, frame, kept, keptCount, beziers, linear = 0, changed = 0;
+	char *keptFrames;
+	spFloatArray *frames, *curves;
+	char *samples;
+
+	if (timeline->type == SP_TIMELINE_DEFORM || frameCount < 2) return 0;
+	tolerance = _spCurveTimeline_getOptimizeTolerance(self, tolerance);
+
+	for (frame = 0; frame < frameCount - 1; frame++) {
+		if (self->curves->items[frame] >= CURVE_BEZIER && _spCurveTimeline_isBezierLinear(self, frame, channels, tolerance)) {
+			self->curves->items[frame] = CURVE_LINEAR;
+			linear++;
+			changed = 1;
+		}
+	}
+
+	keptFrames = MALLOC(char, frameCount);
+	keptFrames[0] = keptFrames[frameCount - 1] = 1;
+	for (frame = 1, keep = 0; frame < frameCount - 1; frame++) {
+		keptFrames[frame] = !_spCurveTimeline_canRemove(self, keep, frame, channels, tolerance);
+		if (keptFrames[frame]) keep = frame;
+		else changed = 1;
+	}
+	if (!changed) {
+		FREE(keptFrames);
+		return 0;
+	}
+
+	for (frame = 0, keptCount = 0, beziers = 0; frame < frameCount; frame++) {
+		if (!keptFrames[frame]) continue;
+		keptCount++;
+		if (frame < frameCount - 1 && self->curves->items[frame] >= CURVE_BEZIER) beziers += channels;
+	}
+	frames = spFloatArray_create(keptCount * entries);
+	frames->size = keptCount * entries;
+	curves = spFloatArray_create(self->quantizedCurves ? keptCount : keptCount + beziers * BEZIER_SIZE);
+	curves->size = curves->capacity;
+	samples = self->quantizedCurves ? MALLOC(char, beziers * BEZIER_SIZE * elementSize) : 0;
+	for (frame = 0, kept = 0, beziers = 0; frame < frameCount; frame++) {
+		int curveType = (int) self->curves->items[frame];
+		if (!keptFrames[frame]) continue;
+		memcpy(frames->items + kept * entries, timeline->frames->items + frame * entries, sizeof(float) * entries);
+		if (curveType >= CURVE_BEZIER && frame < frameCount - 1) {
+			int from = curveType - CURVE_BEZIER, to = beziers * BEZIER_SIZE, count = channels * BEZIER_SIZE;
+			curves->items[kept] = CURVE_BEZIER + keptCount + to;
+			if (self->quantizedCurves)
+				memcpy(samples + to * elementSize, (char *) self->quantizedCurves + (from - frameCount) * elementSize,
+					   count * elementSize);
+			else
+				memcpy(curves->items + keptCount + to, self->curves->items + from, sizeof(float) * count);
+			beziers += channels;
+		} else
+			curves->items[kept] = curveType >= CURVE_BEZIER ? CURVE_STEPPED : curveType;
+		kept++;
+	}
+	FREE(keptFrames);
+	spFloatArray_dispose(timeline->frames);
+	spFloatArray_dispose(self->curves);
+	timeline->frames = frames;
+	self->curves = curves;
+	if (self->quantizedCurves) {
+		FREE(self->quantizedCurves);
+		self->quantizedCurves = samples;
+	}
+	timeline->frameCount = kept;
+	return frameCount - kept + linear;
+}
+
+int spAnimation_optimize(spAnimation *self, float tolerance) {
+	int i, ii, changes = 0;
+	spTimelineArray *timelines = self->timelines;
+	for (i = 0, ii = 0; i < timelines->size; i++) {
+		spTimeline *timeline = timelines->items[i];
+		if (timeline->vtable.setBezier && !SUB_CAST(spCurveTimeline, timeline)->quantizedFrames) {
+			spCurveTimeline *curveTimeline = SUB_CAST(spCurveTimeline, timeline);
+			float setup = _spCurveTimeline_getSetupValue(curveTimeline);
+			changes += _spCurveTimeline_optimize(curveTimeline, tolerance);
+			if (setup != -1) {
+				float valueTolerance = _spCurveTimeline_getOptimizeTolerance(curveTimeline, tolerance);
+				int frame, entry, constant = 1;
+				for (frame = 0; frame < timeline->frameCount && constant; frame++) {
+					if (frame < timeline->frameCount - 1 && curveTimeline->curves->items[frame] >= CURVE_BEZIER)
+						constant = 0;
+					for (entry = 1; entry < timeline->frameEntries; entry++)
+						if (ABS(timeline->frames->items[frame * timeline->frameEntries + entry] - setup) > valueTolerance)
+							constant = 0;
+				}
+				if (constant) {
+					changes += timeline->frameCount;
+					spTimeline_dispose(timeline);
+					continue;
+				}
+			}
+		}
+		timelines->items[ii++] = timeline;
+	}
+	timelines->size = ii;
+
+	_spAnimation_updateTimelineIds(self);
+	return changes;
+}
+
+/* Converts a bezier from the 9 points set by _spCurveTimeline_setBezier. The points are at 0.1 steps of the curve
+ * parameter, so the control points are found from the points at 0.3 and 0.7 and the segment's end points. */
+static void _spCurveTimeline_convertBezier(spCurveTimeline *self, int i, float time1, float value1, float time2,
+										   float value2) {
+	float *curves = self->curves->items;
+	double b = 3 * 0.3 * 0.7 * 0.7, c = 3 * 0.3 * 0.3 * 0.7, a = 0.7 * 0.7 * 0.7, d = 0.3 * 0.3 * 0.3, det = b * b - c * c;
+	double rx1 = curves[i + 4] - a * time1 - d * time2, rx2 = curves[i + 12] - d * time1 - a * time2;
+	double ry1 = curves[i + 5] - a * value1 - d * value2, ry2 = curves[i + 13] - d * value1 - a * value2;
+	float cx1 = (float) ((rx1 * b - rx2 * c) / det), cx2 = (float) ((rx2 * b - rx1 * c) / det);
+	float cy1 = (float) ((ry1 * b - ry2 * c) / det), cy2 = (float) ((ry2 * b - ry1 * c) / det);
+	float duration = time2 - time1, analytic[BEZIER_SIZE], table[BEZIER_SIZE], error = 0, min, max;
+	int step;
+
+	analytic[0] = cx1;
+	analytic[1] = cy1;
+	analytic[2] = cx2;
+	analytic[3] = cy2;
+	for (step = 1; step < BEZIER_GUESS_STEPS; step++) {
+		analytic[3 + step] = _spBezier_solve(cx1 - time1, cx2 - time1, duration, duration * step / BEZIER_GUESS_STEPS,
+											 (float) step / BEZIER_GUESS_STEPS);
+	}
+	analytic[BEZIER_SIZE - 1] = BEZIER_ANALYTIC;
+
+	if (self->bezierEvaluation == SP_BEZIER_UNIFORM) {
+		for (step = 1; step <= BEZIER_SIZE; step++) {
+			table[step - 1] = _spBezier_evaluate(analytic, time1 + duration * step / BEZIER_UNIFORM_STEPS, time1, value1,
+												 time2, value2);
+		}
+		/* The table interpolates linearly, which is coarse where the curve is steep, eg at a vertical tangent. It is
+		 * checked between its steps against the curve, which stays within the control points' values. */
+		for (step = 0; step < BEZIER_UNIFORM_STEPS * 4; step++) {
+			float percent = (step + 0.5f) / (BEZIER_UNIFORM_STEPS * 4), time = time1 + duration * percent;
+			float value = _spBezier_interpolate(table, percent, value1, value2);
+			error = MAX(error, ABS(value - _spBezier_evaluate(analytic, time, time1, value1, time2, value2)));
+		}
+		min = MIN(MIN(value1, value2), MIN(cy1, cy2));
+		max = MAX(MAX(value1, value2), MAX(cy1, cy2));
+		if (error <= (max - min) * BEZIER_UNIFORM_TOLERANCE) {
+			memcpy(curves + i, table, sizeof(table));
+			return;
+		}
+	}
+	memcpy(curves + i, analytic, sizeof(analytic));
+}
+
+/* Returns false if a bezier's time goes backward, where evaluation order decides the value and only the samples match the
+ * editor. */
+static int /*boolean*/ _spCurveTimeline_isBezierMonotonic(spCurveTimeline *self, int channels) {
+	float *frames = self->super.frames->items, *curves = self->curves->items;
+	int entries = self->super.frameEntries, frame, channel, i, n;
+	for (frame = 0; frame < self->super.frameCount - 1; frame++) {
+		if (curves[frame] < CURVE_BEZIER) continue;
+		for (channel = 0; channel < channels; channel++) {
+			float before = frames[frame * entries];
+			i = (int) curves[frame] - CURVE_BEZIER + channel * BEZIER_SIZE;
+			for (n = i + BEZIER_SIZE; i < n; i += 2) {
+				if (curves[i] < before) return 0;
+				before = curves[i];
+			}
+			if (before > frames[(frame + 1) * entries]) return 0;
+		}
+	}
+	return -1;
+}
+
+void spAnimation_setBezierEvaluation(spAnimation *self, spBezierEvaluation evaluation) {
+	int i, frame, channel;
+	if (evaluation == SP_BEZIER_SAMPLED) return;
+	for (i = 0; i < self->timelines->size; i++) {
+		spTimeline *timeline = self->timelines->items[i];
+		spCurveTimeline *curveTimeline;
+		float *frames;
+		int entries, channels, deform;
+		if (!timeline->vtable.setBezier) continue;
+		curveTimeline = SUB_CAST(spCurveTimeline, timeline);
+		if (curveTimeline->bezierEvaluation != SP_BEZIER_SAMPLED || curveTimeline->quantizedCurves ||
+			curveTimeline->quantizedFrames)
+			continue;
+		channels = _spCurveTimeline_getBezierChannels(curveTimeline);
+		if (!_spCurveTimeline_isBezierMonotonic(curveTimeline, channels)) continue;
+		curveTimeline->bezierEvaluation = evaluation;
+		frames = timeline->frames->items;
+		entries = timeline->frameEntries;
+		deform = timeline->type == SP_TIMELINE_DEFORM;
+		for (frame = 0; frame < timeline->frameCount - 1; frame++) {
+			int curveType = (int) curveTimeline->curves->items[frame];
+			if (curveType < CURVE_BEZIER) continue;
+			for (channel = 0; channel < channels; channel++) {
+				float value1 = deform ? 0 : frames[frame * entries + channel + 1];
+				float value2 = deform ? 1 : frames[(frame + 1) * entries + channel + 1];
+				_spCurveTimeline_convertBezier(curveTimeline, curveType - CURVE_BEZIER + channel * BEZIER_SIZE,
+											   frames[frame * entries], value1, frames[(frame + 1) * entries], value2);
+			}
+		}
+	}
+}
+
 #define CURVE1_ENTRIES 2
 #define CURVE1_VALUE 1
 
@@ -274,33 +1045,32 @@ void spCurveTimeline1_setFrame(spCurveTimeline1 *self, int frame, float time, fl
 }
 
 float spCurveTimeline1_getCurveValue(spCurveTimeline1 *self, float time) {
-	float *frames = self->super.frames->items;
+	return _spCurveTimeline1_getCurveValue(self, time, 0);
+}
+
+float _spCurveTimeline1_getCurveValue(spCurveTimeline1 *self, float time, int *cursor) {
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves = self->curves->items;
-	int i = self->super.frames->size - 2;
-	int ii, curveType;
-	for (ii = 2; ii <= i; ii += 2) {
-		if (frames[ii] > time) {
-			i = ii - 2;
-			break;
-		}
-	}
+	int i = _spCurveTimeline_search(self, time, CURVE1_ENTRIES, cursor);
+	int curveType;
 
 	curveType = (int) curves[i >> 1];
+	frames = _spCurveTimeline_getFrames(self, i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i], value = frames[i + CURVE1_VALUE];
-			return value + (time - before) / (frames[i + CURVE1_ENTRIES] - before) *
-								   (frames[i + CURVE1_ENTRIES + CURVE1_VALUE] - value);
+			float before = frames[0], value = frames[CURVE1_VALUE];
+			return value + (time - before) / (frames[CURVE1_ENTRIES] - before) *
+								   (frames[CURVE1_ENTRIES + CURVE1_VALUE] - value);
 		}
 		case CURVE_STEPPED:
-			return frames[i + CURVE1_VALUE];
+			return frames[CURVE1_VALUE];
 	}
-	return _spCurveTimeline_getBezierValue(self, time, i, CURVE1_VALUE, curveType - CURVE_BEZIER);
+	return _spCurveTimeline_getBezierValue(self, time, frames, CURVE1_VALUE, curveType - CURVE_BEZIER);
 }
 
-float spCurveTimeline1_getRelativeValue(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, float current, float setup) {
-	float *frames = self->super.frames->items;
-	if (time < frames[0]) {
+static float _spCurveTimeline1_getRelativeValue(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, float current, float setup, int *cursor) {
+	if (time < _spCurveTimeline_getStart(self)) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				return setup;
@@ -310,7 +1080,7 @@ float spCurveTimeline1_getRelativeValue(spCurveTimeline1 *self, float time, floa
 				return current;
 		}
 	}
-	float value = spCurveTimeline1_getCurveValue(self, time);
+	float value = _spCurveTimeline1_getCurveValue(self, time, cursor);
 	switch (blend) {
 		case SP_MIX_BLEND_SETUP:
 			return setup + value * alpha;
@@ -324,9 +1094,12 @@ float spCurveTimeline1_getRelativeValue(spCurveTimeline1 *self, float time, floa
 	return current + value * alpha;
 }
 
-float spCurveTimeline1_getAbsoluteValue(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, float current, float setup) {
-	float *frames = self->super.frames->items;
-	if (time < frames[0]) {
+float spCurveTimeline1_getRelativeValue(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, float current, float setup) {
+	return _spCurveTimeline1_getRelativeValue(self, time, alpha, blend, current, setup, 0);
+}
+
+static float _spCurveTimeline1_getAbsoluteValue(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, float current, float setup, int *cursor) {
+	if (time < _spCurveTimeline_getStart(self)) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				return setup;
@@ -336,14 +1109,17 @@ float spCurveTimeline1_getAbsoluteValue(spCurveTimeline1 *self, float time, floa
 				return current;
 		}
 	}
-	float value = spCurveTimeline1_getCurveValue(self, time);
+	float value = _spCurveTimeline1_getCurveValue(self, time, cursor);
 	if (blend == SP_MIX_BLEND_SETUP) return setup + (value - setup) * alpha;
 	return current + (value - current) * alpha;
 }
 
+float spCurveTimeline1_getAbsoluteValue(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, float current, float setup) {
+	return _spCurveTimeline1_getAbsoluteValue(self, time, alpha, blend, current, setup, 0);
+}
+
 float spCurveTimeline1_getAbsoluteValue2(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, float current, float setup, float value) {
-	float *frames = self->super.frames->items;
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(self)) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				return setup;
@@ -357,9 +1133,8 @@ float spCurveTimeline1_getAbsoluteValue2(spCurveTimeline1 *self, float time, flo
 	return current + (value - current) * alpha;
 }
 
-float spCurveTimeline1_getScaleValue(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, spMixDirection direction, float current, float setup) {
-	float *frames = self->super.frames->items;
-	if (time < frames[0]) {
+static float _spCurveTimeline1_getScaleValue(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, spMixDirection direction, float current, float setup, int *cursor) {
+	if (time < _spCurveTimeline_getStart(self)) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				return setup;
@@ -369,7 +1144,7 @@ float spCurveTimeline1_getScaleValue(spCurveTimeline1 *self, float time, float a
 				return current;
 		}
 	}
-	float value = spCurveTimeline1_getCurveValue(self, time) * setup;
+	float value = _spCurveTimeline1_getCurveValue(self, time, cursor) * setup;
 	if (alpha == 1) {
 		if (blend == SP_MIX_BLEND_ADD) return current + value - setup;
 		return value;
@@ -402,6 +1177,10 @@ float spCurveTimeline1_getScaleValue(spCurveTimeline1 *self, float time, float a
 	return current + (value - setup) * alpha;
 }
 
+float spCurveTimeline1_getScaleValue(spCurveTimeline1 *self, float time, float alpha, spMixBlend blend, spMixDirection direction, float current, float setup) {
+	return _spCurveTimeline1_getScaleValue(self, time, alpha, blend, direction, current, setup, 0);
+}
+
 #define CURVE2_ENTRIES 3
 #define CURVE2_VALUE1 1
 #define CURVE2_VALUE2 2
@@ -420,7 +1199,7 @@ void _spRotateTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float l
 							 int *eventsCount, float alpha, spMixBlend blend, spMixDirection direction) {
 	spRotateTimeline *self = SUB_CAST(spRotateTimeline, timeline);
 	spBone *bone = skeleton->bones[self->boneIndex];
-	if (bone->active) bone->rotation = spCurveTimeline1_getRelativeValue(SUPER(self), time, alpha, blend, bone->rotation, bone->data->rotation);
+	if (bone->active) bone->rotation = _spCurveTimeline1_getRelativeValue(SUPER(self), time, alpha, blend, bone->rotation, bone->data->rotation, CURSOR(skeleton));
 
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -452,13 +1231,14 @@ void _spTranslateTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, floa
 	int i, curveType;
 
 	spTranslateTimeline *self = SUB_CAST(spTranslateTimeline, timeline);
-	float *frames = self->super.super.frames->items;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves = self->super.curves->items;
 
 	bone = skeleton->bones[self->boneIndex];
 	if (!bone->active) return;
 
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				bone->x = bone->data->x;
@@ -473,27 +1253,29 @@ void _spTranslateTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, floa
 		return;
 	}
 
-	i = search2(self->super.super.frames, time, CURVE2_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, CURVE2_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i / CURVE2_ENTRIES];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			x = frames[i + CURVE2_VALUE1];
-			y = frames[i + CURVE2_VALUE2];
-			t = (time - before) / (frames[i + CURVE2_ENTRIES] - before);
-			x += (frames[i + CURVE2_ENTRIES + CURVE2_VALUE1] - x) * t;
-			y += (frames[i + CURVE2_ENTRIES + CURVE2_VALUE2] - y) * t;
+			float before = frames[0];
+			x = frames[CURVE2_VALUE1];
+			y = frames[CURVE2_VALUE2];
+			t = (time - before) / (frames[CURVE2_ENTRIES] - before);
+			x += (frames[CURVE2_ENTRIES + CURVE2_VALUE1] - x) * t;
+			y += (frames[CURVE2_ENTRIES + CURVE2_VALUE2] - y) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			x = frames[i + CURVE2_VALUE1];
-			y = frames[i + CURVE2_VALUE2];
+			x = frames[CURVE2_VALUE1];
+			y = frames[CURVE2_VALUE2];
 			break;
 		}
 		default: {
-			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE1, curveType - CURVE_BEZIER);
-			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE2,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+			float values[2];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, CURVE2_VALUE1, curveType - CURVE_BEZIER, 2, values);
+			x = values[0];
+			y = values[1];
 		}
 	}
 
@@ -542,12 +1324,11 @@ void _spTranslateXTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, flo
 	float x;
 
 	spTranslateXTimeline *self = SUB_CAST(spTranslateXTimeline, timeline);
-	float *frames = self->super.super.frames->items;
 
 	bone = skeleton->bones[self->boneIndex];
 	if (!bone->active) return;
 
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				bone->x = bone->data->x;
@@ -560,7 +1341,7 @@ void _spTranslateXTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, flo
 		return;
 	}
 
-	x = spCurveTimeline1_getCurveValue(SUPER(self), time);
+	x = _spCurveTimeline1_getCurveValue(SUPER(self), time, CURSOR(skeleton));
 	switch (blend) {
 		case SP_MIX_BLEND_SETUP:
 			bone->x = bone->data->x + x * alpha;
@@ -602,12 +1383,11 @@ void _spTranslateYTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, flo
 	float y;
 
 	spTranslateYTimeline *self = SUB_CAST(spTranslateYTimeline, timeline);
-	float *frames = self->super.super.frames->items;
 
 	bone = skeleton->bones[self->boneIndex];
 	if (!bone->active) return;
 
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				bone->y = bone->data->y;
@@ -620,7 +1400,7 @@ void _spTranslateYTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, flo
 		return;
 	}
 
-	y = spCurveTimeline1_getCurveValue(SUPER(self), time);
+	y = _spCurveTimeline1_getCurveValue(SUPER(self), time, CURSOR(skeleton));
 	switch (blend) {
 		case SP_MIX_BLEND_SETUP:
 			bone->y = bone->data->y + y * alpha;
@@ -662,12 +1442,13 @@ void _spScaleTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 	float x, y, t;
 
 	spScaleTimeline *self = SUB_CAST(spScaleTimeline, timeline);
-	float *frames = self->super.super.frames->items;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves = self->super.curves->items;
 
 	bone = skeleton->bones[self->boneIndex];
 	if (!bone->active) return;
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				bone->scaleX = bone->data->scaleX;
@@ -682,27 +1463,29 @@ void _spScaleTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 		return;
 	}
 
-	i = search2(self->super.super.frames, time, CURVE2_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, CURVE2_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i / CURVE2_ENTRIES];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			x = frames[i + CURVE2_VALUE1];
-			y = frames[i + CURVE2_VALUE2];
-			t = (time - before) / (frames[i + CURVE2_ENTRIES] - before);
-			x += (frames[i + CURVE2_ENTRIES + CURVE2_VALUE1] - x) * t;
-			y += (frames[i + CURVE2_ENTRIES + CURVE2_VALUE2] - y) * t;
+			float before = frames[0];
+			x = frames[CURVE2_VALUE1];
+			y = frames[CURVE2_VALUE2];
+			t = (time - before) / (frames[CURVE2_ENTRIES] - before);
+			x += (frames[CURVE2_ENTRIES + CURVE2_VALUE1] - x) * t;
+			y += (frames[CURVE2_ENTRIES + CURVE2_VALUE2] - y) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			x = frames[i + CURVE2_VALUE1];
-			y = frames[i + CURVE2_VALUE2];
+			x = frames[CURVE2_VALUE1];
+			y = frames[CURVE2_VALUE2];
 			break;
 		}
 		default: {
-			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE1, curveType - CURVE_BEZIER);
-			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE2,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+			float values[2];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, CURVE2_VALUE1, curveType - CURVE_BEZIER, 2, values);
+			x = values[0];
+			y = values[1];
 		}
 	}
 	x *= bone->data->scaleX;
@@ -787,7 +1570,7 @@ void _spScaleXTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float l
 	spScaleXTimeline *self = SUB_CAST(spScaleXTimeline, timeline);
 	spBone *bone = skeleton->bones[self->boneIndex];
 
-	if (bone->active) bone->scaleX = spCurveTimeline1_getScaleValue(SUPER(self), time, alpha, blend, direction, bone->scaleX, bone->data->scaleX);
+	if (bone->active) bone->scaleX = _spCurveTimeline1_getScaleValue(SUPER(self), time, alpha, blend, direction, bone->scaleX, bone->data->scaleX, CURSOR(skeleton));
 
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -816,7 +1599,7 @@ void _spScaleYTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float l
 	spScaleYTimeline *self = SUB_CAST(spScaleYTimeline, timeline);
 	spBone *bone = skeleton->bones[self->boneIndex];
 
-	if (bone->active) bone->scaleY = spCurveTimeline1_getScaleValue(SUPER(self), time, alpha, blend, direction, bone->scaleX, bone->data->scaleY);
+	if (bone->active) bone->scaleY = _spCurveTimeline1_getScaleValue(SUPER(self), time, alpha, blend, direction, bone->scaleX, bone->data->scaleY, CURSOR(skeleton));
 
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -846,12 +1629,13 @@ void _spShearTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 	int i, curveType;
 
 	spShearTimeline *self = SUB_CAST(spShearTimeline, timeline);
-	float *frames = SUPER(self)->super.frames->items;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves = SUPER(self)->curves->items;
 
 	bone = skeleton->bones[self->boneIndex];
 	if (!bone->active) return;
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				bone->shearX = bone->data->shearX;
@@ -866,27 +1650,29 @@ void _spShearTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 		return;
 	}
 
-	i = search2(self->super.super.frames, time, CURVE2_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, CURVE2_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i / CURVE2_ENTRIES];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			x = frames[i + CURVE2_VALUE1];
-			y = frames[i + CURVE2_VALUE2];
-			t = (time - before) / (frames[i + CURVE2_ENTRIES] - before);
-			x += (frames[i + CURVE2_ENTRIES + CURVE2_VALUE1] - x) * t;
-			y += (frames[i + CURVE2_ENTRIES + CURVE2_VALUE2] - y) * t;
+			float before = frames[0];
+			x = frames[CURVE2_VALUE1];
+			y = frames[CURVE2_VALUE2];
+			t = (time - before) / (frames[CURVE2_ENTRIES] - before);
+			x += (frames[CURVE2_ENTRIES + CURVE2_VALUE1] - x) * t;
+			y += (frames[CURVE2_ENTRIES + CURVE2_VALUE2] - y) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			x = frames[i + CURVE2_VALUE1];
-			y = frames[i + CURVE2_VALUE2];
+			x = frames[CURVE2_VALUE1];
+			y = frames[CURVE2_VALUE2];
 			break;
 		}
 		default: {
-			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE1, curveType - CURVE_BEZIER);
-			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, CURVE2_VALUE2,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
+			float values[2];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, CURVE2_VALUE1, curveType - CURVE_BEZIER, 2, values);
+			x = values[0];
+			y = values[1];
 		}
 	}
 
@@ -934,7 +1720,7 @@ void _spShearXTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float l
 	spShearXTimeline *self = SUB_CAST(spShearXTimeline, timeline);
 	spBone *bone = skeleton->bones[self->boneIndex];
 
-	if (bone->active) bone->shearX = spCurveTimeline1_getRelativeValue(SUPER(self), time, alpha, blend, bone->shearX, bone->data->shearX);
+	if (bone->active) bone->shearX = _spCurveTimeline1_getRelativeValue(SUPER(self), time, alpha, blend, bone->shearX, bone->data->shearX, CURSOR(skeleton));
 
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -964,7 +1750,7 @@ void _spShearYTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float l
 	spShearYTimeline *self = SUB_CAST(spShearYTimeline, timeline);
 	spBone *bone = skeleton->bones[self->boneIndex];
 
-	if (bone->active) bone->shearY = spCurveTimeline1_getRelativeValue(SUPER(self), time, alpha, blend, bone->shearY, bone->data->shearY);
+	if (bone->active) bone->shearY = _spCurveTimeline1_getRelativeValue(SUPER(self), time, alpha, blend, bone->shearY, bone->data->shearY, CURSOR(skeleton));
 
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -998,13 +1784,14 @@ void _spRGBATimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float las
 	spColor *color;
 	spColor *setup;
 	spRGBATimeline *self = (spRGBATimeline *) timeline;
-	float *frames = self->super.super.frames->items;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves = self->super.curves->items;
 
 	slot = skeleton->slots[self->slotIndex];
 	if (!slot->bone->active) return;
 
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		color = &slot->color;
 		setup = &slot->data->color;
 		switch (blend) {
@@ -1021,37 +1808,37 @@ void _spRGBATimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float las
 		return;
 	}
 
-	i = search2(self->super.super.frames, time, RGBA_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, RGBA_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i / RGBA_ENTRIES];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			r = frames[i + COLOR_R];
-			g = frames[i + COLOR_G];
-			b = frames[i + COLOR_B];
-			a = frames[i + COLOR_A];
-			t = (time - before) / (frames[i + RGBA_ENTRIES] - before);
-			r += (frames[i + RGBA_ENTRIES + COLOR_R] - r) * t;
-			g += (frames[i + RGBA_ENTRIES + COLOR_G] - g) * t;
-			b += (frames[i + RGBA_ENTRIES + COLOR_B] - b) * t;
-			a += (frames[i + RGBA_ENTRIES + COLOR_A] - a) * t;
+			float before = frames[0];
+			r = frames[COLOR_R];
+			g = frames[COLOR_G];
+			b = frames[COLOR_B];
+			a = frames[COLOR_A];
+			t = (time - before) / (frames[RGBA_ENTRIES] - before);
+			r += (frames[RGBA_ENTRIES + COLOR_R] - r) * t;
+			g += (frames[RGBA_ENTRIES + COLOR_G] - g) * t;
+			b += (frames[RGBA_ENTRIES + COLOR_B] - b) * t;
+			a += (frames[RGBA_ENTRIES + COLOR_A] - a) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			r = frames[i + COLOR_R];
-			g = frames[i + COLOR_G];
-			b = frames[i + COLOR_B];
-			a = frames[i + COLOR_A];
+			r = frames[COLOR_R];
+			g = frames[COLOR_G];
+			b = frames[COLOR_B];
+			a = frames[COLOR_A];
 			break;
 		}
 		default: {
-			r = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R, curveType - CURVE_BEZIER);
-			g = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
-			b = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
-			a = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_A,
-												curveType + BEZIER_SIZE * 3 - CURVE_BEZIER);
+			float values[4];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, COLOR_R, curveType - CURVE_BEZIER, 4, values);
+			r = values[0];
+			g = values[1];
+			b = values[2];
+			a = values[3];
 		}
 	}
 	color = &slot->color;
@@ -1102,13 +1889,14 @@ void _spRGBTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float last
 	spColor *color;
 	spColor *setup;
 	spRGBTimeline *self = (spRGBTimeline *) timeline;
-	float *frames = self->super.super.frames->items;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves = self->super.curves->items;
 
 	slot = skeleton->slots[self->slotIndex];
 	if (!slot->bone->active) return;
 
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		color = &slot->color;
 		setup = &slot->data->color;
 		switch (blend) {
@@ -1125,32 +1913,33 @@ void _spRGBTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float last
 		return;
 	}
 
-	i = search2(self->super.super.frames, time, RGB_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, RGB_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i / RGB_ENTRIES];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			r = frames[i + COLOR_R];
-			g = frames[i + COLOR_G];
-			b = frames[i + COLOR_B];
-			t = (time - before) / (frames[i + RGB_ENTRIES] - before);
-			r += (frames[i + RGB_ENTRIES + COLOR_R] - r) * t;
-			g += (frames[i + RGB_ENTRIES + COLOR_G] - g) * t;
-			b += (frames[i + RGB_ENTRIES + COLOR_B] - b) * t;
+			float before = frames[0];
+			r = frames[COLOR_R];
+			g = frames[COLOR_G];
+			b = frames[COLOR_B];
+			t = (time - before) / (frames[RGB_ENTRIES] - before);
+			r += (frames[RGB_ENTRIES + COLOR_R] - r) * t;
+			g += (frames[RGB_ENTRIES + COLOR_G] - g) * t;
+			b += (frames[RGB_ENTRIES + COLOR_B] - b) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			r = frames[i + COLOR_R];
-			g = frames[i + COLOR_G];
-			b = frames[i + COLOR_B];
+			r = frames[COLOR_R];
+			g = frames[COLOR_G];
+			b = frames[COLOR_B];
 			break;
 		}
 		default: {
-			r = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R, curveType - CURVE_BEZIER);
-			g = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
-			b = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
+			float values[3];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, COLOR_R, curveType - CURVE_BEZIER, 3, values);
+			r = values[0];
+			g = values[1];
+			b = values[2];
 		}
 	}
 	color = &slot->color;
@@ -1204,12 +1993,11 @@ void _spAlphaTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 	spColor *color;
 	spColor *setup;
 	spAlphaTimeline *self = (spAlphaTimeline *) timeline;
-	float *frames = self->super.super.frames->items;
 
 	slot = skeleton->slots[self->slotIndex];
 	if (!slot->bone->active) return;
 
-	if (time < frames[0]) { /* Time is before first frame-> */
+	if (time < _spCurveTimeline_getStart(SUPER(self))) { /* Time is before first frame-> */
 		color = &slot->color;
 		setup = &slot->data->color;
 		switch (blend) {
@@ -1224,7 +2012,7 @@ void _spAlphaTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 		return;
 	}
 
-	a = spCurveTimeline1_getCurveValue(SUPER(self), time);
+	a = _spCurveTimeline1_getCurveValue(SUPER(self), time, CURSOR(skeleton));
 	if (alpha == 1)
 		slot->color.a = a;
 	else {
@@ -1264,13 +2052,14 @@ void _spRGBA2Timeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 	spColor *light, *setupLight;
 	spColor *dark, *setupDark;
 	spRGBA2Timeline *self = (spRGBA2Timeline *) timeline;
-	float *frames = self->super.super.frames->items;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves = self->super.curves->items;
 
 	slot = skeleton->slots[self->slotIndex];
 	if (!slot->bone->active) return;
 
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		light = &slot->color;
 		dark = slot->darkColor;
 		setupLight = &slot->data->color;
@@ -1294,52 +2083,49 @@ void _spRGBA2Timeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 	}
 
 	r = 0, g = 0, b = 0, a = 0, r2 = 0, g2 = 0, b2 = 0;
-	i = search2(self->super.super.frames, time, RGBA2_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, RGBA2_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i / RGBA2_ENTRIES];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			r = frames[i + COLOR_R];
-			g = frames[i + COLOR_G];
-			b = frames[i + COLOR_B];
-			a = frames[i + COLOR_A];
-			r2 = frames[i + COLOR_R2];
-			g2 = frames[i + COLOR_G2];
-			b2 = frames[i + COLOR_B2];
-			t = (time - before) / (frames[i + RGBA2_ENTRIES] - before);
-			r += (frames[i + RGBA2_ENTRIES + COLOR_R] - r) * t;
-			g += (frames[i + RGBA2_ENTRIES + COLOR_G] - g) * t;
-			b += (frames[i + RGBA2_ENTRIES + COLOR_B] - b) * t;
-			a += (frames[i + RGBA2_ENTRIES + COLOR_A] - a) * t;
-			r2 += (frames[i + RGBA2_ENTRIES + COLOR_R2] - r2) * t;
-			g2 += (frames[i + RGBA2_ENTRIES + COLOR_G2] - g2) * t;
-			b2 += (frames[i + RGBA2_ENTRIES + COLOR_B2] - b2) * t;
+			float before = frames[0];
+			r = frames[COLOR_R];
+			g = frames[COLOR_G];
+			b = frames[COLOR_B];
+			a = frames[COLOR_A];
+			r2 = frames[COLOR_R2];
+			g2 = frames[COLOR_G2];
+			b2 = frames[COLOR_B2];
+			t = (time - before) / (frames[RGBA2_ENTRIES] - before);
+			r += (frames[RGBA2_ENTRIES + COLOR_R] - r) * t;
+			g += (frames[RGBA2_ENTRIES + COLOR_G] - g) * t;
+			b += (frames[RGBA2_ENTRIES + COLOR_B] - b) * t;
+			a += (frames[RGBA2_ENTRIES + COLOR_A] - a) * t;
+			r2 += (frames[RGBA2_ENTRIES + COLOR_R2] - r2) * t;
+			g2 += (frames[RGBA2_ENTRIES + COLOR_G2] - g2) * t;
+			b2 += (frames[RGBA2_ENTRIES + COLOR_B2] - b2) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			r = frames[i + COLOR_R];
-			g = frames[i + COLOR_G];
-			b = frames[i + COLOR_B];
-			a = frames[i + COLOR_A];
-			r2 = frames[i + COLOR_R2];
-			g2 = frames[i + COLOR_G2];
-			b2 = frames[i + COLOR_B2];
+			r = frames[COLOR_R];
+			g = frames[COLOR_G];
+			b = frames[COLOR_B];
+			a = frames[COLOR_A];
+			r2 = frames[COLOR_R2];
+			g2 = frames[COLOR_G2];
+			b2 = frames[COLOR_B2];
 			break;
 		}
 		default: {
-			r = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R, curveType - CURVE_BEZIER);
-			g = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
-			b = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
-			a = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_A,
-												curveType + BEZIER_SIZE * 3 - CURVE_BEZIER);
-			r2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R2,
-												 curveType + BEZIER_SIZE * 4 - CURVE_BEZIER);
-			g2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G2,
-												 curveType + BEZIER_SIZE * 5 - CURVE_BEZIER);
-			b2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B2,
-												 curveType + BEZIER_SIZE * 6 - CURVE_BEZIER);
+			float values[7];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, COLOR_R, curveType - CURVE_BEZIER, 7, values);
+			r = values[0];
+			g = values[1];
+			b = values[2];
+			a = values[3];
+			r2 = values[4];
+			g2 = values[5];
+			b2 = values[6];
 		}
 	}
 
@@ -1403,13 +2189,14 @@ void _spRGB2Timeline_apply(spTimeline *timeline, spSkeleton *skeleton, float las
 	spColor *light, *setupLight;
 	spColor *dark, *setupDark;
 	spRGB2Timeline *self = (spRGB2Timeline *) timeline;
-	float *frames = self->super.super.frames->items;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves = self->super.curves->items;
 
 	slot = skeleton->slots[self->slotIndex];
 	if (!slot->bone->active) return;
 
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		light = &slot->color;
 		dark = slot->darkColor;
 		setupLight = &slot->data->color;
@@ -1432,47 +2219,45 @@ void _spRGB2Timeline_apply(spTimeline *timeline, spSkeleton *skeleton, float las
 	}
 
 	r = 0, g = 0, b = 0, r2 = 0, g2 = 0, b2 = 0;
-	i = search2(self->super.super.frames, time, RGB2_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, RGB2_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i / RGB2_ENTRIES];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			r = frames[i + COLOR_R];
-			g = frames[i + COLOR_G];
-			b = frames[i + COLOR_B];
-			r2 = frames[i + COLOR2_R2];
-			g2 = frames[i + COLOR2_G2];
-			b2 = frames[i + COLOR2_B2];
-			t = (time - before) / (frames[i + RGB2_ENTRIES] - before);
-			r += (frames[i + RGB2_ENTRIES + COLOR_R] - r) * t;
-			g += (frames[i + RGB2_ENTRIES + COLOR_G] - g) * t;
-			b += (frames[i + RGB2_ENTRIES + COLOR_B] - b) * t;
-			r2 += (frames[i + RGB2_ENTRIES + COLOR2_R2] - r2) * t;
-			g2 += (frames[i + RGB2_ENTRIES + COLOR2_G2] - g2) * t;
-			b2 += (frames[i + RGB2_ENTRIES + COLOR2_B2] - b2) * t;
+			float before = frames[0];
+			r = frames[COLOR_R];
+			g = frames[COLOR_G];
+			b = frames[COLOR_B];
+			r2 = frames[COLOR2_R2];
+			g2 = frames[COLOR2_G2];
+			b2 = frames[COLOR2_B2];
+			t = (time - before) / (frames[RGB2_ENTRIES] - before);
+			r += (frames[RGB2_ENTRIES + COLOR_R] - r) * t;
+			g += (frames[RGB2_ENTRIES + COLOR_G] - g) * t;
+			b += (frames[RGB2_ENTRIES + COLOR_B] - b) * t;
+			r2 += (frames[RGB2_ENTRIES + COLOR2_R2] - r2) * t;
+			g2 += (frames[RGB2_ENTRIES + COLOR2_G2] - g2) * t;
+			b2 += (frames[RGB2_ENTRIES + COLOR2_B2] - b2) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			r = frames[i + COLOR_R];
-			g = frames[i + COLOR_G];
-			b = frames[i + COLOR_B];
-			r2 = frames[i + COLOR2_R2];
-			g2 = frames[i + COLOR2_G2];
-			b2 = frames[i + COLOR2_B2];
+			r = frames[COLOR_R];
+			g = frames[COLOR_G];
+			b = frames[COLOR_B];
+			r2 = frames[COLOR2_R2];
+			g2 = frames[COLOR2_G2];
+			b2 = frames[COLOR2_B2];
 			break;
 		}
 		default: {
-			r = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_R, curveType - CURVE_BEZIER);
-			g = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_G,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
-			b = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR_B,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
-			r2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR2_R2,
-												 curveType + BEZIER_SIZE * 3 - CURVE_BEZIER);
-			g2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR2_G2,
-												 curveType + BEZIER_SIZE * 4 - CURVE_BEZIER);
-			b2 = _spCurveTimeline_getBezierValue(SUPER(self), time, i, COLOR2_B2,
-												 curveType + BEZIER_SIZE * 5 - CURVE_BEZIER);
+			float values[6];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, COLOR_R, curveType - CURVE_BEZIER, 6, values);
+			r = values[0];
+			g = values[1];
+			b = values[2];
+			r2 = values[3];
+			g2 = values[4];
+			b2 = values[5];
 		}
 	}
 
@@ -1524,15 +2309,15 @@ void spRGB2Timeline_setFrame(spRGB2Timeline *self, int frame, float time, float
 
 /**/
 
-static void
-_spSetAttachment(spAttachmentTimeline *timeline, spSkeleton *skeleton, spSlot *slot, const char *attachmentName) {
-	spSlot_setAttachment(slot, attachmentName == NULL ? NULL : spSkeleton_getAttachmentForSlotIndex(skeleton, timeline->slotIndex, attachmentName));
+static void _spSetAttachment(spAttachmentTimeline *timeline, spSkeleton *skeleton, spSlot *slot, int frame) {
+	spSlot_setAttachment(slot, _spSkeleton_getAttachmentForKey(skeleton, timeline->slotIndex,
+															   timeline->attachmentKeys ? timeline->attachmentKeys[frame] : -1,
+															   timeline->attachmentNames[frame]));
 }
 
 void _spAttachmentTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float lastTime, float time,
 								 spEvent **firedEvents, int *eventsCount, float alpha, spMixBlend blend,
 								 spMixDirection direction) {
-	const char *attachmentName;
 	spAttachmentTimeline *self = (spAttachmentTimeline *) timeline;
 	float *frames = self->super.frames->items;
 	spSlot *slot = skeleton->slots[self->slotIndex];
@@ -1540,26 +2325,25 @@ void _spAttachmentTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, flo
 
 	if (direction == SP_MIX_DIRECTION_OUT) {
 		if (blend == SP_MIX_BLEND_SETUP) {
-			_spSetAttachment(self, skeleton, slot, slot->data->attachmentName);
+			spSlot_setAttachment(slot, _spSkeleton_getSetupAttachment(skeleton, slot->data));
 		}
 		return;
 	}
 
 	if (time < frames[0]) {
 		if (blend == SP_MIX_BLEND_SETUP || blend == SP_MIX_BLEND_FIRST) {
-			_spSetAttachment(self, skeleton, slot, slot->data->attachmentName);
+			spSlot_setAttachment(slot, _spSkeleton_getSetupAttachment(skeleton, slot->data));
 		}
 		return;
 	}
 
 	if (time < frames[0]) {
 		if (blend == SP_MIX_BLEND_SETUP || blend == SP_MIX_BLEND_FIRST)
-			_spSetAttachment(self, skeleton, slot, slot->data->attachmentName);
+			spSlot_setAttachment(slot, _spSkeleton_getSetupAttachment(skeleton, slot->data));
 		return;
 	}
 
-	attachmentName = self->attachmentNames[search(self->super.frames, time)];
-	_spSetAttachment(self, skeleton, slot, attachmentName);
+	_spSetAttachment(self, skeleton, slot, search(self->super.frames, time, CURSOR(skeleton)));
 
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -1573,6 +2357,7 @@ void _spAttachmentTimeline_dispose(spTimeline *timeline) {
 	for (i = 0; i < self->super.frames->size; ++i)
 		FREE(self->attachmentNames[i]);
 	FREE(self->attachmentNames);
+	FREE(self->attachmentKeys);
 }
 
 spAttachmentTimeline *spAttachmentTimeline_create(int framesCount, int slotIndex) {
@@ -1594,6 +2379,7 @@ void spAttachmentTimeline_setFrame(spAttachmentTimeline *self, int frame, float
 		MALLOC_STR(self->attachmentNames[frame], attachmentName);
 	else
 		self->attachmentNames[frame] = 0;
+	if (self->attachmentKeys) self->attachmentKeys[frame] = -1;
 }
 
 /**/
@@ -1643,6 +2429,10 @@ float _spDeformTimeline_getCurvePercent(spDeformTimeline *self, float time, int
 		}
 	}
 	i -= CURVE_BEZIER;
+	if (self->super.quantizedCurves)
+		return _spCurveTimeline_getQuantizedValue(SUPER(self), time, frames[frame], 0, frames[frame + frameEntries], 1, i);
+	if (self->super.bezierEvaluation != SP_BEZIER_SAMPLED)
+		return _spCurveTimeline_evaluateBezier(SUPER(self), time, frames[frame], 0, frames[frame + frameEntries], 1, i);
 	if (curves[i] > time) {
 		x = frames[frame];
 		return curves[i + 1] * (time - x) / (curves[i] - x);
@@ -1658,17 +2448,126 @@ float _spDeformTimeline_getCurvePercent(spDeformTimeline *self, float time, int
 	return y + (1 - y) * (time - x) / (frames[frame + frameEntries] - x);
 }
 
+typedef enum {
+	DEFORM_SET, /* deform = vertices */
+	DEFORM_MIX, /* deform += (vertices - deform) * alpha */
+	DEFORM_SETUP, /* deform = setup + (vertices - setup) * alpha, or vertices * alpha if weighted */
+	DEFORM_ADD /* deform += (vertices - setup) * alpha, or vertices * alpha if weighted */
+} _spDeformBlend;
+
+/* Blends the vertices between prev and next at the percent into the deform, 4 at a time when SSE is available. Weighted
+ * attachments have no setup vertices, their deform is an offset from 0. Prev and next may also be 0 for vertices at 0. */
+static void _spDeformTimeline_blend(float *deform, const float *prev, const float *next, float percent,
+									const float *setup, float alpha, _spDeformBlend mode, int count) {
+	int i = 0;
+#ifdef ANIMATION_SSE
+	__m128 p = _mm_set1_ps(percent), a = _mm_set1_ps(alpha), zero = _mm_setzero_ps();
+#define DEFORM_LOOP(BLEND) \
+	for (; i + 4 <= count; i += 4) { \
+		__m128 from = prev ? _mm_loadu_ps(prev + i) : zero, to = next ? _mm_loadu_ps(next + i) : zero; \
+		__m128 vertices = _mm_add_ps(from, _mm_mul_ps(_mm_sub_ps(to, from), p)); \
+		_mm_storeu_ps(deform + i, BLEND); \
+	}
+#define DEFORM_D _mm_loadu_ps(deform + i)
+#define DEFORM_S (setup ? _mm_loadu_ps(setup + i) : zero)
+	/* The mode is tested once per call so each loop stays branch free. */
+	switch (mode) {
+		case DEFORM_SET:
+			DEFORM_LOOP(vertices)
+			break;
+		case DEFORM_MIX:
+			DEFORM_LOOP(_mm_add_ps(DEFORM_D, _mm_mul_ps(_mm_sub_ps(vertices, DEFORM_D), a)))
+			break;
+		case DEFORM_SETUP:
+			DEFORM_LOOP(_mm_add_ps(DEFORM_S, _mm_mul_ps(_mm_sub_ps(vertices, DEFORM_S), a)))
+			break;
+		case DEFORM_ADD:
+			DEFORM_LOOP(_mm_add_ps(DEFORM_D, _mm_mul_ps(_mm_sub_ps(vertices, DEFORM_S), a)))
+	}
+#undef DEFORM_LOOP
+#undef DEFORM_D
+#undef DEFORM_S
+#endif
+	for (; i < count; i++) {
+		float from = prev ? prev[i] : 0, s = setup ? setup[i] : 0;
+		float vertices = from + ((next ? next[i] : 0) - from) * percent;
+		switch (mode) {
+			case DEFORM_SET:
+				deform[i] = vertices;
+				break;
+			case DEFORM_MIX:
+				deform[i] += (vertices - deform[i]) * alpha;
+				break;
+			case DEFORM_SETUP:
+				deform[i] = s + (vertices - s) * alpha;
+				break;
+			case DEFORM_ADD:
+				deform[i] += (vertices - s) * alpha;
+		}
+	}
+}
+
+/* Blends the vertices between two frames, only computing those either frame stores when the frames are sparse. */
+static void _spDeformTimeline_blendFrames(spDeformTimeline *self, float *deform, int prevFrame, int nextFrame,
+										  float percent, const float *setup, float alpha, _spDeformBlend mode) {
+	int count = self->frameVerticesCount, bounds[6], i, ii;
+	const float *prev = self->frameVertices[prevFrame], *next = self->frameVertices[nextFrame];
+	int prevStart, prevEnd, nextStart, nextEnd;
+	if (!self->frameRanges) {
+		_spDeformTimeline_blend(deform, prev, next, percent, setup, alpha, mode, count);
+		return;
+	}
+	bounds[0] = 0;
+	bounds[1] = prevStart = self->frameRanges[prevFrame << 1];
+	bounds[2] = prevEnd = self->frameRanges[(prevFrame << 1) + 1];
+	bounds[3] = nextStart = self->frameRanges[nextFrame << 1];
+	bounds[4] = nextEnd = self->frameRanges[(nextFrame << 1) + 1];
+	bounds[5] = count;
+	for (i = 1; i < 5; i++) {
+		int value = bounds[i];
+		for (ii = i; ii > 0 && bounds[ii - 1] > value; ii--)
+			bounds[ii] = bounds[ii - 1];
+		bounds[ii] = value;
+	}
+	/* No frame range crosses a bound, so each part is inside or outside each frame's range. */
+	for (i = 0; i < 5; i++) {
+		int start = bounds[i], end = bounds[i + 1];
+		const float *base = setup ? setup + start : 0, *from = base, *to = base;
+		if (start == end) continue;
+		if (start >= prevStart && end <= prevEnd) from = prev + start - prevStart;
+		if (start >= nextStart && end <= nextEnd) to = next + start - nextStart;
+		if (from == base && to == base) {
+			/* Both frames are at the setup pose. */
+			switch (mode) {
+				case DEFORM_SET:
+				case DEFORM_SETUP:
+					if (setup)
+						memcpy(deform + start, base, sizeof(float) * (end - start));
+					else
+						memset(deform + start, 0, sizeof(float) * (end - start));
+					break;
+				case DEFORM_MIX:
+					_spDeformTimeline_blend(deform + start, base, base, 0, 0, alpha, mode, end - start);
+					break;
+				case DEFORM_ADD:
+					break;
+			}
+			continue;
+		}
+		_spDeformTimeline_blend(deform + start, from, to, percent, base, alpha, mode, end - start);
+	}
+}
+
 void _spDeformTimeline_apply(
 		spTimeline *timeline, spSkeleton *skeleton, float lastTime, float time, spEvent **firedEvents,
 		int *eventsCount, float alpha, spMixBlend blend, spMixDirection direction) {
-	int frame, i, vertexCount;
+	int frame, nextFrame, i, vertexCount;
 	float percent;
-	const float *prevVertices;
-	const float *nextVertices;
+	const float *setupVertices;
 	float *frames;
 	int framesCount;
-	float **frameVertices;
 	float *deformArray;
+	spVertexAttachment *vertexAttachment;
 	spDeformTimeline *self = (spDeformTimeline *) timeline;
 
 	spSlot *slot = skeleton->slots[self->slotIndex];
@@ -1680,31 +2579,30 @@ void _spDeformTimeline_apply(
 		case SP_ATTACHMENT_CLIPPING:
 		case SP_ATTACHMENT_MESH:
 		case SP_ATTACHMENT_PATH: {
-			spVertexAttachment *vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
+			vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
 			if (vertexAttachment->timelineAttachment != self->attachment) return;
 			break;
 		}
 		default:
 			return;
 	}
+	setupVertices = vertexAttachment->bones ? 0 : vertexAttachment->vertices;
 
 	frames = self->super.super.frames->items;
 	framesCount = self->super.super.frames->size;
 	vertexCount = self->frameVerticesCount;
-	if (slot->deformCount < vertexCount) {
-		if (slot->deformCapacity < vertexCount) {
-			FREE(slot->deform);
-			slot->deform = MALLOC(float, vertexCount);
-			slot->deformCapacity = vertexCount;
-		}
+	if (slot->deformCapacity < vertexCount) {
+		/* Only if the slot data's deformCapacity is out of date. */
+		FREE(slot->deform);
+		slot->deform = MALLOC(float, vertexCount);
+		slot->deformCapacity = vertexCount;
+		slot->deformCount = 0;
 	}
 	if (slot->deformCount == 0) blend = SP_MIX_BLEND_SETUP;
 
-	frameVertices = self->frameVertices;
 	deformArray = slot->deform;
 
 	if (time < frames[0]) { /* Time is before first frame. */
-		spVertexAttachment *vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				slot->deformCount = 0;
@@ -1715,8 +2613,7 @@ void _spDeformTimeline_apply(
 					return;
 				}
 				slot->deformCount = vertexCount;
-				if (!vertexAttachment->bones) {
-					float *setupVertices = vertexAttachment->vertices;
+				if (setupVertices) {
 					for (i = 0; i < vertexCount; i++) {
 						deformArray[i] += (setupVertices[i] - deformArray[i]) * alpha;
 					}
@@ -1734,132 +2631,37 @@ void _spDeformTimeline_apply(
 
 	slot->deformCount = vertexCount;
 	if (time >= frames[framesCount - 1]) { /* Time is after last frame. */
-		const float *lastVertices = self->frameVertices[framesCount - 1];
-		if (alpha == 1) {
-			if (blend == SP_MIX_BLEND_ADD) {
-				spVertexAttachment *vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
-				if (!vertexAttachment->bones) {
-					/* Unweighted vertex positions, with alpha. */
-					float *setupVertices = vertexAttachment->vertices;
-					for (i = 0; i < vertexCount; i++) {
-						deformArray[i] += lastVertices[i] - setupVertices[i];
-					}
-				} else {
-					/* Weighted deform offsets, with alpha. */
-					for (i = 0; i < vertexCount; i++)
-						deformArray[i] += lastVertices[i];
-				}
-			} else {
-				/* Vertex positions or deform offsets, no alpha. */
-				memcpy(deformArray, lastVertices, vertexCount * sizeof(float));
-			}
-		} else {
-			spVertexAttachment *vertexAttachment;
-			switch (blend) {
-				case SP_MIX_BLEND_SETUP:
-					vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
-					if (!vertexAttachment->bones) {
-						/* Unweighted vertex positions, with alpha. */
-						float *setupVertices = vertexAttachment->vertices;
-						for (i = 0; i < vertexCount; i++) {
-							float setup = setupVertices[i];
-							deformArray[i] = setup + (lastVertices[i] - setup) * alpha;
-						}
-					} else {
-						/* Weighted deform offsets, with alpha. */
-						for (i = 0; i < vertexCount; i++)
-							deformArray[i] = lastVertices[i] * alpha;
-					}
-					break;
-				case SP_MIX_BLEND_FIRST:
-				case SP_MIX_BLEND_REPLACE:
-					/* Vertex positions or deform offsets, with alpha. */
-					for (i = 0; i < vertexCount; i++)
-						deformArray[i] += (lastVertices[i] - deformArray[i]) * alpha;
-					break;
-				case SP_MIX_BLEND_ADD:
-					vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
-					if (!vertexAttachment->bones) {
-						/* Unweighted vertex positions, with alpha. */
-						float *setupVertices = vertexAttachment->vertices;
-						for (i = 0; i < vertexCount; i++) {
-							deformArray[i] += (lastVertices[i] - setupVertices[i]) * alpha;
-						}
-					} else {
-						for (i = 0; i < vertexCount; i++)
-							deformArray[i] += lastVertices[i] * alpha;
-					}
-			}
-		}
-		return;
+		frame = nextFrame = framesCount - 1;
+		percent = 0;
+	} else {
+		/* Interpolate between the previous frame and the current frame. */
+		frame = search(self->super.super.frames, time, CURSOR(skeleton));
+		nextFrame = frame + 1;
+		percent = _spDeformTimeline_getCurvePercent(self, time, frame);
 	}
 
-	/* Interpolate between the previous frame and the current frame. */
-	frame = search(self->super.super.frames, time);
-	percent = _spDeformTimeline_getCurvePercent(self, time, frame);
-	prevVertices = frameVertices[frame];
-	nextVertices = frameVertices[frame + 1];
-
 	if (alpha == 1) {
-		if (blend == SP_MIX_BLEND_ADD) {
-			spVertexAttachment *vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
-			if (!vertexAttachment->bones) {
-				float *setupVertices = vertexAttachment->vertices;
-				for (i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deformArray[i] += prev + (nextVertices[i] - prev) * percent - setupVertices[i];
-				}
-			} else {
-				for (i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deformArray[i] += prev + (nextVertices[i] - prev) * percent;
-				}
-			}
-		} else {
-			for (i = 0; i < vertexCount; i++) {
-				float prev = prevVertices[i];
-				deformArray[i] = prev + (nextVertices[i] - prev) * percent;
-			}
-		}
+		if (blend == SP_MIX_BLEND_ADD)
+			_spDeformTimeline_blendFrames(self, deformArray, frame, nextFrame, percent, setupVertices, 1, DEFORM_ADD);
+		else if (frame == nextFrame && !self->frameRanges)
+			/* Vertex positions or deform offsets, no alpha. */
+			memcpy(deformArray, self->frameVertices[frame], vertexCount * sizeof(float));
+		else
+			_spDeformTimeline_blendFrames(self, deformArray, frame, nextFrame, percent, setupVertices, 1, DEFORM_SET);
 	} else {
-		spVertexAttachment *vertexAttachment;
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
-				vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
-				if (!vertexAttachment->bones) {
-					float *setupVertices = vertexAttachment->vertices;
-					for (i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i], setup = setupVertices[i];
-						deformArray[i] = setup + (prev + (nextVertices[i] - prev) * percent - setup) * alpha;
-					}
-				} else {
-					for (i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deformArray[i] = (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
+				_spDeformTimeline_blendFrames(self, deformArray, frame, nextFrame, percent, setupVertices, alpha,
+											  DEFORM_SETUP);
 				break;
 			case SP_MIX_BLEND_FIRST:
 			case SP_MIX_BLEND_REPLACE:
-				for (i = 0; i < vertexCount; i++) {
-					float prev = prevVertices[i];
-					deformArray[i] += (prev + (nextVertices[i] - prev) * percent - deformArray[i]) * alpha;
-				}
+				_spDeformTimeline_blendFrames(self, deformArray, frame, nextFrame, percent, setupVertices, alpha,
+											  DEFORM_MIX);
 				break;
 			case SP_MIX_BLEND_ADD:
-				vertexAttachment = SUB_CAST(spVertexAttachment, slot->attachment);
-				if (!vertexAttachment->bones) {
-					float *setupVertices = vertexAttachment->vertices;
-					for (i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deformArray[i] += (prev + (nextVertices[i] - prev) * percent - setupVertices[i]) * alpha;
-					}
-				} else {
-					for (i = 0; i < vertexCount; i++) {
-						float prev = prevVertices[i];
-						deformArray[i] += (prev + (nextVertices[i] - prev) * percent) * alpha;
-					}
-				}
+				_spDeformTimeline_blendFrames(self, deformArray, frame, nextFrame, percent, setupVertices, alpha,
+											  DEFORM_ADD);
 		}
 	}
 
@@ -1875,6 +2677,7 @@ void _spDeformTimeline_dispose(spTimeline *timeline) {
 	for (i = 0; i < self->super.super.frames->size; ++i)
 		FREE(self->frameVertices[i]);
 	FREE(self->frameVertices);
+	FREE(self->frameRanges);
 	_spCurveTimeline_dispose(timeline);
 }
 
@@ -1902,6 +2705,37 @@ void spDeformTimeline_setFrame(spDeformTimeline *self, int frame, float time, fl
 		self->frameVertices[frame] = MALLOC(float, self->frameVerticesCount);
 		memcpy(self->frameVertices[frame], vertices, self->frameVerticesCount * sizeof(float));
 	}
+	if (self->frameRanges) {
+		self->frameRanges[frame << 1] = 0;
+		self->frameRanges[(frame << 1) + 1] = vertices ? self->frameVerticesCount : 0;
+	}
+}
+
+void spDeformTimeline_setFrameRange(spDeformTimeline *self, int frame, float time, const float *vertices, int start,
+									int end) {
+	int i;
+	if (end - start >= self->frameVerticesCount / 2) {
+		spDeformTimeline_setFrame(self, frame, time, (float *) vertices);
+		return;
+	}
+	if (!self->frameRanges) {
+		/* Frames already set store all vertices. */
+		self->frameRanges = MALLOC(int, self->super.super.frames->size << 1);
+		for (i = 0; i < self->super.super.frames->size; ++i) {
+			self->frameRanges[i << 1] = 0;
+			self->frameRanges[(i << 1) + 1] = self->frameVertices[i] ? self->frameVerticesCount : 0;
+		}
+	}
+	self->super.super.frames->items[frame] = time;
+	FREE(self->frameVertices[frame]);
+	self->frameVertices[frame] = 0;
+	if (start < end) {
+		self->frameVertices[frame] = MALLOC(float, end - start);
+		memcpy(self->frameVertices[frame], vertices + start, (end - start) * sizeof(float));
+	} else
+		start = end = 0;
+	self->frameRanges[frame << 1] = start;
+	self->frameRanges[(frame << 1) + 1] = end;
 }
 
 /**/
@@ -1943,7 +2777,7 @@ void _spSequenceTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float
 		return;
 	}
 
-	i = search2(self->super.frames, time, SEQUENCE_ENTRIES);
+	i = search2(self->super.frames, time, SEQUENCE_ENTRIES, CURSOR(skeleton));
 	before = frames[i];
 	modeAndIndex = (int) frames[i + MODE];
 	delay = frames[i + DELAY];
@@ -2044,7 +2878,7 @@ void _spEventTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float la
 		i = 0;
 	else {
 		float frameTime;
-		i = search(self->super.frames, lastTime) + 1;
+		i = search(self->super.frames, lastTime, CURSOR(skeleton)) + 1;
 		frameTime = frames[i];
 		while (i > 0) { /* Fire multiple events with the same i. */
 			if (frames[i - 1] != frameTime) break;
@@ -2106,7 +2940,7 @@ void _spDrawOrderTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, floa
 		return;
 	}
 
-	drawOrderToSetupIndex = self->drawOrders[search(self->super.frames, time)];
+	drawOrderToSetupIndex = self->drawOrders[search(self->super.frames, time, CURSOR(skeleton))];
 	if (!drawOrderToSetupIndex)
 		memcpy(skeleton->drawOrder, skeleton->slots, self->slotsCount * sizeof(spSlot *));
 	else {
@@ -2172,7 +3006,7 @@ void _spInheritTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, float
 		if (blend == SP_MIX_BLEND_SETUP || blend == SP_MIX_BLEND_FIRST) bone->inherit = bone->data->inherit;
 		return;
 	}
-	int idx = search2(self->super.frames, time, 2) + 1;
+	int idx = search2(self->super.frames, time, 2, CURSOR(skeleton)) + 1;
 	bone->inherit = (spInherit) frames[idx];
 
 	UNUSED(lastTime);
@@ -2218,13 +3052,14 @@ void _spIkConstraintTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, f
 	float mix, softness, t;
 	spIkConstraint *constraint;
 	spIkConstraintTimeline *self = (spIkConstraintTimeline *) timeline;
-	float *frames = self->super.super.frames->items;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves = self->super.curves->items;
 
 	constraint = skeleton->ikConstraints[self->ikConstraintIndex];
 	if (!constraint->active) return;
 
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				constraint->mix = constraint->data->mix;
@@ -2245,27 +3080,29 @@ void _spIkConstraintTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, f
 		}
 	}
 
-	i = search2(self->super.super.frames, time, IKCONSTRAINT_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, IKCONSTRAINT_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i / IKCONSTRAINT_ENTRIES];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			mix = frames[i + IKCONSTRAINT_MIX];
-			softness = frames[i + IKCONSTRAINT_SOFTNESS];
-			t = (time - before) / (frames[i + IKCONSTRAINT_ENTRIES] - before);
-			mix += (frames[i + IKCONSTRAINT_ENTRIES + IKCONSTRAINT_MIX] - mix) * t;
-			softness += (frames[i + IKCONSTRAINT_ENTRIES + IKCONSTRAINT_SOFTNESS] - softness) * t;
+			float before = frames[0];
+			mix = frames[IKCONSTRAINT_MIX];
+			softness = frames[IKCONSTRAINT_SOFTNESS];
+			t = (time - before) / (frames[IKCONSTRAINT_ENTRIES] - before);
+			mix += (frames[IKCONSTRAINT_ENTRIES + IKCONSTRAINT_MIX] - mix) * t;
+			softness += (frames[IKCONSTRAINT_ENTRIES + IKCONSTRAINT_SOFTNESS] - softness) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			mix = frames[i + IKCONSTRAINT_MIX];
-			softness = frames[i + IKCONSTRAINT_SOFTNESS];
+			mix = frames[IKCONSTRAINT_MIX];
+			softness = frames[IKCONSTRAINT_SOFTNESS];
 			break;
 		}
 		default: {
-			mix = _spCurveTimeline_getBezierValue(SUPER(self), time, i, IKCONSTRAINT_MIX, curveType - CURVE_BEZIER);
-			softness = _spCurveTimeline_getBezierValue(SUPER(self), time, i, IKCONSTRAINT_SOFTNESS,
-													   curveType + BEZIER_SIZE - CURVE_BEZIER);
+			float values[2];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, IKCONSTRAINT_MIX, curveType - CURVE_BEZIER, 2, values);
+			mix = values[0];
+			softness = values[1];
 		}
 	}
 
@@ -2278,17 +3115,17 @@ void _spIkConstraintTimeline_apply(spTimeline *timeline, spSkeleton *skeleton, f
 			constraint->compress = constraint->data->compress;
 			constraint->stretch = constraint->data->stretch;
 		} else {
-			constraint->bendDirection = frames[i + IKCONSTRAINT_BEND_DIRECTION];
-			constraint->compress = frames[i + IKCONSTRAINT_COMPRESS] != 0;
-			constraint->stretch = frames[i + IKCONSTRAINT_STRETCH] != 0;
+			constraint->bendDirection = frames[IKCONSTRAINT_BEND_DIRECTION];
+			constraint->compress = frames[IKCONSTRAINT_COMPRESS] != 0;
+			constraint->stretch = frames[IKCONSTRAINT_STRETCH] != 0;
 		}
 	} else {
 		constraint->mix += (mix - constraint->mix) * alpha;
 		constraint->softness += (softness - constraint->softness) * alpha;
 		if (direction == SP_MIX_DIRECTION_IN) {
-			constraint->bendDirection = frames[i + IKCONSTRAINT_BEND_DIRECTION];
-			constraint->compress = frames[i + IKCONSTRAINT_COMPRESS] != 0;
-			constraint->stretch = frames[i + IKCONSTRAINT_STRETCH] != 0;
+			constraint->bendDirection = frames[IKCONSTRAINT_BEND_DIRECTION];
+			constraint->compress = frames[IKCONSTRAINT_COMPRESS] != 0;
+			constraint->stretch = frames[IKCONSTRAINT_STRETCH] != 0;
 		}
 	}
 
@@ -2336,18 +3173,18 @@ void _spTransformConstraintTimeline_apply(spTimeline *timeline, spSkeleton *skel
 	float rotate, x, y, scaleX, scaleY, shearY, t;
 	spTransformConstraint *constraint;
 	spTransformConstraintTimeline *self = (spTransformConstraintTimeline *) timeline;
-	float *frames;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves;
 	spTransformConstraintData *data;
 
 	constraint = skeleton->transformConstraints[self->transformConstraintIndex];
 	if (!constraint->active) return;
 
-	frames = self->super.super.frames->items;
 	curves = self->super.curves->items;
 
 	data = constraint->data;
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				constraint->mixRotate = data->mixRotate;
@@ -2370,48 +3207,45 @@ void _spTransformConstraintTimeline_apply(spTimeline *timeline, spSkeleton *skel
 		}
 	}
 
-	i = search2(self->super.super.frames, time, TRANSFORMCONSTRAINT_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, TRANSFORMCONSTRAINT_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i / TRANSFORMCONSTRAINT_ENTRIES];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			rotate = frames[i + TRANSFORMCONSTRAINT_ROTATE];
-			x = frames[i + TRANSFORMCONSTRAINT_X];
-			y = frames[i + TRANSFORMCONSTRAINT_Y];
-			scaleX = frames[i + TRANSFORMCONSTRAINT_SCALEX];
-			scaleY = frames[i + TRANSFORMCONSTRAINT_SCALEY];
-			shearY = frames[i + TRANSFORMCONSTRAINT_SHEARY];
-			t = (time - before) / (frames[i + TRANSFORMCONSTRAINT_ENTRIES] - before);
-			rotate += (frames[i + TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_ROTATE] - rotate) * t;
-			x += (frames[i + TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_X] - x) * t;
-			y += (frames[i + TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_Y] - y) * t;
-			scaleX += (frames[i + TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_SCALEX] - scaleX) * t;
-			scaleY += (frames[i + TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_SCALEY] - scaleY) * t;
-			shearY += (frames[i + TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_SHEARY] - shearY) * t;
+			float before = frames[0];
+			rotate = frames[TRANSFORMCONSTRAINT_ROTATE];
+			x = frames[TRANSFORMCONSTRAINT_X];
+			y = frames[TRANSFORMCONSTRAINT_Y];
+			scaleX = frames[TRANSFORMCONSTRAINT_SCALEX];
+			scaleY = frames[TRANSFORMCONSTRAINT_SCALEY];
+			shearY = frames[TRANSFORMCONSTRAINT_SHEARY];
+			t = (time - before) / (frames[TRANSFORMCONSTRAINT_ENTRIES] - before);
+			rotate += (frames[TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_ROTATE] - rotate) * t;
+			x += (frames[TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_X] - x) * t;
+			y += (frames[TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_Y] - y) * t;
+			scaleX += (frames[TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_SCALEX] - scaleX) * t;
+			scaleY += (frames[TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_SCALEY] - scaleY) * t;
+			shearY += (frames[TRANSFORMCONSTRAINT_ENTRIES + TRANSFORMCONSTRAINT_SHEARY] - shearY) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			rotate = frames[i + TRANSFORMCONSTRAINT_ROTATE];
-			x = frames[i + TRANSFORMCONSTRAINT_X];
-			y = frames[i + TRANSFORMCONSTRAINT_Y];
-			scaleX = frames[i + TRANSFORMCONSTRAINT_SCALEX];
-			scaleY = frames[i + TRANSFORMCONSTRAINT_SCALEY];
-			shearY = frames[i + TRANSFORMCONSTRAINT_SHEARY];
+			rotate = frames[TRANSFORMCONSTRAINT_ROTATE];
+			x = frames[TRANSFORMCONSTRAINT_X];
+			y = frames[TRANSFORMCONSTRAINT_Y];
+			scaleX = frames[TRANSFORMCONSTRAINT_SCALEX];
+			scaleY = frames[TRANSFORMCONSTRAINT_SCALEY];
+			shearY = frames[TRANSFORMCONSTRAINT_SHEARY];
 			break;
 		}
 		default: {
-			rotate = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_ROTATE,
-													 curveType - CURVE_BEZIER);
-			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_X,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
-			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_Y,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
-			scaleX = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_SCALEX,
-													 curveType + BEZIER_SIZE * 3 - CURVE_BEZIER);
-			scaleY = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_SCALEY,
-													 curveType + BEZIER_SIZE * 4 - CURVE_BEZIER);
-			shearY = _spCurveTimeline_getBezierValue(SUPER(self), time, i, TRANSFORMCONSTRAINT_SHEARY,
-													 curveType + BEZIER_SIZE * 5 - CURVE_BEZIER);
+			float values[6];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, TRANSFORMCONSTRAINT_ROTATE, curveType - CURVE_BEZIER, 6, values);
+			rotate = values[0];
+			x = values[1];
+			y = values[2];
+			scaleX = values[3];
+			scaleY = values[4];
+			shearY = values[5];
 		}
 	}
 
@@ -2471,7 +3305,7 @@ void _spPathConstraintPositionTimeline_apply(spTimeline *timeline, spSkeleton *s
 											 spMixDirection direction) {
 	spPathConstraintPositionTimeline *self = (spPathConstraintPositionTimeline *) timeline;
 	spPathConstraint *constraint = skeleton->pathConstraints[self->pathConstraintIndex];
-	if (constraint->active) constraint->position = spCurveTimeline1_getAbsoluteValue(SUPER(self), time, alpha, blend, constraint->position, constraint->data->position);
+	if (constraint->active) constraint->position = _spCurveTimeline1_getAbsoluteValue(SUPER(self), time, alpha, blend, constraint->position, constraint->data->position, CURSOR(skeleton));
 
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -2507,7 +3341,7 @@ void _spPathConstraintSpacingTimeline_apply(spTimeline *timeline, spSkeleton *sk
 											spMixDirection direction) {
 	spPathConstraintSpacingTimeline *self = (spPathConstraintSpacingTimeline *) timeline;
 	spPathConstraint *constraint = skeleton->pathConstraints[self->pathConstraintIndex];
-	if (constraint->active) constraint->spacing = spCurveTimeline1_getAbsoluteValue(SUPER(self), time, alpha, blend, constraint->spacing, constraint->data->spacing);
+	if (constraint->active) constraint->spacing = _spCurveTimeline1_getAbsoluteValue(SUPER(self), time, alpha, blend, constraint->spacing, constraint->data->spacing, CURSOR(skeleton));
 
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -2548,16 +3382,16 @@ void _spPathConstraintMixTimeline_apply(spTimeline *timeline, spSkeleton *skelet
 	float rotate, x, y, t;
 	spPathConstraint *constraint;
 	spPathConstraintMixTimeline *self = (spPathConstraintMixTimeline *) timeline;
-	float *frames;
+	const float *frames;
+	float window[FRAME_WINDOW];
 	float *curves;
 
 	constraint = skeleton->pathConstraints[self->pathConstraintIndex];
 	if (!constraint->active) return;
 
-	frames = self->super.super.frames->items;
 	curves = self->super.curves->items;
 
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(self))) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				constraint->mixRotate = constraint->data->mixRotate;
@@ -2574,33 +3408,33 @@ void _spPathConstraintMixTimeline_apply(spTimeline *timeline, spSkeleton *skelet
 		return;
 	}
 
-	i = search2(self->super.super.frames, time, PATHCONSTRAINTMIX_ENTRIES);
+	i = _spCurveTimeline_search(SUPER(self), time, PATHCONSTRAINTMIX_ENTRIES, CURSOR(skeleton));
 	curveType = (int) curves[i >> 2];
+	frames = _spCurveTimeline_getFrames(SUPER(self), i, window);
 	switch (curveType) {
 		case CURVE_LINEAR: {
-			float before = frames[i];
-			rotate = frames[i + PATHCONSTRAINTMIX_ROTATE];
-			x = frames[i + PATHCONSTRAINTMIX_X];
-			y = frames[i + PATHCONSTRAINTMIX_Y];
-			t = (time - before) / (frames[i + PATHCONSTRAINTMIX_ENTRIES] - before);
-			rotate += (frames[i + PATHCONSTRAINTMIX_ENTRIES + PATHCONSTRAINTMIX_ROTATE] - rotate) * t;
-			x += (frames[i + PATHCONSTRAINTMIX_ENTRIES + PATHCONSTRAINTMIX_X] - x) * t;
-			y += (frames[i + PATHCONSTRAINTMIX_ENTRIES + PATHCONSTRAINTMIX_Y] - y) * t;
+			float before = frames[0];
+			rotate = frames[PATHCONSTRAINTMIX_ROTATE];
+			x = frames[PATHCONSTRAINTMIX_X];
+			y = frames[PATHCONSTRAINTMIX_Y];
+			t = (time - before) / (frames[PATHCONSTRAINTMIX_ENTRIES] - before);
+			rotate += (frames[PATHCONSTRAINTMIX_ENTRIES + PATHCONSTRAINTMIX_ROTATE] - rotate) * t;
+			x += (frames[PATHCONSTRAINTMIX_ENTRIES + PATHCONSTRAINTMIX_X] - x) * t;
+			y += (frames[PATHCONSTRAINTMIX_ENTRIES + PATHCONSTRAINTMIX_Y] - y) * t;
 			break;
 		}
 		case CURVE_STEPPED: {
-			rotate = frames[i + PATHCONSTRAINTMIX_ROTATE];
-			x = frames[i + PATHCONSTRAINTMIX_X];
-			y = frames[i + PATHCONSTRAINTMIX_Y];
+			rotate = frames[PATHCONSTRAINTMIX_ROTATE];
+			x = frames[PATHCONSTRAINTMIX_X];
+			y = frames[PATHCONSTRAINTMIX_Y];
 			break;
 		}
 		default: {
-			rotate = _spCurveTimeline_getBezierValue(SUPER(self), time, i, PATHCONSTRAINTMIX_ROTATE,
-													 curveType - CURVE_BEZIER);
-			x = _spCurveTimeline_getBezierValue(SUPER(self), time, i, PATHCONSTRAINTMIX_X,
-												curveType + BEZIER_SIZE - CURVE_BEZIER);
-			y = _spCurveTimeline_getBezierValue(SUPER(self), time, i, PATHCONSTRAINTMIX_Y,
-												curveType + BEZIER_SIZE * 2 - CURVE_BEZIER);
+			float values[3];
+			_spCurveTimeline_getBezierValues(SUPER(self), time, frames, PATHCONSTRAINTMIX_ROTATE, curveType - CURVE_BEZIER, 3, values);
+			rotate = values[0];
+			x = values[1];
+			y = values[2];
 		}
 	}
 
@@ -2745,9 +3579,8 @@ void _spPhysicsConstraintTimeline_apply(spTimeline *timeline, spSkeleton *skelet
 										spMixDirection direction) {
 	spPhysicsConstraintTimeline *self = SUB_CAST(spPhysicsConstraintTimeline, timeline);
 	spTimelineType type = self->super.super.type;
-	float *frames = self->super.super.frames->items;
 	if (self->physicsConstraintIndex == -1) {
-		float value = time >= frames[0] ? spCurveTimeline1_getCurveValue(SUPER(self), time) : 0;
+		float value = time >= _spCurveTimeline_getStart(SUPER(self)) ? _spCurveTimeline1_getCurveValue(SUPER(self), time, CURSOR(skeleton)) : 0;
 
 		spPhysicsConstraint **physicsConstraints = skeleton->physicsConstraints;
 		for (int i = 0; i < skeleton->physicsConstraintsCount; i++) {
@@ -2757,7 +3590,7 @@ void _spPhysicsConstraintTimeline_apply(spTimeline *timeline, spSkeleton *skelet
 		}
 	} else {
 		spPhysicsConstraint *constraint = skeleton->physicsConstraints[self->physicsConstraintIndex];
-		if (constraint->active) _spPhysicsConstraintTimeline_set(constraint, type, spCurveTimeline1_getAbsoluteValue(SUPER(self), time, alpha, blend, _spPhysicsConstraintTimeline_get(constraint, type), _spPhysicsConstraintTimeline_setup(constraint, type)));
+		if (constraint->active) _spPhysicsConstraintTimeline_set(constraint, type, _spCurveTimeline1_getAbsoluteValue(SUPER(self), time, alpha, blend, _spPhysicsConstraintTimeline_get(constraint, type), _spPhysicsConstraintTimeline_setup(constraint, type), CURSOR(skeleton)));
 	}
 	UNUSED(lastTime);
 	UNUSED(firedEvents);
@@ -2826,7 +3659,7 @@ void _spPhysicsConstraintResetTimeline_apply(spTimeline *timeline, spSkeleton *s
 		return;
 	if (time < frames[0]) return;
 
-	if (lastTime < frames[0] || time >= frames[search(self->super.frames, lastTime) + 1]) {
+	if (lastTime < frames[0] || time >= frames[search(self->super.frames, lastTime, CURSOR(skeleton)) + 1]) {
 		if (constraint != NULL)
 			spPhysicsConstraint_reset(constraint);
 		else {
@@ -2865,3 +3698,85 @@ spPhysicsConstraintResetTimeline *spPhysicsConstraintResetTimeline_create(int fr
 void spPhysicsConstraintResetTimeline_setFrame(spPhysicsConstraintResetTimeline *self, int frame, float time) {
 	self->super.frames->items[frame] = time;
 }
+
+/**/
+
+#define APPLY_BATCH(FUNCTION) \
+	for (i = 0; i < count; ++i) { \
+		if (cursors) internal->timelineCursor = cursors + i; \
+		FUNCTION(timelines[i], skeleton, lastTime, time, firedEvents, eventsCount, alpha, blend, direction); \
+	} \
+	break;
+
+void _spTimeline_applyBatch(spTimeline **timelines, int *cursors, int count, spSkeleton *skeleton, float lastTime,
+							float time, spEvent **firedEvents, int *eventsCount, float alpha, spMixBlend blend,
+							spMixDirection direction) {
+	_spSkeleton *internal = SUB_CAST(_spSkeleton, skeleton);
+	int i;
+	switch (timelines[0]->type) {
+		case SP_TIMELINE_ATTACHMENT:
+			APPLY_BATCH(_spAttachmentTimeline_apply)
+		case SP_TIMELINE_ALPHA:
+			APPLY_BATCH(_spAlphaTimeline_apply)
+		case SP_TIMELINE_PATHCONSTRAINTPOSITION:
+			APPLY_BATCH(_spPathConstraintPositionTimeline_apply)
+		case SP_TIMELINE_PATHCONSTRAINTSPACING:
+			APPLY_BATCH(_spPathConstraintSpacingTimeline_apply)
+		case SP_TIMELINE_ROTATE:
+			APPLY_BATCH(_spRotateTimeline_apply)
+		case SP_TIMELINE_SCALEX:
+			APPLY_BATCH(_spScaleXTimeline_apply)
+		case SP_TIMELINE_SCALEY:
+			APPLY_BATCH(_spScaleYTimeline_apply)
+		case SP_TIMELINE_SHEARX:
+			APPLY_BATCH(_spShearXTimeline_apply)
+		case SP_TIMELINE_SHEARY:
+			APPLY_BATCH(_spShearYTimeline_apply)
+		case SP_TIMELINE_TRANSLATEX:
+			APPLY_BATCH(_spTranslateXTimeline_apply)
+		case SP_TIMELINE_TRANSLATEY:
+			APPLY_BATCH(_spTranslateYTimeline_apply)
+		case SP_TIMELINE_SCALE:
+			APPLY_BATCH(_spScaleTimeline_apply)
+		case SP_TIMELINE_SHEAR:
+			APPLY_BATCH(_spShearTimeline_apply)
+		case SP_TIMELINE_TRANSLATE:
+			APPLY_BATCH(_spTranslateTimeline_apply)
+		case SP_TIMELINE_DEFORM:
+			APPLY_BATCH(_spDeformTimeline_apply)
+		case SP_TIMELINE_SEQUENCE:
+			APPLY_BATCH(_spSequenceTimeline_apply)
+		case SP_TIMELINE_INHERIT:
+			APPLY_BATCH(_spInheritTimeline_apply)
+		case SP_TIMELINE_IKCONSTRAINT:
+			APPLY_BATCH(_spIkConstraintTimeline_apply)
+		case SP_TIMELINE_PATHCONSTRAINTMIX:
+			APPLY_BATCH(_spPathConstraintMixTimeline_apply)
+		case SP_TIMELINE_PHYSICSCONSTRAINT_INERTIA:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_STRENGTH:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_DAMPING:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_MASS:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_WIND:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_GRAVITY:
+		case SP_TIMELINE_PHYSICSCONSTRAINT_MIX:
+			APPLY_BATCH(_spPhysicsConstraintTimeline_apply)
+		case SP_TIMELINE_PHYSICSCONSTRAINT_RESET:
+			APPLY_BATCH(_spPhysicsConstraintResetTimeline_apply)
+		case SP_TIMELINE_RGB2:
+			APPLY_BATCH(_spRGB2Timeline_apply)
+		case SP_TIMELINE_RGBA2:
+			APPLY_BATCH(_spRGBA2Timeline_apply)
+		case SP_TIMELINE_RGBA:
+			APPLY_BATCH(_spRGBATimeline_apply)
+		case SP_TIMELINE_RGB:
+			APPLY_BATCH(_spRGBTimeline_apply)
+		case SP_TIMELINE_TRANSFORMCONSTRAINT:
+			APPLY_BATCH(_spTransformConstraintTimeline_apply)
+		case SP_TIMELINE_DRAWORDER:
+			APPLY_BATCH(_spDrawOrderTimeline_apply)
+		case SP_TIMELINE_EVENT:
+			APPLY_BATCH(_spEventTimeline_apply)
+		default:
+			APPLY_BATCH(spTimeline_apply)
+	}
+}
@@ -42,16 +42,13 @@
 
 _SP_ARRAY_IMPLEMENT_TYPE(spTrackEntryArray, spTrackEntry *)
 
-static spAnimation *SP_EMPTY_ANIMATION = 0;
-
 void spAnimationState_disposeStatics(void) {
-	if (SP_EMPTY_ANIMATION) spAnimation_dispose(SP_EMPTY_ANIMATION);
-	SP_EMPTY_ANIMATION = 0;
+	/* The empty animation is owned by each spAnimationStateData, so states can be created on several threads. */
 }
 
 /* Forward declaration of some "private" functions so we can keep
  the same function order in C as we have method order in Java. */
-void _spAnimationState_disposeTrackEntry(spTrackEntry *entry);
+void _spAnimationState_disposeTrackEntry(spAnimationState *self, spTrackEntry *entry);
 
 void _spAnimationState_disposeTrackEntries(spAnimationState *state, spTrackEntry *entry);
 
@@ -165,9 +162,62 @@ void _spEventQueue_clear(_spEventQueue *self) {
 	self->objectsCount = 0;
 }
 
+void _spAnimationState_addStreamEvent(_spAnimationState *self, spEventType type, spTrackEntry *entry, spEvent *event) {
+	spAnimationStateEvent *streamEvent;
+	if (self->streamCount == self->streamCapacity) {
+		self->streamCapacity = self->streamCapacity ? self->streamCapacity << 1 : 16;
+		self->stream = REALLOC(self->stream, spAnimationStateEvent, self->streamCapacity);
+	}
+	streamEvent = self->stream + self->streamCount++;
+	streamEvent->type = type;
+	streamEvent->trackIndex = entry->trackIndex;
+	streamEvent->entry = entry;
+	streamEvent->event = event;
+}
+
+void _spAnimationState_addDisposedEntry(_spAnimationState *self, spTrackEntry *entry) {
+	if (self->disposedEntriesCount == self->disposedEntriesCapacity) {
+		self->disposedEntriesCapacity = self->disposedEntriesCapacity ? self->disposedEntriesCapacity << 1 : 8;
+		self->disposedEntries = REALLOC(self->disposedEntries, spTrackEntry *, self->disposedEntriesCapacity);
+	}
+	self->disposedEntries[self->disposedEntriesCount++] = entry;
+}
+
+/* Moves the queued notifications to the state's stream. Disposed entries are freed by a later drain of the stream. */
+void _spEventQueue_stream(_spEventQueue *self) {
+	int i;
+	for (i = 0; i < self->objectsCount; i += 2) {
+		spEventType type = (spEventType) self->objects[i].type;
+		spTrackEntry *entry = self->objects[i + 1].entry;
+		switch (type) {
+			case SP_ANIMATION_START:
+			case SP_ANIMATION_INTERRUPT:
+			case SP_ANIMATION_COMPLETE:
+				_spAnimationState_addStreamEvent(self->state, type, entry, 0);
+				break;
+			case SP_ANIMATION_END:
+				_spAnimationState_addStreamEvent(self->state, type, entry, 0);
+				/* Fall through. */
+			case SP_ANIMATION_DISPOSE:
+				_spAnimationState_addStreamEvent(self->state, SP_ANIMATION_DISPOSE, entry, 0);
+				_spAnimationState_addDisposedEntry(self->state, entry);
+				break;
+			case SP_ANIMATION_EVENT:
+				_spAnimationState_addStreamEvent(self->state, type, entry, self->objects[i + 2].event);
+				i++;
+				break;
+		}
+	}
+	_spEventQueue_clear(self);
+}
+
 void _spEventQueue_drain(_spEventQueue *self) {
 	int i;
 	if (self->drainDisabled) return;
+	if (self->state->super.eventStream) {
+		_spEventQueue_stream(self);
+		return;
+	}
 	self->drainDisabled = 1;
 	for (i = 0; i < self->objectsCount; i += 2) {
 		spEventType type = (spEventType) self->objects[i].type;
@@ -188,7 +238,7 @@ void _spEventQueue_drain(_spEventQueue *self) {
 				if (entry->listener) entry->listener(SUPER(self->state), SP_ANIMATION_DISPOSE, entry, 0);
 				if (self->state->super.listener)
 					self->state->super.listener(SUPER(self->state), SP_ANIMATION_DISPOSE, entry, 0);
-				_spAnimationState_disposeTrackEntry(entry);
+				_spAnimationState_disposeTrackEntry(SUPER(self->state), entry);
 				break;
 			case SP_ANIMATION_EVENT:
 				event = self->objects[i + 2].event;
@@ -214,11 +264,20 @@ void _spAnimationState_disableQueue(spAnimationState *self) {
 	internal->queue->drainDisabled = 1;
 }
 
-void _spAnimationState_disposeTrackEntry(spTrackEntry *entry) {
+void _spTrackEntry_free(spTrackEntry *entry) {
 	spIntArray_dispose(entry->timelineMode);
 	spTrackEntryArray_dispose(entry->timelineHoldMix);
 	FREE(entry->timelinesRotation);
-	FREE(entry);
+	FREE(entry->timelineCursors);
+	FREE(SUB_CAST(_spTrackEntry, entry));
+}
+
+/* Puts the entry in the state's pool, linked through next, so a later track entry can reuse it and its arrays. */
+void _spAnimationState_disposeTrackEntry(spAnimationState *self, spTrackEntry *entry) {
+	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	entry->next = internal->trackEntryPool;
+	internal->trackEntryPool = entry;
+	internal->trackEntryPoolCount++;
 }
 
 void _spAnimationState_disposeTrackEntries(spAnimationState *state, spTrackEntry *entry) {
@@ -229,12 +288,12 @@ void _spAnimationState_disposeTrackEntries(spAnimationState *state, spTrackEntry
 			spTrackEntry *nextFrom = from->mixingFrom;
 			if (entry->listener) entry->listener(state, SP_ANIMATION_DISPOSE, from, 0);
 			if (state->listener) state->listener(state, SP_ANIMATION_DISPOSE, from, 0);
-			_spAnimationState_disposeTrackEntry(from);
+			_spAnimationState_disposeTrackEntry(state, from);
 			from = nextFrom;
 		}
 		if (entry->listener) entry->listener(state, SP_ANIMATION_DISPOSE, entry, 0);
 		if (state->listener) state->listener(state, SP_ANIMATION_DISPOSE, entry, 0);
-		_spAnimationState_disposeTrackEntry(entry);
+		_spAnimationState_disposeTrackEntry(state, entry);
 		entry = next;
 	}
 }
@@ -243,11 +302,6 @@ spAnimationState *spAnimationState_create(spAnimationStateData *data) {
 	_spAnimationState *internal;
 	spAnimationState *self;
 
-	if (!SP_EMPTY_ANIMATION) {
-		SP_EMPTY_ANIMATION = (spAnimation *) 1; /* dirty trick so we can recursively call spAnimation_create */
-		SP_EMPTY_ANIMATION = spAnimation_create("<empty>", NULL, 0);
-	}
-
 	internal = NEW(_spAnimationState);
 	self = SUPER(internal);
 
@@ -256,9 +310,12 @@ spAnimationState *spAnimationState_create(spAnimationStateData *data) {
 
 	internal->queue = _spEventQueue_create(internal);
 	internal->events = CALLOC(spEvent *, 128);
+	internal->eventsCapacity = 128;
 
 	internal->propertyIDs = CALLOC(spPropertyId, 128);
 	internal->propertyIDsCapacity = 128;
+	internal->propertyIDsSet = CALLOC(int, 256);
+	internal->propertyIDsSetMask = 255;
 
 	return self;
 }
@@ -271,7 +328,16 @@ void spAnimationState_dispose(spAnimationState *self) {
 	FREE(self->tracks);
 	_spEventQueue_free(internal->queue);
 	FREE(internal->events);
+	for (i = 0; i < internal->disposedEntriesCount; i++)
+		_spAnimationState_disposeTrackEntry(self, internal->disposedEntries[i]);
+	FREE(internal->disposedEntries);
+	FREE(internal->stream);
+	FREE(internal->drainedStream);
+	spAnimationState_trimTrackEntryPool(self, 0);
 	FREE(internal->propertyIDs);
+	FREE(internal->propertyIDsSet);
+	FREE(internal->holdKeys);
+	FREE(internal->holdEntries);
 	FREE(internal);
 }
 
@@ -369,8 +435,9 @@ int /*boolean*/ _spAnimationState_updateMixingFrom(spAnimationState *self, spTra
 
 int spAnimationState_apply(spAnimationState *self, spSkeleton *skeleton) {
 	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	_spSkeleton *internalSkeleton = SUB_CAST(_spSkeleton, skeleton);
 	spTrackEntry *current;
-	int i, ii, n;
+	int i, ii, n, count;
 	float animationLast, animationTime;
 	int timelineCount;
 	spTimeline **timelines;
@@ -383,7 +450,6 @@ int spAnimationState_apply(spAnimationState *self, spSkeleton *skeleton) {
 	int setupState = 0;
 	spSlot **slots = NULL;
 	spSlot *slot = NULL;
-	const char *attachmentName = NULL;
 	spEvent **applyEvents = NULL;
 	float applyTime;
 
@@ -416,13 +482,22 @@ int spAnimationState_apply(spAnimationState *self, spSkeleton *skeleton) {
 		}
 		timelines = current->animation->timelines->items;
 		if ((i == 0 && alpha == 1) || blend == SP_MIX_BLEND_ADD) {
-			for (ii = 0; ii < timelineCount; ii++) {
+			/* Timelines are grouped by type, apply each group in one batch. */
+			for (ii = 0; ii < timelineCount; ii += count) {
 				timeline = timelines[ii];
+				count = 1;
+				while (ii + count < timelineCount && timelines[ii + count]->type == timeline->type) count++;
 				if (timeline->type == SP_TIMELINE_ATTACHMENT) {
-					_spAnimationState_applyAttachmentTimeline(self, timeline, skeleton, applyTime, blend, attachments);
+					int iii;
+					for (iii = ii; iii < ii + count; iii++) {
+						internalSkeleton->timelineCursor = current->timelineCursors + iii;
+						_spAnimationState_applyAttachmentTimeline(self, timelines[iii], skeleton, applyTime, blend,
+																  attachments);
+					}
 				} else {
-					spTimeline_apply(timelines[ii], skeleton, animationLast, applyTime, applyEvents,
-									 &internal->eventsCount, alpha, blend, SP_MIX_DIRECTION_IN);
+					_spTimeline_applyBatch(timelines + ii, current->timelineCursors + ii, count, skeleton,
+										   animationLast, applyTime, applyEvents, &internal->eventsCount, alpha, blend,
+										   SP_MIX_DIRECTION_IN);
 				}
 			}
 		} else {
@@ -435,6 +510,7 @@ int spAnimationState_apply(spAnimationState *self, spSkeleton *skeleton) {
 
 			for (ii = 0; ii < timelineCount; ii++) {
 				timeline = timelines[ii];
+				internalSkeleton->timelineCursor = current->timelineCursors + ii;
 				timelineBlend = timelineMode->items[ii] == SUBSEQUENT ? blend : SP_MIX_BLEND_SETUP;
 				if (!shortestRotation && timeline->type == SP_TIMELINE_ROTATE)
 					_spAnimationState_applyRotateTimeline(self, timeline, skeleton, applyTime, alpha, timelineBlend,
@@ -442,10 +518,11 @@ int spAnimationState_apply(spAnimationState *self, spSkeleton *skeleton) {
 				else if (timeline->type == SP_TIMELINE_ATTACHMENT)
 					_spAnimationState_applyAttachmentTimeline(self, timeline, skeleton, applyTime, timelineBlend, attachments);
 				else
-					spTimeline_apply(timeline, skeleton, animationLast, applyTime, applyEvents, &internal->eventsCount,
-									 alpha, timelineBlend, SP_MIX_DIRECTION_IN);
+					_spTimeline_applyBatch(timelines + ii, 0, 1, skeleton, animationLast, applyTime, applyEvents,
+										   &internal->eventsCount, alpha, timelineBlend, SP_MIX_DIRECTION_IN);
 			}
 		}
+		internalSkeleton->timelineCursor = 0;
 		_spAnimationState_queueEvents(self, current, animationTime);
 		internal->eventsCount = 0;
 		current->nextAnimationLast = animationTime;
@@ -456,10 +533,8 @@ int spAnimationState_apply(spAnimationState *self, spSkeleton *skeleton) {
 	slots = skeleton->slots;
 	for (i = 0, n = skeleton->slotsCount; i < n; i++) {
 		slot = slots[i];
-		if (slot->attachmentState == setupState) {
-			attachmentName = slot->data->attachmentName;
-			spSlot_setAttachment(slot, attachmentName == NULL ? NULL : spSkeleton_getAttachmentForSlotIndex(skeleton, slot->data->index, attachmentName));
-		}
+		if (slot->attachmentState == setupState)
+			spSlot_setAttachment(slot, _spSkeleton_getSetupAttachment(skeleton, slot->data));
 	}
 	self->unkeyedState += 2;
 
@@ -469,6 +544,7 @@ int spAnimationState_apply(spAnimationState *self, spSkeleton *skeleton) {
 
 float _spAnimationState_applyMixingFrom(spAnimationState *self, spTrackEntry *to, spSkeleton *skeleton, spMixBlend blend) {
 	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	_spSkeleton *internalSkeleton = SUB_CAST(_spSkeleton, skeleton);
 	float mix;
 	spEvent **events;
 	int /*boolean*/ attachments;
@@ -518,10 +594,12 @@ float _spAnimationState_applyMixingFrom(spAnimationState *self, spTrackEntry *to
 	}
 
 	if (blend == SP_MIX_BLEND_ADD) {
-		for (i = 0; i < timelineCount; i++) {
-			spTimeline *timeline = timelines[i];
-			spTimeline_apply(timeline, skeleton, animationLast, applyTime, events, &internal->eventsCount, alphaMix,
-							 blend, SP_MIX_DIRECTION_OUT);
+		int count;
+		for (i = 0; i < timelineCount; i += count) {
+			count = 1;
+			while (i + count < timelineCount && timelines[i + count]->type == timelines[i]->type) count++;
+			_spTimeline_applyBatch(timelines + i, from->timelineCursors + i, count, skeleton, animationLast, applyTime,
+								   events, &internal->eventsCount, alphaMix, blend, SP_MIX_DIRECTION_OUT);
 		}
 	} else {
 		timelineMode = from->timelineMode;
@@ -536,6 +614,7 @@ float _spAnimationState_applyMixingFrom(spAnimationState *self, spTrackEntry *to
 		for (i = 0; i < timelineCount; i++) {
 			spMixDirection direction = SP_MIX_DIRECTION_OUT;
 			spTimeline *timeline = timelines[i];
+			internalSkeleton->timelineCursor = from->timelineCursors + i;
 
 			switch (timelineMode->items[i]) {
 				case SUBSEQUENT:
@@ -572,12 +651,12 @@ float _spAnimationState_applyMixingFrom(spAnimationState *self, spTrackEntry *to
 				if (drawOrder && timeline->type == SP_TIMELINE_DRAWORDER &&
 					timelineBlend == SP_MIX_BLEND_SETUP)
 					direction = SP_MIX_DIRECTION_IN;
-				spTimeline_apply(timeline, skeleton, animationLast, applyTime, events, &internal->eventsCount,
-								 alpha, timelineBlend, direction);
+				_spTimeline_applyBatch(timelines + i, 0, 1, skeleton, animationLast, applyTime, events,
+									   &internal->eventsCount, alpha, timelineBlend, direction);
 			}
 		}
 	}
-
+	internalSkeleton->timelineCursor = 0;
 
 	if (to->mixDuration > 0) _spAnimationState_queueEvents(self, from, animationTime);
 	internal->eventsCount = 0;
@@ -588,21 +667,11 @@ float _spAnimationState_applyMixingFrom(spAnimationState *self, spTrackEntry *to
 }
 
 static void
-_spAnimationState_setAttachment(spAnimationState *self, spSkeleton *skeleton, spSlot *slot, const char *attachmentName,
-								int /*bool*/ attachments) {
-	spSlot_setAttachment(slot, attachmentName == NULL ? NULL : spSkeleton_getAttachmentForSlotIndex(skeleton, slot->data->index, attachmentName));
+_spAnimationState_setAttachment(spAnimationState *self, spSlot *slot, spAttachment *attachment, int /*bool*/ attachments) {
+	spSlot_setAttachment(slot, attachment);
 	if (attachments) slot->attachmentState = self->unkeyedState + CURRENT;
 }
 
-/* @param target After the first and before the last entry. */
-static int binarySearch1(float *values, int valuesLength, float target) {
-	int i;
-	for (i = 1; i < valuesLength; i++) {
-		if (values[i] > target) return (int) (i - 1);
-	}
-	return (int) valuesLength - 1;
-}
-
 void _spAnimationState_applyAttachmentTimeline(spAnimationState *self, spTimeline *timeline, spSkeleton *skeleton,
 											   float time, spMixBlend blend, int /*bool*/ attachments) {
 	spAttachmentTimeline *attachmentTimeline;
@@ -616,9 +685,16 @@ void _spAnimationState_applyAttachmentTimeline(spAnimationState *self, spTimelin
 	frames = attachmentTimeline->super.frames->items;
 	if (time < frames[0]) {
 		if (blend == SP_MIX_BLEND_SETUP || blend == SP_MIX_BLEND_FIRST)
-			_spAnimationState_setAttachment(self, skeleton, slot, slot->data->attachmentName, attachments);
+			_spAnimationState_setAttachment(self, slot, _spSkeleton_getSetupAttachment(skeleton, slot->data), attachments);
 	} else {
-		_spAnimationState_setAttachment(self, skeleton, slot, attachmentTimeline->attachmentNames[binarySearch1(frames, attachmentTimeline->super.frames->size, time)],
+		int frame = _spTimeline_search(frames, attachmentTimeline->super.frames->size, time, 1,
+									   SUB_CAST(_spSkeleton, skeleton)->timelineCursor);
+		_spAnimationState_setAttachment(self, slot,
+										_spSkeleton_getAttachmentForKey(skeleton, attachmentTimeline->slotIndex,
+																		attachmentTimeline->attachmentKeys
+																				? attachmentTimeline->attachmentKeys[frame]
+																				: -1,
+																		attachmentTimeline->attachmentNames[frame]),
 										attachments);
 	}
 
@@ -630,7 +706,6 @@ void _spAnimationState_applyRotateTimeline(spAnimationState *self, spTimeline *t
 										   float alpha, spMixBlend blend, float *timelinesRotation, int i,
 										   int /*boolean*/ firstFrame) {
 	spRotateTimeline *rotateTimeline;
-	float *frames;
 	spBone *bone;
 	float r1, r2;
 	float total, diff;
@@ -645,10 +720,9 @@ void _spAnimationState_applyRotateTimeline(spAnimationState *self, spTimeline *t
 	}
 
 	rotateTimeline = SUB_CAST(spRotateTimeline, timeline);
-	frames = rotateTimeline->super.super.frames->items;
 	bone = skeleton->bones[rotateTimeline->boneIndex];
 	if (!bone->active) return;
-	if (time < frames[0]) {
+	if (time < _spCurveTimeline_getStart(SUPER(rotateTimeline))) {
 		switch (blend) {
 			case SP_MIX_BLEND_SETUP:
 				bone->rotation = bone->data->rotation;
@@ -660,7 +734,7 @@ void _spAnimationState_applyRotateTimeline(spAnimationState *self, spTimeline *t
 		}
 	} else {
 		r1 = blend == SP_MIX_BLEND_SETUP ? bone->data->rotation : bone->rotation;
-		r2 = bone->data->rotation + spCurveTimeline1_getCurveValue(&rotateTimeline->super, time);
+		r2 = bone->data->rotation + _spCurveTimeline1_getCurveValue(&rotateTimeline->super, time, SUB_CAST(_spSkeleton, skeleton)->timelineCursor);
 	}
 
 	/* Mix between rotations using the direction of the shortest route on the first frame while detecting crosses. */
@@ -735,6 +809,55 @@ void _spAnimationState_queueEvents(spAnimationState *self, spTrackEntry *entry,
 	}
 }
 
+void spAnimationState_tickInstances(spTickInstance *instances, int start, int end, float delta, spPhysics physics) {
+	int i;
+	for (i = start; i < end; i++) {
+		spTickInstance *instance = instances + i;
+		_spAnimationState_disableQueue(instance->state);
+		spAnimationState_update(instance->state, delta);
+		spAnimationState_apply(instance->state, instance->skeleton);
+		spSkeleton_update(instance->skeleton, delta);
+		spSkeleton_updateWorldTransform(instance->skeleton, physics);
+	}
+}
+
+void spAnimationState_deliverTickEvents(spTickInstance *instances, int count) {
+	int i;
+	for (i = 0; i < count; i++) {
+		_spAnimationState *internal = SUB_CAST(_spAnimationState, instances[i].state);
+		_spAnimationState_enableQueue(instances[i].state);
+		_spEventQueue_drain(internal->queue);
+	}
+}
+
+const spAnimationStateEvent *spAnimationState_drainEvents(spAnimationState *self, int *count) {
+	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	spAnimationStateEvent *stream;
+	int i, capacity;
+
+	/* Free the entries disposed in the last batch, now that the caller is done with it. */
+	for (i = 0; i < internal->drainedEntriesCount; i++)
+		_spAnimationState_disposeTrackEntry(self, internal->disposedEntries[i]);
+	internal->disposedEntriesCount -= internal->drainedEntriesCount;
+	for (i = 0; i < internal->disposedEntriesCount; i++)
+		internal->disposedEntries[i] = internal->disposedEntries[i + internal->drainedEntriesCount];
+
+	_spAnimationState_enableQueue(self);
+	_spEventQueue_drain(internal->queue);
+	internal->drainedEntriesCount = internal->disposedEntriesCount;
+
+	/* Hand out the filled buffer and fill the one handed out last time. */
+	stream = internal->stream;
+	capacity = internal->streamCapacity;
+	internal->stream = internal->drainedStream;
+	internal->streamCapacity = internal->drainedStreamCapacity;
+	internal->drainedStream = stream;
+	internal->drainedStreamCapacity = capacity;
+	*count = internal->streamCount;
+	internal->streamCount = 0;
+	return stream;
+}
+
 void spAnimationState_clearTracks(spAnimationState *self) {
 	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
 	int i, n, oldDrainDisabled;
@@ -863,7 +986,7 @@ spAnimationState_addAnimation(spAnimationState *self, int trackIndex, spAnimatio
 }
 
 spTrackEntry *spAnimationState_setEmptyAnimation(spAnimationState *self, int trackIndex, float mixDuration) {
-	spTrackEntry *entry = spAnimationState_setAnimation(self, trackIndex, SP_EMPTY_ANIMATION, 0);
+	spTrackEntry *entry = spAnimationState_setAnimation(self, trackIndex, self->data->emptyAnimation, 0);
 	entry->mixDuration = mixDuration;
 	entry->trackEnd = mixDuration;
 	return entry;
@@ -871,7 +994,7 @@ spTrackEntry *spAnimationState_setEmptyAnimation(spAnimationState *self, int tra
 
 spTrackEntry *
 spAnimationState_addEmptyAnimation(spAnimationState *self, int trackIndex, float mixDuration, float delay) {
-	spTrackEntry *entry = spAnimationState_addAnimation(self, trackIndex, SP_EMPTY_ANIMATION, 0, delay);
+	spTrackEntry *entry = spAnimationState_addAnimation(self, trackIndex, self->data->emptyAnimation, 0, delay);
 	if (delay <= 0) entry->delay += entry->mixDuration - mixDuration;
 	entry->mixDuration = mixDuration;
 	entry->trackEnd = mixDuration;
@@ -903,10 +1026,77 @@ spTrackEntry *_spAnimationState_expandToIndex(spAnimationState *self, int index)
 	return 0;
 }
 
+/* Grows the buffer the animation's event timelines fire into, so applying never writes past its end. */
+void _spAnimationState_ensureEventsCapacity(spAnimationState *self, spAnimation *animation) {
+	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	int i, capacity = 0;
+	for (i = 0; i < animation->timelines->size; i++) {
+		spTimeline *timeline = animation->timelines->items[i];
+		/* A looped apply can fire each key twice: after the last time, then again up to the wrapped time. */
+		if (timeline->type == SP_TIMELINE_EVENT) capacity += timeline->frameCount << 1;
+	}
+	if (capacity > internal->eventsCapacity) {
+		FREE(internal->events);
+		internal->events = CALLOC(spEvent *, capacity);
+		internal->eventsCapacity = capacity;
+	}
+}
+
+/* Takes an entry from the state's pool, keeping the capacity of its arrays, or allocates one. */
+spTrackEntry *_spAnimationState_obtainTrackEntry(spAnimationState *self, int timelinesCount) {
+	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	_spTrackEntry *entry;
+	spIntArray *timelineMode;
+	spTrackEntryArray *timelineHoldMix;
+	float *timelinesRotation;
+	int *timelineCursors;
+	int timelinesRotationCapacity, timelineCursorsCapacity;
+
+	if (!internal->trackEntryPool) {
+		entry = NEW(_spTrackEntry);
+		entry->super.timelineMode = spIntArray_create(16);
+		entry->super.timelineHoldMix = spTrackEntryArray_create(16);
+		entry->super.timelineCursors = CALLOC(int, timelinesCount);
+		entry->timelineCursorsCapacity = timelinesCount;
+		internal->trackEntriesCreated++;
+		return SUPER(entry);
+	}
+
+	entry = SUB_CAST(_spTrackEntry, internal->trackEntryPool);
+	internal->trackEntryPool = entry->super.next;
+	internal->trackEntryPoolCount--;
+	internal->trackEntriesReused++;
+
+	timelineMode = entry->super.timelineMode;
+	timelineHoldMix = entry->super.timelineHoldMix;
+	timelinesRotation = entry->super.timelinesRotation;
+	timelineCursors = entry->super.timelineCursors;
+	timelinesRotationCapacity = entry->timelinesRotationCapacity;
+	timelineCursorsCapacity = entry->timelineCursorsCapacity;
+	memset(entry, 0, sizeof(_spTrackEntry));
+
+	spIntArray_clear(timelineMode);
+	spTrackEntryArray_clear(timelineHoldMix);
+	if (timelineCursorsCapacity < timelinesCount) {
+		FREE(timelineCursors);
+		timelineCursors = MALLOC(int, timelinesCount);
+		timelineCursorsCapacity = timelinesCount;
+	}
+	memset(timelineCursors, 0, sizeof(int) * timelinesCount);
+	entry->super.timelineMode = timelineMode;
+	entry->super.timelineHoldMix = timelineHoldMix;
+	entry->super.timelinesRotation = timelinesRotation;
+	entry->super.timelineCursors = timelineCursors;
+	entry->timelinesRotationCapacity = timelinesRotationCapacity;
+	entry->timelineCursorsCapacity = timelineCursorsCapacity;
+	return SUPER(entry);
+}
+
 spTrackEntry *
 _spAnimationState_trackEntry(spAnimationState *self, int trackIndex, spAnimation *animation, int /*boolean*/ loop,
 							 spTrackEntry *last) {
-	spTrackEntry *entry = NEW(spTrackEntry);
+	spTrackEntry *entry = _spAnimationState_obtainTrackEntry(self, animation->timelines->size);
+	_spAnimationState_ensureEventsCapacity(self, animation);
 	entry->trackIndex = trackIndex;
 	entry->animation = animation;
 	entry->loop = loop;
@@ -940,8 +1130,6 @@ _spAnimationState_trackEntry(spAnimationState *self, int trackIndex, spAnimation
 	entry->totalAlpha = 0;
 	entry->mixBlend = SP_MIX_BLEND_REPLACE;
 
-	entry->timelineMode = spIntArray_create(16);
-	entry->timelineHoldMix = spTrackEntryArray_create(16);
 
 	return entry;
 }
@@ -956,33 +1144,130 @@ void spAnimationState_clearNext(spAnimationState *self, spTrackEntry *entry) {
 	entry->next = 0;
 }
 
-void _spAnimationState_animationsChanged(spAnimationState *self) {
+/* Lists the track entries in the order their timeline modes are computed, with the layout they are keyed by. */
+int _spAnimationState_collectHoldKeys(spAnimationState *self, unsigned int *hash) {
 	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
-	int i, n;
+	int i, n, count = 0;
 	spTrackEntry *entry;
-	internal->animationsChanged = 0;
-
-	internal->propertyIDsCount = 0;
-	i = 0;
-	n = self->tracksCount;
-
-	for (; i < n; i++) {
+	*hash = 0;
+	for (i = 0, n = self->tracksCount; i < n; i++) {
 		entry = self->tracks[i];
 		if (!entry) continue;
 		while (entry->mixingFrom != 0)
 			entry = entry->mixingFrom;
 		do {
-			if (entry->mixingTo == 0 || entry->mixBlend != SP_MIX_BLEND_ADD) _spTrackEntry_computeHold(entry, self);
+			_spHoldKey *key;
+			if (count == internal->holdKeysCapacity) {
+				internal->holdKeysCapacity = internal->holdKeysCapacity ? internal->holdKeysCapacity << 1 : 8;
+				internal->holdKeys = REALLOC(internal->holdKeys, _spHoldKey, internal->holdKeysCapacity);
+				internal->holdEntries = REALLOC(internal->holdEntries, spTrackEntry *, internal->holdKeysCapacity);
+			}
+			key = internal->holdKeys + count;
+			key->animation = entry->animation;
+			key->timelinesCount = entry->animation->timelines->size;
+			key->flags = (entry->mixingFrom == 0 ? SP_HOLD_KEY_TRACK : 0) |
+						 (entry->mixingTo == 0 || entry->mixBlend != SP_MIX_BLEND_ADD ? SP_HOLD_KEY_COMPUTED : 0) |
+						 (entry->holdPrevious ? SP_HOLD_KEY_HOLD_PREVIOUS : 0) |
+						 (entry->mixDuration > 0 ? SP_HOLD_KEY_MIXING : 0);
+			internal->holdEntries[count++] = entry;
+			*hash = ((*hash ^ (unsigned int) ((size_t) key->animation >> 3)) * 16777619u) ^ (unsigned int) key->flags;
 			entry = entry->mixingTo;
 		} while (entry != 0);
 	}
+	return count;
+}
+
+/* Sets the timeline modes of the track entries from modes computed for another state with the same layout. */
+void _spAnimationState_applyHoldLayout(spAnimationState *self, const _spHoldLayout *layout) {
+	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	const int *modes = layout->modes;
+	int i, ii, distance;
+	for (i = 0; i < layout->keysCount; i++) {
+		spTrackEntry *entry = internal->holdEntries[i];
+		int timelinesCount = layout->keys[i].timelinesCount;
+		int *timelineMode;
+		spTrackEntry **timelineHoldMix;
+		if (!(layout->keys[i].flags & SP_HOLD_KEY_COMPUTED)) continue;
+		timelineMode = spIntArray_setSize(entry->timelineMode, timelinesCount)->items;
+		timelineHoldMix = spTrackEntryArray_setSize(entry->timelineHoldMix, timelinesCount)->items;
+		for (ii = 0; ii < timelinesCount; ii++) {
+			spTrackEntry *holdMix = 0;
+			timelineMode[ii] = modes[ii] & 7;
+			distance = modes[ii] >> 3;
+			if (distance) {
+				for (holdMix = entry; distance > 0; distance--)
+					holdMix = holdMix->mixingTo;
+			}
+			timelineHoldMix[ii] = holdMix;
+		}
+		modes += timelinesCount;
+	}
+}
+
+/* Copies the timeline modes just computed into a layout for other states with the same track entries. */
+_spHoldLayout *_spAnimationState_createHoldLayout(spAnimationState *self, int keysCount, unsigned int hash) {
+	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	_spHoldLayout *layout;
+	int i, ii, modesCount = 0, *modes;
+	for (i = 0; i < keysCount; i++)
+		if (internal->holdKeys[i].flags & SP_HOLD_KEY_COMPUTED)
+			modesCount += internal->holdEntries[i]->animation->timelines->size;
+	layout = _spHoldLayout_create(internal->holdKeys, keysCount, hash, modesCount);
+	modes = layout->modes;
+	for (i = 0; i < keysCount; i++) {
+		spTrackEntry *entry = internal->holdEntries[i];
+		int timelinesCount = entry->animation->timelines->size;
+		if (!(internal->holdKeys[i].flags & SP_HOLD_KEY_COMPUTED)) continue;
+		for (ii = 0; ii < timelinesCount; ii++) {
+			int mode = entry->timelineMode->items[ii], distance = 0;
+			if (mode == HOLD_MIX) {
+				spTrackEntry *holdMix;
+				for (holdMix = entry; holdMix != entry->timelineHoldMix->items[ii]; holdMix = holdMix->mixingTo)
+					distance++;
+			}
+			*modes++ = mode | distance << 3;
+		}
+	}
+	return layout;
+}
+
+void _spAnimationState_animationsChanged(spAnimationState *self) {
+	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	int i, keysCount;
+	unsigned int hash;
+	const _spHoldLayout *layout;
+	internal->animationsChanged = 0;
+
+	/* States playing the same animations in the same layout share the timeline modes computed by the first one. */
+	keysCount = _spAnimationState_collectHoldKeys(self, &hash);
+	if (self->data) {
+		layout = _spAnimationStateData_findHoldLayout(self->data, internal->holdKeys, keysCount, hash);
+		if (layout) {
+			_spAnimationState_applyHoldLayout(self, layout);
+			return;
+		}
+	}
+
+	if (internal->propertyIDsCount) {
+		memset(internal->propertyIDsSet, 0, sizeof(int) * (internal->propertyIDsSetMask + 1));
+		internal->propertyIDsCount = 0;
+	}
+	for (i = 0; i < keysCount; i++)
+		if (internal->holdKeys[i].flags & SP_HOLD_KEY_COMPUTED) _spTrackEntry_computeHold(internal->holdEntries[i], self);
+
+	if (self->data && !_spAnimationStateData_isHoldCacheFull(self->data))
+		_spAnimationStateData_addHoldLayout(self->data, _spAnimationState_createHoldLayout(self, keysCount, hash));
 }
 
 float *_spAnimationState_resizeTimelinesRotation(spTrackEntry *entry, int newSize) {
+	_spTrackEntry *internal = SUB_CAST(_spTrackEntry, entry);
 	if (entry->timelinesRotationCount != newSize) {
-		float *newTimelinesRotation = CALLOC(float, newSize);
-		FREE(entry->timelinesRotation);
-		entry->timelinesRotation = newTimelinesRotation;
+		if (internal->timelinesRotationCapacity < newSize) {
+			FREE(entry->timelinesRotation);
+			entry->timelinesRotation = MALLOC(float, newSize);
+			internal->timelinesRotationCapacity = newSize;
+		}
+		memset(entry->timelinesRotation, 0, sizeof(float) * newSize);
 		entry->timelinesRotationCount = newSize;
 	}
 	return entry->timelinesRotation;
@@ -990,26 +1275,43 @@ float *_spAnimationState_resizeTimelinesRotation(spTrackEntry *entry, int newSiz
 
 void _spAnimationState_ensureCapacityPropertyIDs(spAnimationState *self, int capacity) {
 	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	int i, ii, size = 256;
 	if (internal->propertyIDsCapacity < capacity) {
 		spPropertyId *newPropertyIDs = CALLOC(spPropertyId, capacity << 1);
 		memcpy(newPropertyIDs, internal->propertyIDs, sizeof(spPropertyId) * internal->propertyIDsCount);
 		FREE(internal->propertyIDs);
 		internal->propertyIDs = newPropertyIDs;
 		internal->propertyIDsCapacity = capacity << 1;
+
+		/* Keep the set at most half full. */
+		while (size < internal->propertyIDsCapacity << 1) size <<= 1;
+		FREE(internal->propertyIDsSet);
+		internal->propertyIDsSet = CALLOC(int, size);
+		internal->propertyIDsSetMask = size - 1;
+		for (i = 0; i < internal->propertyIDsCount; i++) {
+			ii = _spPropertyId_hash(internal->propertyIDs[i]) & internal->propertyIDsSetMask;
+			while (internal->propertyIDsSet[ii]) ii = (ii + 1) & internal->propertyIDsSetMask;
+			internal->propertyIDsSet[ii] = i + 1;
+		}
 	}
 }
 
 int _spAnimationState_addPropertyID(spAnimationState *self, spPropertyId id) {
-	int i, n;
+	int i;
 	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
 
-	for (i = 0, n = internal->propertyIDsCount; i < n; i++) {
-		if (internal->propertyIDs[i] == id) return 0;
+	for (i = _spPropertyId_hash(id) & internal->propertyIDsSetMask; internal->propertyIDsSet[i];
+		 i = (i + 1) & internal->propertyIDsSetMask) {
+		if (internal->propertyIDs[internal->propertyIDsSet[i] - 1] == id) return 0;
 	}
 
-	_spAnimationState_ensureCapacityPropertyIDs(self, internal->propertyIDsCount + 1);
+	if (internal->propertyIDsCount + 1 > internal->propertyIDsCapacity) {
+		_spAnimationState_ensureCapacityPropertyIDs(self, internal->propertyIDsCount + 1);
+		i = _spPropertyId_hash(id) & internal->propertyIDsSetMask;
+		while (internal->propertyIDsSet[i]) i = (i + 1) & internal->propertyIDsSetMask;
+	}
 	internal->propertyIDs[internal->propertyIDsCount] = id;
-	internal->propertyIDsCount++;
+	internal->propertyIDsSet[i] = ++internal->propertyIDsCount;
 	return 1;
 }
 
@@ -1030,6 +1332,32 @@ spTrackEntry *spAnimationState_getCurrent(spAnimationState *self, int trackIndex
 	return self->tracks[trackIndex];
 }
 
+void spAnimationState_getTrackEntryPoolStats(spAnimationState *self, spTrackEntryPoolStats *stats) {
+	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	spTrackEntry *entry;
+	stats->freeCount = internal->trackEntryPoolCount;
+	stats->created = internal->trackEntriesCreated;
+	stats->reused = internal->trackEntriesReused;
+	stats->bytes = 0;
+	for (entry = internal->trackEntryPool; entry; entry = entry->next) {
+		_spTrackEntry *pooled = SUB_CAST(_spTrackEntry, entry);
+		stats->bytes += sizeof(_spTrackEntry) + sizeof(spIntArray) + sizeof(spTrackEntryArray);
+		stats->bytes += sizeof(int) * entry->timelineMode->capacity;
+		stats->bytes += sizeof(spTrackEntry *) * entry->timelineHoldMix->capacity;
+		stats->bytes += sizeof(float) * pooled->timelinesRotationCapacity + sizeof(int) * pooled->timelineCursorsCapacity;
+	}
+}
+
+void spAnimationState_trimTrackEntryPool(spAnimationState *self, int maxFree) {
+	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
+	while (internal->trackEntryPoolCount > maxFree) {
+		spTrackEntry *entry = internal->trackEntryPool;
+		internal->trackEntryPool = entry->next;
+		internal->trackEntryPoolCount--;
+		_spTrackEntry_free(entry);
+	}
+}
+
 void spAnimationState_clearListenerNotifications(spAnimationState *self) {
 	_spAnimationState *internal = SUB_CAST(_spAnimationState, self);
 	_spEventQueue_clear(internal->queue);
@@ -1045,8 +1373,6 @@ float spTrackEntry_getAnimationTime(spTrackEntry *entry) {
 }
 
 void spTrackEntry_resetRotationDirections(spTrackEntry *entry) {
-	FREE(entry->timelinesRotation);
-	entry->timelinesRotation = NULL;
 	entry->timelinesRotationCount = 0;
 }
 
@@ -69,9 +69,101 @@ void _FromEntry_dispose(_FromEntry *self) {
 
 /**/
 
+#define HOLD_CACHE_BUCKETS 256
+
+typedef struct _spHoldCache {
+	/* Layouts are only added, at the head of their bucket, so lookups need no lock. */
+	_spHoldLayout *volatile buckets[HOLD_CACHE_BUCKETS];
+	volatile long layoutsCount;
+	int maxLayouts;
+} _spHoldCache;
+
+_spHoldLayout *_spHoldLayout_create(const _spHoldKey *keys, int keysCount, unsigned int hash, int modesCount) {
+	/* The keys and modes follow the layout in the same allocation. */
+	_spHoldLayout *self = (_spHoldLayout *) MALLOC(char, sizeof(_spHoldLayout) + sizeof(_spHoldKey) * keysCount +
+																 sizeof(int) * modesCount);
+	self->next = 0;
+	self->hash = hash;
+	self->keysCount = keysCount;
+	self->keys = (_spHoldKey *) (self + 1);
+	self->modes = (int *) (self->keys + keysCount);
+	memcpy(self->keys, keys, sizeof(_spHoldKey) * keysCount);
+	return self;
+}
+
+const _spHoldLayout *
+_spAnimationStateData_findHoldLayout(spAnimationStateData *self, const _spHoldKey *keys, int keysCount, unsigned int hash) {
+	_spHoldCache *cache = (_spHoldCache *) self->holdCache;
+	const _spHoldLayout *layout;
+	int i;
+	if (!cache) return 0;
+	for (layout = cache->buckets[hash & (HOLD_CACHE_BUCKETS - 1)]; layout; layout = layout->next) {
+		if (layout->hash != hash || layout->keysCount != keysCount) continue;
+		for (i = 0; i < keysCount; i++)
+			if (layout->keys[i].animation != keys[i].animation || layout->keys[i].flags != keys[i].flags ||
+				layout->keys[i].timelinesCount != keys[i].timelinesCount)
+				break;
+		if (i == keysCount) return layout;
+	}
+	return 0;
+}
+
+int /*boolean*/ _spAnimationStateData_isHoldCacheFull(spAnimationStateData *self) {
+	_spHoldCache *cache = (_spHoldCache *) self->holdCache;
+	return !cache || cache->layoutsCount >= cache->maxLayouts;
+}
+
+void _spAnimationStateData_addHoldLayout(spAnimationStateData *self, _spHoldLayout *layout) {
+	_spHoldCache *cache = (_spHoldCache *) self->holdCache;
+	_spHoldLayout *volatile *bucket;
+	long count;
+	/* The count is only incremented while it is below the limit, so it stays the number of layouts stored. */
+	do {
+		count = cache ? cache->layoutsCount : 0;
+		if (!cache || count >= cache->maxLayouts) {
+			FREE(layout);
+			return;
+		}
+	} while (!_spCompareAndSwapCount(&cache->layoutsCount, count, count + 1));
+	/* Another state may add the same layout at the same time, the duplicate is harmless. */
+	bucket = cache->buckets + (layout->hash & (HOLD_CACHE_BUCKETS - 1));
+	do {
+		layout->next = *bucket;
+	} while (!_spCompareAndSwap((void *volatile *) bucket, layout->next, layout));
+}
+
+void spAnimationStateData_clearHoldCache(spAnimationStateData *self) {
+	_spHoldCache *cache = (_spHoldCache *) self->holdCache;
+	int i;
+	if (!cache) return;
+	for (i = 0; i < HOLD_CACHE_BUCKETS; i++) {
+		_spHoldLayout *layout = cache->buckets[i];
+		while (layout) {
+			_spHoldLayout *next = layout->next;
+			FREE(layout);
+			layout = next;
+		}
+		cache->buckets[i] = 0;
+	}
+	cache->layoutsCount = 0;
+}
+
+void spAnimationStateData_setHoldCacheSize(spAnimationStateData *self, int maxLayouts) {
+	spAnimationStateData_clearHoldCache(self);
+	if (maxLayouts <= 0) {
+		FREE(self->holdCache);
+		self->holdCache = 0;
+		return;
+	}
+	if (!self->holdCache) self->holdCache = NEW(_spHoldCache);
+	((_spHoldCache *) self->holdCache)->maxLayouts = maxLayouts;
+}
+
 spAnimationStateData *spAnimationStateData_create(spSkeletonData *skeletonData) {
 	spAnimationStateData *self = NEW(spAnimationStateData);
 	self->skeletonData = skeletonData;
+	self->emptyAnimation = spAnimation_create("<empty>", NULL, 0);
+	spAnimationStateData_setHoldCacheSize(self, 256);
 	return self;
 }
 
@@ -93,6 +185,8 @@ void spAnimationStateData_dispose(spAnimationStateData *self) {
 		fromEntry = nextFromEntry;
 	}
 
+	spAnimationStateData_setHoldCacheSize(self, 0);
+	spAnimation_dispose(self->emptyAnimation);
 	FREE(self);
 }
 
@@ -0,0 +1,114 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/BakedAnimation.h>
+#include <spine/Skeleton.h>
+#include <spine/extension.h>
+
+#define BAKED_ENTRIES 6
+
+spBakedAnimation *spBakedAnimation_create(spSkeleton *skeleton, spAnimation *animation, float fps) {
+	int i, ii;
+	float lastTime = 0, x = skeleton->x, y = skeleton->y;
+	float *frames;
+	spBakedAnimation *self;
+	if (!(fps > 0)) return 0;
+	self = NEW(spBakedAnimation);
+	self->animation = animation;
+	self->fps = fps;
+	self->framesCount = (int) CEIL(animation->duration * fps) + 1;
+	self->bonesCount = skeleton->bonesCount;
+	self->frames = frames = MALLOC(float, self->framesCount * self->bonesCount * BAKED_ENTRIES);
+
+	skeleton->x = 0;
+	skeleton->y = 0;
+	spSkeleton_setToSetupPose(skeleton);
+	for (i = 0; i < self->framesCount; ++i) {
+		float time = MIN(i / fps, animation->duration);
+		spAnimation_apply(animation, skeleton, lastTime, time, 0, 0, 0, 1, SP_MIX_BLEND_SETUP, SP_MIX_DIRECTION_IN);
+		if (i > 0) spSkeleton_update(skeleton, time - lastTime);
+		spSkeleton_updateWorldTransform(skeleton, i == 0 ? SP_PHYSICS_RESET : SP_PHYSICS_UPDATE);
+		for (ii = 0; ii < self->bonesCount; ++ii, frames += BAKED_ENTRIES) {
+			spBone *bone = skeleton->bones[ii];
+			frames[0] = bone->a;
+			frames[1] = bone->b;
+			frames[2] = bone->c;
+			frames[3] = bone->d;
+			frames[4] = bone->worldX;
+			frames[5] = bone->worldY;
+		}
+		lastTime = time;
+	}
+	skeleton->x = x;
+	skeleton->y = y;
+	return self;
+}
+
+void spBakedAnimation_dispose(spBakedAnimation *self) {
+	FREE(self->frames);
+	FREE(self);
+}
+
+size_t spBakedAnimation_getMemorySize(const spBakedAnimation *self) {
+	return sizeof(spBakedAnimation) + sizeof(float) * self->framesCount * self->bonesCount * BAKED_ENTRIES;
+}
+
+int _spBakedAnimation_findFrame(float time, float fps, float duration, int framesCount, float *alpha) {
+	int frame;
+	float frameTime, nextTime;
+	*alpha = 0;
+	if (time <= 0 || framesCount <= 1) return 0;
+	if (time >= duration) return framesCount - 1;
+	frame = (int) (time * fps);
+	if (frame >= framesCount - 1) return framesCount - 1;
+	/* The last frame is closer than 1 / fps to the one before it when the duration is not a multiple of 1 / fps. */
+	frameTime = frame / fps;
+	nextTime = MIN((frame + 1) / fps, duration);
+	if (nextTime > frameTime) *alpha = MAX(0, MIN((time - frameTime) / (nextTime - frameTime), 1));
+	return frame;
+}
+
+void spBakedAnimation_apply(const spBakedAnimation *self, spSkeleton *skeleton, float time, int /*boolean*/ loop) {
+	int i, frame, n = MIN(self->bonesCount, skeleton->bonesCount);
+	float duration = self->animation->duration, alpha;
+	const float *from, *to;
+	if (loop && duration != 0) time = FMOD(time, duration);
+	frame = _spBakedAnimation_findFrame(time, self->fps, duration, self->framesCount, &alpha);
+	from = self->frames + frame * self->bonesCount * BAKED_ENTRIES;
+	to = alpha == 0 ? from : from + self->bonesCount * BAKED_ENTRIES;
+	for (i = 0; i < n; ++i, from += BAKED_ENTRIES, to += BAKED_ENTRIES) {
+		spBone *bone = skeleton->bones[i];
+		bone->a = from[0] + (to[0] - from[0]) * alpha;
+		bone->b = from[1] + (to[1] - from[1]) * alpha;
+		bone->c = from[2] + (to[2] - from[2]) * alpha;
+		bone->d = from[3] + (to[3] - from[3]) * alpha;
+		bone->worldX = from[4] + (to[4] - from[4]) * alpha + skeleton->x;
+		bone->worldY = from[5] + (to[5] - from[5]) * alpha + skeleton->y;
+	}
+}
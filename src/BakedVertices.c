@@ -0,0 +1,325 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+#include <spine/BakedVertices.h>
+#include <spine/Skeleton.h>
+#include <spine/SkeletonClipping.h>
+#include <spine/Atlas.h>
+#include <spine/extension.h>
+
+/* Bytes appended 4 byte aligned. */
+typedef struct {
+	char *data;
+	int size, capacity;
+} _spBakeBuffer;
+
+/* Returns the offset of the appended bytes. data may be 0 to append zeros. */
+static int _spBakeBuffer_add(_spBakeBuffer *self, const void *data, int size) {
+	int offset = (self->size + 3) & ~3;
+	if (offset + size > self->capacity) {
+		self->capacity = MAX(self->capacity * 2, offset + size);
+		self->data = REALLOC(self->data, char, self->capacity);
+	}
+	memset(self->data + self->size, 0, offset - self->size);
+	if (data)
+		memcpy(self->data + offset, data, size);
+	else
+		memset(self->data + offset, 0, size);
+	self->size = offset + size;
+	return offset;
+}
+
+static unsigned int _packColor(float r, float g, float b, float a) {
+	return (unsigned int) (CLAMP(r, 0, 1) * 255) | (unsigned int) (CLAMP(g, 0, 1) * 255) << 8 |
+		   (unsigned int) (CLAMP(b, 0, 1) * 255) << 16 | (unsigned int) (CLAMP(a, 0, 1) * 255) << 24;
+}
+
+static void _bakeFrame(spSkeleton *skeleton, spSkeletonClipping *clipper, _spBakeBuffer *draws,
+					   _spBakeBuffer *vertices, _spBakeBuffer *indices, spAtlasPage ***pages, int *pagesCount,
+					   float **worldVertices, int *worldVerticesCapacity) {
+	static unsigned short quadIndices[6] = {0, 1, 2, 2, 3, 0};
+	int i, ii, lastDraw = -1;
+
+	draws->size = 0;
+	vertices->size = 0;
+	indices->size = 0;
+	if (skeleton->color.a == 0) return;
+
+	for (i = 0; i < skeleton->slotsCount; ++i) {
+		spSlot *slot = skeleton->drawOrder[i];
+		spAttachment *attachment = slot->attachment;
+		float *slotVertices, *uvs;
+		unsigned short *slotIndices;
+		int verticesCount, indicesCount, page;
+		spColor *color;
+		spAtlasRegion *region;
+		spBakedVerticesDraw *draw;
+		unsigned int packedColor;
+
+		if (!attachment || slot->color.a == 0 || !slot->bone->active) {
+			spSkeletonClipping_clipEnd(clipper, slot);
+			continue;
+		}
+		if (attachment->type == SP_ATTACHMENT_REGION) {
+			spRegionAttachment *regionAttachment = SUB_CAST(spRegionAttachment, attachment);
+			color = &regionAttachment->color;
+			verticesCount = 4;
+			slotIndices = quadIndices;
+			indicesCount = 6;
+			uvs = spRegionAttachment_getUVs(regionAttachment, slot);
+			region = (spAtlasRegion *) spRegionAttachment_getRendererObject(regionAttachment, slot);
+		} else if (attachment->type == SP_ATTACHMENT_MESH) {
+			spMeshAttachment *mesh = SUB_CAST(spMeshAttachment, attachment);
+			color = &mesh->color;
+			verticesCount = mesh->super.worldVerticesLength >> 1;
+			slotIndices = mesh->triangles;
+			indicesCount = mesh->trianglesCount;
+			uvs = spMeshAttachment_getUVs(mesh, slot);
+			region = (spAtlasRegion *) spMeshAttachment_getRendererObject(mesh, slot);
+		} else {
+			if (attachment->type == SP_ATTACHMENT_CLIPPING)
+				spSkeletonClipping_clipStart(clipper, slot, SUB_CAST(spClippingAttachment, attachment));
+			continue;
+		}
+		if (color->a == 0) {
+			spSkeletonClipping_clipEnd(clipper, slot);
+			continue;
+		}
+
+		if (verticesCount * 2 > *worldVerticesCapacity) {
+			*worldVerticesCapacity = verticesCount * 2;
+			FREE(*worldVertices);
+			*worldVertices = MALLOC(float, *worldVerticesCapacity);
+		}
+		slotVertices = *worldVertices;
+		if (attachment->type == SP_ATTACHMENT_REGION)
+			spRegionAttachment_computeWorldVertices(SUB_CAST(spRegionAttachment, attachment), slot, slotVertices, 0, 2);
+		else
+			spVertexAttachment_computeWorldVertices(SUB_CAST(spVertexAttachment, attachment), slot, 0, verticesCount << 1,
+													slotVertices, 0, 2);
+
+		if (spSkeletonClipping_isClipping(clipper)) {
+			spSkeletonClipping_clipTriangles(clipper, slotVertices, verticesCount << 1, slotIndices, indicesCount, uvs, 2);
+			slotVertices = clipper->clippedVertices->items;
+			verticesCount = clipper->clippedVertices->size >> 1;
+			uvs = clipper->clippedUVs->items;
+			slotIndices = clipper->clippedTriangles->items;
+			indicesCount = clipper->clippedTriangles->size;
+		}
+
+		for (page = 0; page < *pagesCount; ++page)
+			if ((*pages)[page] == region->page) break;
+		if (page == *pagesCount) {
+			*pages = REALLOC(*pages, spAtlasPage *, *pagesCount + 1);
+			(*pages)[(*pagesCount)++] = region->page;
+		}
+
+		/* Start a new draw when the state changes or the indices would overflow. */
+		draw = lastDraw == -1 ? 0 : (spBakedVerticesDraw *) draws->data + lastDraw;
+		if (!draw || draw->page != page || draw->blendMode != (int) slot->data->blendMode ||
+			draw->verticesCount + verticesCount > 65536) {
+			spBakedVerticesDraw newDraw;
+			newDraw.page = page;
+			newDraw.blendMode = slot->data->blendMode;
+			newDraw.firstVertex = vertices->size / (int) sizeof(spBakedVertex);
+			newDraw.verticesCount = 0;
+			newDraw.firstIndex = indices->size / (int) sizeof(unsigned short);
+			newDraw.indicesCount = 0;
+			_spBakeBuffer_add(draws, &newDraw, sizeof(newDraw));
+			draw = (spBakedVerticesDraw *) draws->data + ++lastDraw;
+		}
+
+		packedColor = _packColor(skeleton->color.r * slot->color.r * color->r,
+								 skeleton->color.g * slot->color.g * color->g,
+								 skeleton->color.b * slot->color.b * color->b,
+								 skeleton->color.a * slot->color.a * color->a);
+		for (ii = 0; ii < verticesCount; ++ii) {
+			spBakedVertex vertex;
+			vertex.x = slotVertices[ii << 1];
+			vertex.y = slotVertices[(ii << 1) + 1];
+			vertex.u = uvs[ii << 1];
+			vertex.v = uvs[(ii << 1) + 1];
+			vertex.color = packedColor;
+			_spBakeBuffer_add(vertices, &vertex, sizeof(vertex));
+		}
+		/* Indices are 2 bytes, so they are appended without the buffer's alignment. */
+		for (ii = 0; ii < indicesCount; ++ii) {
+			unsigned short index = (unsigned short) (slotIndices[ii] + draw->verticesCount);
+			if (indices->size + (int) sizeof(index) > indices->capacity) {
+				indices->capacity = MAX(indices->capacity * 2, 64);
+				indices->data = REALLOC(indices->data, char, indices->capacity);
+			}
+			memcpy(indices->data + indices->size, &index, sizeof(index));
+			indices->size += sizeof(index);
+		}
+		draw->verticesCount += verticesCount;
+		draw->indicesCount += indicesCount;
+
+		spSkeletonClipping_clipEnd(clipper, slot);
+	}
+	spSkeletonClipping_clipEnd2(clipper);
+}
+
+spBakedVerticesHeader *spBakedVertices_bake(spSkeleton *skeleton, spAnimation *animation, float fps) {
+	_spBakeBuffer out = {0, 0, 0}, draws = {0, 0, 0}, vertices = {0, 0, 0}, indices = {0, 0, 0};
+	spSkeletonClipping *clipper = spSkeletonClipping_create();
+	spAtlasPage **pages = 0;
+	float *worldVertices = 0, lastTime = 0;
+	int i, pagesCount = 0, worldVerticesCapacity = 0, *offsets;
+	spBakedVerticesHeader header;
+
+	if (!(fps > 0)) return 0;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "SPBV", 4);
+	header.version = SP_BAKED_VERTICES_VERSION;
+	header.fps = fps;
+	header.duration = animation->duration;
+	header.framesCount = (int) CEIL(animation->duration * fps) + 1;
+	_spBakeBuffer_add(&out, 0, sizeof(header));
+
+	offsets = MALLOC(int, header.framesCount);
+	spSkeleton_setToSetupPose(skeleton);
+	for (i = 0; i < header.framesCount; ++i) {
+		float time = MIN(i / fps, animation->duration);
+		spBakedVerticesFrame frame;
+		spAnimation_apply(animation, skeleton, lastTime, time, 0, 0, 0, 1, SP_MIX_BLEND_SETUP, SP_MIX_DIRECTION_IN);
+		if (i > 0) spSkeleton_update(skeleton, time - lastTime);
+		spSkeleton_updateWorldTransform(skeleton, i == 0 ? SP_PHYSICS_RESET : SP_PHYSICS_UPDATE);
+		lastTime = time;
+
+		_bakeFrame(skeleton, clipper, &draws, &vertices, &indices, &pages, &pagesCount, &worldVertices,
+				   &worldVerticesCapacity);
+		offsets[i] = _spBakeBuffer_add(&out, 0, sizeof(frame));
+		frame.drawsCount = draws.size / (int) sizeof(spBakedVerticesDraw);
+		frame.verticesCount = vertices.size / (int) sizeof(spBakedVertex);
+		frame.indicesCount = indices.size / (int) sizeof(unsigned short);
+		frame.drawsOffset = _spBakeBuffer_add(&out, draws.data, draws.size) - offsets[i];
+		frame.verticesOffset = _spBakeBuffer_add(&out, vertices.data, vertices.size) - offsets[i];
+		frame.indicesOffset = _spBakeBuffer_add(&out, indices.data, indices.size) - offsets[i];
+		memcpy(out.data + offsets[i], &frame, sizeof(frame));
+	}
+	header.framesOffset = _spBakeBuffer_add(&out, offsets, sizeof(int) * header.framesCount);
+	FREE(offsets);
+
+	header.pagesCount = pagesCount;
+	offsets = MALLOC(int, pagesCount);
+	for (i = 0; i < pagesCount; ++i)
+		offsets[i] = _spBakeBuffer_add(&out, pages[i]->name, (int) strlen(pages[i]->name) + 1);
+	header.pagesOffset = _spBakeBuffer_add(&out, offsets, sizeof(int) * pagesCount);
+	FREE(offsets);
+
+	header.size = out.size;
+	memcpy(out.data, &header, sizeof(header));
+
+	FREE(pages);
+	FREE(worldVertices);
+	FREE(draws.data);
+	FREE(vertices.data);
+	FREE(indices.data);
+	spSkeletonClipping_dispose(clipper);
+	return (spBakedVerticesHeader *) out.data;
+}
+
+void spBakedVertices_dispose(spBakedVerticesHeader *self) {
+	FREE(self);
+}
+
+static int _inBounds(int offset, int count, int itemSize, int size) {
+	return offset >= 0 && count >= 0 && (offset & 3) == 0 && offset <= size && count <= (size - offset) / itemSize;
+}
+
+const spBakedVerticesHeader *spBakedVertices_open(const void *memory, int size) {
+	const spBakedVerticesHeader *self = (const spBakedVerticesHeader *) memory;
+	const char *base = (const char *) memory;
+	const int *offsets;
+	int i;
+	if (size < (int) sizeof(spBakedVerticesHeader) || memcmp(self->magic, "SPBV", 4) != 0) return 0;
+	if (self->version != SP_BAKED_VERTICES_VERSION || self->size > size) return 0;
+	if (!(self->fps > 0) || !(self->duration >= 0)) return 0;
+	size = self->size;
+	if (!_inBounds(self->framesOffset, self->framesCount, sizeof(int), size)) return 0;
+	if (!_inBounds(self->pagesOffset, self->pagesCount, sizeof(int), size)) return 0;
+
+	/* Check every offset once, so the getters can trust the data. */
+	offsets = (const int *) (base + self->pagesOffset);
+	for (i = 0; i < self->pagesCount; ++i) {
+		if (offsets[i] < 0 || offsets[i] >= size || !memchr(base + offsets[i], 0, size - offsets[i])) return 0;
+	}
+	offsets = (const int *) (base + self->framesOffset);
+	for (i = 0; i < self->framesCount; ++i) {
+		const spBakedVerticesFrame *frame;
+		int ii, frameSize;
+		if (!_inBounds(offsets[i], 1, sizeof(spBakedVerticesFrame), size)) return 0;
+		frame = (const spBakedVerticesFrame *) (base + offsets[i]);
+		frameSize = size - offsets[i];
+		if (!_inBounds(frame->drawsOffset, frame->drawsCount, sizeof(spBakedVerticesDraw), frameSize) ||
+			!_inBounds(frame->verticesOffset, frame->verticesCount, sizeof(spBakedVertex), frameSize) ||
+			!_inBounds(frame->indicesOffset, frame->indicesCount, sizeof(unsigned short), frameSize))
+			return 0;
+		for (ii = 0; ii < frame->drawsCount; ++ii) {
+			const spBakedVerticesDraw *draw = spBakedVerticesFrame_getDraws(frame) + ii;
+			if (draw->page < 0 || draw->page >= self->pagesCount) return 0;
+			if (draw->firstVertex < 0 || draw->verticesCount < 0 ||
+				draw->verticesCount > frame->verticesCount - draw->firstVertex)
+				return 0;
+			if (draw->firstIndex < 0 || draw->indicesCount < 0 ||
+				draw->indicesCount > frame->indicesCount - draw->firstIndex)
+				return 0;
+		}
+	}
+	return self;
+}
+
+const char *spBakedVertices_getPageName(const spBakedVerticesHeader *self, int page) {
+	const int *offsets = (const int *) ((const char *) self + self->pagesOffset);
+	return (const char *) self + offsets[page];
+}
+
+const spBakedVerticesFrame *spBakedVertices_getFrame(const spBakedVerticesHeader *self, float time, int /*boolean*/ loop) {
+	const int *offsets = (const int *) ((const char *) self + self->framesOffset);
+	int frame;
+	float alpha;
+	if (self->framesCount == 0) return 0;
+	if (loop && self->duration != 0) time = FMOD(time, self->duration);
+	frame = _spBakedAnimation_findFrame(time, self->fps, self->duration, self->framesCount, &alpha);
+	if (alpha >= 0.5f) frame++;
+	return (const spBakedVerticesFrame *) ((const char *) self + offsets[frame]);
+}
+
+const spBakedVerticesDraw *spBakedVerticesFrame_getDraws(const spBakedVerticesFrame *self) {
+	return (const spBakedVerticesDraw *) ((const char *) self + self->drawsOffset);
+}
+
+const spBakedVertex *spBakedVerticesFrame_getVertices(const spBakedVerticesFrame *self) {
+	return (const spBakedVertex *) ((const char *) self + self->verticesOffset);
+}
+
+const unsigned short *spBakedVerticesFrame_getIndices(const spBakedVerticesFrame *self) {
+	return (const unsigned short *) ((const char *) self + self->indicesOffset);
+}
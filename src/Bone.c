@@ -43,6 +43,11 @@ int spBone_isYDown(void) {
 
 spBone *spBone_create(spBoneData *data, spSkeleton *skeleton, spBone *parent) {
 	spBone *self = NEW(spBone);
+	_spBone_init(self, data, skeleton, parent);
+	return self;
+}
+
+void _spBone_init(spBone *self, spBoneData *data, spSkeleton *skeleton, spBone *parent) {
 	self->data = data;
 	self->skeleton = skeleton;
 	self->parent = parent;
@@ -51,7 +56,6 @@ spBone *spBone_create(spBoneData *data, spSkeleton *skeleton, spBone *parent) {
 	self->active = -1;
 	self->inherit = SP_INHERIT_NORMAL;
 	spBone_setToSetupPose(self);
-	return self;
 }
 
 void spBone_dispose(spBone *self) {
@@ -72,7 +76,7 @@ void spBone_updateWorldTransformWith(spBone *self, float x, float y, float rotat
 									 float shearX, float shearY) {
 	float pa, pb, pc, pd;
 	float sx = self->skeleton->scaleX;
-	float sy = self->skeleton->scaleY * (spBone_isYDown() ? -1 : 1);
+	float sy = self->skeleton->scaleY * (spSkeleton_isYDown(self->skeleton) ? -1 : 1);
 	spBone *parent = self->parent;
 
 	self->ax = x;
@@ -230,7 +234,7 @@ void spBone_updateAppliedTransform(spBone *self) {
 	float s, sa, sc;
 	float cosine, sine;
 
-	float yDownScale = spBone_isYDown() ? -1 : 1;
+	float yDownScale = spSkeleton_isYDown(self->skeleton) ? -1 : 1;
 
 	spBone *parent = self->parent;
 	if (!parent) {
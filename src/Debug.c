@@ -72,7 +72,10 @@ void _spDebug_printTimelineBase(spTimeline *timeline) {
 	printf("      frame count: %i\n", timeline->frameCount);
 	printf("      frame entries: %i\n", timeline->frameEntries);
 	printf("      frames: ");
-	spDebug_printFloats(timeline->frames->items, timeline->frames->size);
+	if (timeline->frames->items)
+		spDebug_printFloats(timeline->frames->items, timeline->frames->size);
+	else
+		printf("quantized");
 	printf("\n");
 }
 
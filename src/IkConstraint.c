@@ -33,9 +33,13 @@
 #include <spine/extension.h>
 
 spIkConstraint *spIkConstraint_create(spIkConstraintData *data, const spSkeleton *skeleton) {
-	int i;
-
 	spIkConstraint *self = NEW(spIkConstraint);
+	_spIkConstraint_init(self, data, skeleton, MALLOC(spBone *, data->bonesCount));
+	return self;
+}
+
+void _spIkConstraint_init(spIkConstraint *self, spIkConstraintData *data, const spSkeleton *skeleton, spBone **bones) {
+	int i;
 	self->data = data;
 	self->bendDirection = data->bendDirection;
 	self->compress = data->compress;
@@ -44,12 +48,10 @@ spIkConstraint *spIkConstraint_create(spIkConstraintData *data, const spSkeleton
 	self->softness = data->softness;
 
 	self->bonesCount = self->data->bonesCount;
-	self->bones = MALLOC(spBone *, self->bonesCount);
+	self->bones = bones;
 	for (i = 0; i < self->bonesCount; ++i)
 		self->bones[i] = spSkeleton_findBone(skeleton, self->data->bones[i]->name);
 	self->target = spSkeleton_findBone(skeleton, self->data->target->name);
-
-	return self;
 }
 
 void spIkConstraint_dispose(spIkConstraint *self) {
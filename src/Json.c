@@ -46,12 +46,6 @@ THE SOFTWARE.
 #define SPINE_JSON_DEBUG 0
 #endif
 
-static const char *ep;
-
-const char *Json_getError(void) {
-	return ep;
-}
-
 static int Json_strcasecmp(const char *s1, const char *s2) {
 	/* TODO we may be able to elide these NULL checks if we can prove
 	the graph and input (only callsite is Json_getItem) should not have NULLs */
@@ -90,7 +84,7 @@ void Json_dispose(Json *c) {
 }
 
 /* Parse the input text to generate a number, and populate the result into item. */
-static const char *parse_number(Json *item, const char *num) {
+static const char *parse_number(Json *item, const char *num, const char **ep) {
 	double result = 0.0;
 	int negative = 0;
 	char *ptr = (char *) num;
@@ -150,7 +144,7 @@ static const char *parse_number(Json *item, const char *num) {
 		return ptr;
 	} else {
 		/* Parse failure, ep is set. */
-		ep = num;
+		*ep = num;
 		return 0;
 	}
 }
@@ -158,14 +152,14 @@ static const char *parse_number(Json *item, const char *num) {
 /* Parse the input text into an unescaped cstring, and populate item. */
 static const unsigned char firstByteMark[7] = {0x00, 0x00, 0xC0, 0xE0, 0xF0, 0xF8, 0xFC};
 
-static const char *parse_string(Json *item, const char *str) {
+static const char *parse_string(Json *item, const char *str, const char **ep) {
 	const char *ptr = str + 1;
 	char *ptr2;
 	char *out;
 	int len = 0;
 	unsigned uc, uc2;
 	if (*str != '\"') { /* TODO: don't need this check when called from parse_value, but do need from parse_object */
-		ep = str;
+		*ep = str;
 		return 0;
 	} /* not a string! */
 
@@ -256,11 +250,11 @@ static const char *parse_string(Json *item, const char *str) {
 }
 
 /* Predeclare these prototypes. */
-static const char *parse_value(Json *item, const char *value);
+static const char *parse_value(Json *item, const char *value, const char **ep);
 
-static const char *parse_array(Json *item, const char *value);
+static const char *parse_array(Json *item, const char *value, const char **ep);
 
-static const char *parse_object(Json *item, const char *value);
+static const char *parse_object(Json *item, const char *value, const char **ep);
 
 /* Utility to jump whitespace and cr/lf */
 static const char *skip(const char *in) {
@@ -271,14 +265,14 @@ static const char *skip(const char *in) {
 }
 
 /* Parse an object - create a new root, and populate. */
-Json *Json_create(const char *value) {
+Json *Json_create(const char *value, const char **ep) {
 	Json *c;
-	ep = 0;
+	*ep = 0;
 	if (!value) return 0; /* only place we check for NULL other than skip() */
 	c = Json_new();
 	if (!c) return 0; /* memory fail */
 
-	value = parse_value(c, skip(value));
+	value = parse_value(c, skip(value), ep);
 	if (!value) {
 		Json_dispose(c);
 		return 0;
@@ -288,7 +282,7 @@ Json *Json_create(const char *value) {
 }
 
 /* Parser core - when encountering text, process appropriately. */
-static const char *parse_value(Json *item, const char *value) {
+static const char *parse_value(Json *item, const char *value, const char **ep) {
 	/* Referenced by Json_create(), parse_array(), and parse_object(). */
 	/* Always called with the result of skip(). */
 #if SPINE_JSON_DEBUG      /* Checked at entry to graph, Json_create, and after every parse_ call. */
@@ -320,11 +314,11 @@ static const char *parse_value(Json *item, const char *value) {
 			break;
 		}
 		case '\"':
-			return parse_string(item, value);
+			return parse_string(item, value, ep);
 		case '[':
-			return parse_array(item, value);
+			return parse_array(item, value, ep);
 		case '{':
-			return parse_object(item, value);
+			return parse_object(item, value, ep);
 		case '-': /* fallthrough */
 		case '0': /* fallthrough */
 		case '1': /* fallthrough */
@@ -336,22 +330,22 @@ static const char *parse_value(Json *item, const char *value) {
 		case '7': /* fallthrough */
 		case '8': /* fallthrough */
 		case '9':
-			return parse_number(item, value);
+			return parse_number(item, value, ep);
 		default:
 			break;
 	}
 
-	ep = value;
+	*ep = value;
 	return 0; /* failure. */
 }
 
 /* Build an array from input text. */
-static const char *parse_array(Json *item, const char *value) {
+static const char *parse_array(Json *item, const char *value, const char **ep) {
 	Json *child;
 
 #if SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
 	if (*value != '[') {
-		ep = value;
+		*ep = value;
 		return 0;
 	} /* not an array! */
 #endif
@@ -362,7 +356,7 @@ static const char *parse_array(Json *item, const char *value) {
 
 	item->child = child = Json_new();
 	if (!item->child) return 0;                    /* memory fail */
-	value = skip(parse_value(child, skip(value))); /* skip any spacing, get the value. */
+	value = skip(parse_value(child, skip(value), ep)); /* skip any spacing, get the value. */
 	if (!value) return 0;
 	item->size = 1;
 
@@ -374,23 +368,23 @@ static const char *parse_array(Json *item, const char *value) {
 		new_item->prev = child;
 #endif
 		child = new_item;
-		value = skip(parse_value(child, skip(value + 1)));
+		value = skip(parse_value(child, skip(value + 1), ep));
 		if (!value) return 0; /* parse fail */
 		item->size++;
 	}
 
 	if (*value == ']') return value + 1; /* end of array */
-	ep = value;
+	*ep = value;
 	return 0; /* malformed. */
 }
 
 /* Build an object from the text. */
-static const char *parse_object(Json *item, const char *value) {
+static const char *parse_object(Json *item, const char *value, const char **ep) {
 	Json *child;
 
 #if SPINE_JSON_DEBUG /* unnecessary, only callsite (parse_value) verifies this */
 	if (*value != '{') {
-		ep = value;
+		*ep = value;
 		return 0;
 	} /* not an object! */
 #endif
@@ -401,15 +395,15 @@ static const char *parse_object(Json *item, const char *value) {
 
 	item->child = child = Json_new();
 	if (!item->child) return 0;
-	value = skip(parse_string(child, skip(value)));
+	value = skip(parse_string(child, skip(value), ep));
 	if (!value) return 0;
 	child->name = child->valueString;
 	child->valueString = 0;
 	if (*value != ':') {
-		ep = value;
+		*ep = value;
 		return 0;
 	}                                                  /* fail! */
-	value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+	value = skip(parse_value(child, skip(value + 1), ep)); /* skip any spacing, get the value. */
 	if (!value) return 0;
 	item->size = 1;
 
@@ -421,21 +415,21 @@ static const char *parse_object(Json *item, const char *value) {
 		new_item->prev = child;
 #endif
 		child = new_item;
-		value = skip(parse_string(child, skip(value + 1)));
+		value = skip(parse_string(child, skip(value + 1), ep));
 		if (!value) return 0;
 		child->name = child->valueString;
 		child->valueString = 0;
 		if (*value != ':') {
-			ep = value;
+			*ep = value;
 			return 0;
 		}                                                  /* fail! */
-		value = skip(parse_value(child, skip(value + 1))); /* skip any spacing, get the value. */
+		value = skip(parse_value(child, skip(value + 1), ep)); /* skip any spacing, get the value. */
 		if (!value) return 0;
 		item->size++;
 	}
 
 	if (*value == '}') return value + 1; /* end of array */
-	ep = value;
+	*ep = value;
 	return 0; /* malformed. */
 }
 
@@ -61,8 +61,10 @@ typedef struct Json {
 	const char *name; /* The item's name string, if this item is the child of, or is in the list of subitems of an object. */
 } Json;
 
-/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished. */
-Json *Json_create(const char *value);
+/* Supply a block of JSON, and this returns a Json object you can interrogate. Call Json_dispose when finished.
+ * For analysing failed parses, error is set to a pointer to the parse error. You'll probably need to look a few chars
+ * back to make sense of it. Set to 0 when Json_create() succeeds. */
+Json *Json_create(const char *value, const char **error);
 
 /* Delete a Json entity and all subentities. */
 void Json_dispose(Json *json);
@@ -78,9 +80,6 @@ float Json_getFloat(Json *json, const char *name, float defaultValue);
 
 int Json_getInt(Json *json, const char *name, int defaultValue);
 
-/* For analysing failed parses. This returns a pointer to the parse error. You'll probably need to look a few chars back to make sense of it. Defined when Json_create() returns 0. 0 when Json_create() succeeds. */
-const char *Json_getError(void);
-
 #ifdef __cplusplus
 }
 #endif
@@ -99,25 +99,26 @@ spMeshAttachment *spMeshAttachment_create(const char *name) {
 	return self;
 }
 
-void spMeshAttachment_updateRegion(spMeshAttachment *self) {
-	int i, n;
-	float *uvs;
+static void _spMeshAttachment_computeUVs(spMeshAttachment *self, spTextureRegion *region, float *uvs) {
+	int i, n = SUPER(self)->worldVerticesLength;
 	float u, v, width, height;
-	int verticesLength = SUPER(self)->worldVerticesLength;
-	FREE(self->uvs);
-	uvs = self->uvs = MALLOC(float, verticesLength);
-	n = verticesLength;
-	u = self->region->u;
-	v = self->region->v;
 
-	switch (self->region->degrees) {
+	if (region == NULL) {
+		memcpy(uvs, self->regionUVs, sizeof(float) * n);
+		return;
+	}
+
+	u = region->u;
+	v = region->v;
+
+	switch (region->degrees) {
 		case 90: {
-			float textureWidth = self->region->height / (self->region->u2 - self->region->u);
-			float textureHeight = self->region->width / (self->region->v2 - self->region->v);
-			u -= (self->region->originalHeight - self->region->offsetY - self->region->height) / textureWidth;
-			v -= (self->region->originalWidth - self->region->offsetX - self->region->width) / textureHeight;
-			width = self->region->originalHeight / textureWidth;
-			height = self->region->originalWidth / textureHeight;
+			float textureWidth = region->height / (region->u2 - region->u);
+			float textureHeight = region->width / (region->v2 - region->v);
+			u -= (region->originalHeight - region->offsetY - region->height) / textureWidth;
+			v -= (region->originalWidth - region->offsetX - region->width) / textureHeight;
+			width = region->originalHeight / textureWidth;
+			height = region->originalWidth / textureHeight;
 			for (i = 0; i < n; i += 2) {
 				uvs[i] = u + self->regionUVs[i + 1] * width;
 				uvs[i + 1] = v + (1 - self->regionUVs[i]) * height;
@@ -125,12 +126,12 @@ void spMeshAttachment_updateRegion(spMeshAttachment *self) {
 			return;
 		}
 		case 180: {
-			float textureWidth = self->region->width / (self->region->u2 - self->region->u);
-			float textureHeight = self->region->height / (self->region->v2 - self->region->v);
-			u -= (self->region->originalWidth - self->region->offsetX - self->region->width) / textureWidth;
-			v -= self->region->offsetY / textureHeight;
-			width = self->region->originalWidth / textureWidth;
-			height = self->region->originalHeight / textureHeight;
+			float textureWidth = region->width / (region->u2 - region->u);
+			float textureHeight = region->height / (region->v2 - region->v);
+			u -= (region->originalWidth - region->offsetX - region->width) / textureWidth;
+			v -= region->offsetY / textureHeight;
+			width = region->originalWidth / textureWidth;
+			height = region->originalHeight / textureHeight;
 			for (i = 0; i < n; i += 2) {
 				uvs[i] = u + (1 - self->regionUVs[i]) * width;
 				uvs[i + 1] = v + (1 - self->regionUVs[i + 1]) * height;
@@ -138,12 +139,12 @@ void spMeshAttachment_updateRegion(spMeshAttachment *self) {
 			return;
 		}
 		case 270: {
-			float textureHeight = self->region->height / (self->region->v2 - self->region->v);
-			float textureWidth = self->region->width / (self->region->u2 - self->region->u);
-			u -= self->region->offsetY / textureWidth;
-			v -= self->region->offsetX / textureHeight;
-			width = self->region->originalHeight / textureWidth;
-			height = self->region->originalWidth / textureHeight;
+			float textureHeight = region->height / (region->v2 - region->v);
+			float textureWidth = region->width / (region->u2 - region->u);
+			u -= region->offsetY / textureWidth;
+			v -= region->offsetX / textureHeight;
+			width = region->originalHeight / textureWidth;
+			height = region->originalWidth / textureHeight;
 			for (i = 0; i < n; i += 2) {
 				uvs[i] = u + (1 - self->regionUVs[i + 1]) * width;
 				uvs[i + 1] = v + self->regionUVs[i] * height;
@@ -151,12 +152,12 @@ void spMeshAttachment_updateRegion(spMeshAttachment *self) {
 			return;
 		}
 		default: {
-			float textureWidth = self->region->width / (self->region->u2 - self->region->u);
-			float textureHeight = self->region->height / (self->region->v2 - self->region->v);
-			u -= self->region->offsetX / textureWidth;
-			v -= (self->region->originalHeight - self->region->offsetY - self->region->height) / textureHeight;
-			width = self->region->originalWidth / textureWidth;
-			height = self->region->originalHeight / textureHeight;
+			float textureWidth = region->width / (region->u2 - region->u);
+			float textureHeight = region->height / (region->v2 - region->v);
+			u -= region->offsetX / textureWidth;
+			v -= (region->originalHeight - region->offsetY - region->height) / textureHeight;
+			width = region->originalWidth / textureWidth;
+			height = region->originalHeight / textureHeight;
 			for (i = 0; i < n; i += 2) {
 				uvs[i] = u + self->regionUVs[i] * width;
 				uvs[i + 1] = v + self->regionUVs[i + 1] * height;
@@ -165,6 +166,41 @@ void spMeshAttachment_updateRegion(spMeshAttachment *self) {
 	}
 }
 
+void spMeshAttachment_updateRegion(spMeshAttachment *self) {
+	spSequence *sequence = self->sequence;
+	int verticesLength = SUPER(self)->worldVerticesLength;
+	FREE(self->uvs);
+	self->uvs = MALLOC(float, verticesLength);
+	if (sequence) {
+		/* Compute the UVs for every region of the sequence once, so rendering only reads them. The attachment itself
+		 * shows the setup region. */
+		int i, n = sequence->regions->size;
+		FREE(sequence->uvs);
+		sequence->uvsCount = verticesLength;
+		sequence->uvs = MALLOC(float, n * verticesLength);
+		for (i = 0; i < n; i++)
+			_spMeshAttachment_computeUVs(self, sequence->regions->items[i], sequence->uvs + i * verticesLength);
+		if (n > 0) {
+			i = MIN(sequence->setupIndex, n - 1);
+			self->region = sequence->regions->items[i];
+			self->rendererObject = self->region;
+		}
+	}
+	_spMeshAttachment_computeUVs(self, self->region, self->uvs);
+}
+
+float *spMeshAttachment_getUVs(spMeshAttachment *self, spSlot *slot) {
+	spSequence *sequence = self->sequence;
+	if (!sequence || !sequence->uvs) return self->uvs;
+	return sequence->uvs + spSequence_resolveIndex(sequence, slot) * sequence->uvsCount;
+}
+
+void *spMeshAttachment_getRendererObject(spMeshAttachment *self, spSlot *slot) {
+	spSequence *sequence = self->sequence;
+	if (!sequence || !sequence->uvs) return self->rendererObject;
+	return sequence->regions->items[spSequence_resolveIndex(sequence, slot)];
+}
+
 void spMeshAttachment_setParentMesh(spMeshAttachment *self, spMeshAttachment *parentMesh) {
 	self->parentMesh = parentMesh;
 	if (parentMesh) {
@@ -37,11 +37,17 @@
 #define EPSILON 0.00001f
 
 spPathConstraint *spPathConstraint_create(spPathConstraintData *data, const spSkeleton *skeleton) {
-	int i;
 	spPathConstraint *self = NEW(spPathConstraint);
+	_spPathConstraint_init(self, data, skeleton, MALLOC(spBone *, data->bonesCount));
+	return self;
+}
+
+void _spPathConstraint_init(spPathConstraint *self, spPathConstraintData *data, const spSkeleton *skeleton,
+							spBone **bones) {
+	int i;
 	self->data = data;
 	self->bonesCount = data->bonesCount;
-	self->bones = MALLOC(spBone *, self->bonesCount);
+	self->bones = bones;
 	for (i = 0; i < self->bonesCount; ++i)
 		self->bones[i] = spSkeleton_findBone(skeleton, self->data->bones[i]->name);
 	self->target = spSkeleton_findSlot(skeleton, self->data->target->name);
@@ -60,17 +66,20 @@ spPathConstraint *spPathConstraint_create(spPathConstraintData *data, const spSk
 	self->curves = 0;
 	self->lengthsCount = 0;
 	self->lengths = 0;
-	return self;
 }
 
 void spPathConstraint_dispose(spPathConstraint *self) {
 	FREE(self->bones);
+	_spPathConstraint_disposeBuffers(self);
+	FREE(self);
+}
+
+void _spPathConstraint_disposeBuffers(spPathConstraint *self) {
 	FREE(self->spaces);
 	if (self->positions) FREE(self->positions);
 	if (self->world) FREE(self->world);
 	if (self->curves) FREE(self->curves);
 	if (self->lengths) FREE(self->lengths);
-	FREE(self);
 }
 
 void spPathConstraint_update(spPathConstraint *self) {
@@ -33,6 +33,11 @@
 
 spPhysicsConstraint *spPhysicsConstraint_create(spPhysicsConstraintData *data, spSkeleton *skeleton) {
 	spPhysicsConstraint *self = NEW(spPhysicsConstraint);
+	_spPhysicsConstraint_init(self, data, skeleton);
+	return self;
+}
+
+void _spPhysicsConstraint_init(spPhysicsConstraint *self, spPhysicsConstraintData *data, spSkeleton *skeleton) {
 	self->data = data;
 	self->skeleton = skeleton;
 	self->bone = skeleton->bones[data->bone->index];
@@ -61,7 +66,6 @@ spPhysicsConstraint *spPhysicsConstraint_create(spPhysicsConstraintData *data, s
 	self->active = 0;
 	self->remaining = 0;
 	self->lastTime = 0;
-	return self;
 }
 
 void spPhysicsConstraint_dispose(spPhysicsConstraint *self) {
@@ -140,7 +144,7 @@ void spPhysicsConstraint_update(spPhysicsConstraint *self, spPhysics physics) {
 					}
 					if (a >= t) {
 						float d = POW(self->damping, 60 * t);
-						float m = self->massInverse * t, e = self->strength, w = self->wind * f, g = self->gravity * f * (spBone_isYDown() ? -1 : 1);
+						float m = self->massInverse * t, e = self->strength, w = self->wind * f, g = self->gravity * f * (spSkeleton_isYDown(self->skeleton) ? -1 : 1);
 						do {
 							if (x) {
 								self->xVelocity += (w - self->xOffset * e) * m;
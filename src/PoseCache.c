@@ -0,0 +1,670 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#include <spine/PoseCache.h>
+#include <spine/Skeleton.h>
+#include <spine/extension.h>
+#include <string.h>
+
+typedef enum {
+	POSE_BONE, POSE_SLOT, POSE_IK, POSE_TRANSFORM, POSE_PATH, POSE_PHYSICS
+} _spPoseKind;
+
+/* Floats stored for each kind of target. */
+static const int _valuesCount[] = {8, 9, 5, 6, 5, 7};
+
+/* A bone, slot, or constraint the animation keys, with the spProperty bits of the keyed values. */
+typedef struct {
+	_spPoseKind kind;
+	int index;
+	int properties;
+} _spPoseTarget;
+
+typedef struct _spPoseLayout _spPoseLayout;
+struct _spPoseLayout {
+	spAnimation *animation;
+	int targetsCount;
+	_spPoseTarget *targets;
+	int slotsCount; /* Targets that are slots, which store an attachment. */
+	int valuesCount;
+	int /*boolean*/ drawOrder;
+	size_t size; /* Counted in the cache's bytes while entries use the layout. */
+	int entriesCount;
+	_spPoseLayout *next;
+};
+
+typedef struct _spPoseEntry _spPoseEntry;
+struct _spPoseEntry {
+	spAnimation *animation;
+	spSkin *skin;
+	int bucket;
+	_spPoseLayout *layout;
+	size_t size;
+	_spPoseEntry *chain; /* Next in the hash bucket. */
+	_spPoseEntry *prev, *next; /* Most to least recently used. */
+
+	/* Allocated with the entry. */
+	spAttachment **attachments;
+	int *drawOrder;
+	float *values; /* For each target, then the deform of each slot. */
+};
+
+typedef struct {
+	spPoseCache super;
+	spSkeleton *skeleton; /* Used to sample the poses. */
+	_spPoseLayout *layouts;
+	_spPoseEntry **buckets;
+	int bucketsMask;
+	_spPoseEntry *first, *last;
+} _spPoseCache;
+
+static void _addTarget(int *properties, _spPoseKind kind, int index, int bits, _spPoseTarget **targets, int *count,
+					   int *capacity) {
+	if (!properties[index]) {
+		if (*count == *capacity) {
+			*capacity = MAX(8, *capacity << 1);
+			*targets = REALLOC(*targets, _spPoseTarget, *capacity);
+		}
+		(*targets)[*count].kind = kind;
+		(*targets)[*count].index = index;
+		(*targets)[*count].properties = 0;
+		properties[index] = ++*count;
+	}
+	(*targets)[properties[index] - 1].properties |= bits;
+}
+
+static _spPoseLayout *_spPoseLayout_create(spSkeletonData *data, spAnimation *animation) {
+	_spPoseLayout *self = NEW(_spPoseLayout);
+	int counts[] = {data->bonesCount, data->slotsCount, data->ikConstraintsCount, data->transformConstraintsCount,
+					data->pathConstraintsCount, data->physicsConstraintsCount};
+	int *properties[6]; /* For each kind, the target index + 1 by bone, slot, or constraint index, or 0. */
+	int i, ii, capacity = 0;
+	for (i = 0; i < 6; ++i) properties[i] = CALLOC(int, counts[i] + 1);
+	self->animation = animation;
+
+#define ADD(KIND, INDEX, BITS) _addTarget(properties[KIND], KIND, INDEX, BITS, &self->targets, &self->targetsCount, &capacity)
+#define BONE(TYPE, BITS) ADD(POSE_BONE, SUB_CAST(TYPE, timeline)->boneIndex, BITS)
+#define SLOT(TYPE, BITS) ADD(POSE_SLOT, SUB_CAST(TYPE, timeline)->slotIndex, BITS)
+	for (i = 0; i < animation->timelines->size; ++i) {
+		spTimeline *timeline = animation->timelines->items[i];
+		switch (timeline->type) {
+			case SP_TIMELINE_ROTATE:
+				BONE(spRotateTimeline, SP_PROPERTY_ROTATE);
+				break;
+			case SP_TIMELINE_TRANSLATE:
+				BONE(spTranslateTimeline, SP_PROPERTY_X | SP_PROPERTY_Y);
+				break;
+			case SP_TIMELINE_TRANSLATEX:
+				BONE(spTranslateXTimeline, SP_PROPERTY_X);
+				break;
+			case SP_TIMELINE_TRANSLATEY:
+				BONE(spTranslateYTimeline, SP_PROPERTY_Y);
+				break;
+			case SP_TIMELINE_SCALE:
+				BONE(spScaleTimeline, SP_PROPERTY_SCALEX | SP_PROPERTY_SCALEY);
+				break;
+			case SP_TIMELINE_SCALEX:
+				BONE(spScaleXTimeline, SP_PROPERTY_SCALEX);
+				break;
+			case SP_TIMELINE_SCALEY:
+				BONE(spScaleYTimeline, SP_PROPERTY_SCALEY);
+				break;
+			case SP_TIMELINE_SHEAR:
+				BONE(spShearTimeline, SP_PROPERTY_SHEARX | SP_PROPERTY_SHEARY);
+				break;
+			case SP_TIMELINE_SHEARX:
+				BONE(spShearXTimeline, SP_PROPERTY_SHEARX);
+				break;
+			case SP_TIMELINE_SHEARY:
+				BONE(spShearYTimeline, SP_PROPERTY_SHEARY);
+				break;
+			case SP_TIMELINE_INHERIT:
+				BONE(spInheritTimeline, SP_PROPERTY_INHERIT);
+				break;
+			case SP_TIMELINE_RGBA:
+				SLOT(spRGBATimeline, SP_PROPERTY_RGB | SP_PROPERTY_ALPHA);
+				break;
+			case SP_TIMELINE_RGB:
+				SLOT(spRGBTimeline, SP_PROPERTY_RGB);
+				break;
+			case SP_TIMELINE_ALPHA:
+				SLOT(spAlphaTimeline, SP_PROPERTY_ALPHA);
+				break;
+			case SP_TIMELINE_RGBA2:
+				SLOT(spRGBA2Timeline, SP_PROPERTY_RGB | SP_PROPERTY_ALPHA | SP_PROPERTY_RGB2);
+				break;
+			case SP_TIMELINE_RGB2:
+				SLOT(spRGB2Timeline, SP_PROPERTY_RGB | SP_PROPERTY_RGB2);
+				break;
+			case SP_TIMELINE_ATTACHMENT:
+				SLOT(spAttachmentTimeline, SP_PROPERTY_ATTACHMENT);
+				break;
+			case SP_TIMELINE_DEFORM:
+				SLOT(spDeformTimeline, SP_PROPERTY_DEFORM);
+				break;
+			case SP_TIMELINE_SEQUENCE:
+				SLOT(spSequenceTimeline, SP_PROPERTY_SEQUENCE);
+				break;
+			case SP_TIMELINE_IKCONSTRAINT:
+				ADD(POSE_IK, SUB_CAST(spIkConstraintTimeline, timeline)->ikConstraintIndex, SP_PROPERTY_IKCONSTRAINT);
+				break;
+			case SP_TIMELINE_TRANSFORMCONSTRAINT:
+				ADD(POSE_TRANSFORM, SUB_CAST(spTransformConstraintTimeline, timeline)->transformConstraintIndex,
+					SP_PROPERTY_TRANSFORMCONSTRAINT);
+				break;
+			case SP_TIMELINE_PATHCONSTRAINTPOSITION:
+				ADD(POSE_PATH, SUB_CAST(spPathConstraintPositionTimeline, timeline)->pathConstraintIndex,
+					SP_PROPERTY_PATHCONSTRAINT_POSITION);
+				break;
+			case SP_TIMELINE_PATHCONSTRAINTSPACING:
+				ADD(POSE_PATH, SUB_CAST(spPathConstraintSpacingTimeline, timeline)->pathConstraintIndex,
+					SP_PROPERTY_PATHCONSTRAINT_SPACING);
+				break;
+			case SP_TIMELINE_PATHCONSTRAINTMIX:
+				ADD(POSE_PATH, SUB_CAST(spPathConstraintMixTimeline, timeline)->pathConstraintIndex,
+					SP_PROPERTY_PATHCONSTRAINT_MIX);
+				break;
+			case SP_TIMELINE_PHYSICSCONSTRAINT_INERTIA:
+			case SP_TIMELINE_PHYSICSCONSTRAINT_STRENGTH:
+			case SP_TIMELINE_PHYSICSCONSTRAINT_DAMPING:
+			case SP_TIMELINE_PHYSICSCONSTRAINT_MASS:
+			case SP_TIMELINE_PHYSICSCONSTRAINT_WIND:
+			case SP_TIMELINE_PHYSICSCONSTRAINT_GRAVITY:
+			case SP_TIMELINE_PHYSICSCONSTRAINT_MIX: {
+				int index = SUB_CAST(spPhysicsConstraintTimeline, timeline)->physicsConstraintIndex;
+				int bits = SP_PROPERTY_PHYSICSCONSTRAINT_INERTIA << (timeline->type - SP_TIMELINE_PHYSICSCONSTRAINT_INERTIA);
+				if (index != -1)
+					ADD(POSE_PHYSICS, index, bits);
+				else {
+					/* Keys the constraints whose value is global. */
+					for (ii = 0; ii < data->physicsConstraintsCount; ++ii) {
+						spPhysicsConstraintData *constraint = data->physicsConstraints[ii];
+						int globals[] = {constraint->inertiaGlobal, constraint->strengthGlobal, constraint->dampingGlobal,
+										 constraint->massGlobal, constraint->windGlobal, constraint->gravityGlobal,
+										 constraint->mixGlobal};
+						if (globals[timeline->type - SP_TIMELINE_PHYSICSCONSTRAINT_INERTIA]) ADD(POSE_PHYSICS, ii, bits);
+					}
+				}
+				break;
+			}
+			case SP_TIMELINE_DRAWORDER:
+				self->drawOrder = -1;
+				break;
+			default:
+				/* Events and physics resets happen when time passes a key, not at a time. */
+				break;
+		}
+	}
+#undef ADD
+#undef BONE
+#undef SLOT
+
+	for (i = 0; i < self->targetsCount; ++i) {
+		if (self->targets[i].kind == POSE_SLOT) self->slotsCount++;
+		self->valuesCount += _valuesCount[self->targets[i].kind];
+	}
+	for (i = 0; i < 6; ++i) FREE(properties[i]);
+	self->size = sizeof(_spPoseLayout) + sizeof(_spPoseTarget) * capacity;
+	return self;
+}
+
+static void _spPoseLayout_dispose(_spPoseLayout *self) {
+	FREE(self->targets);
+	FREE(self);
+}
+
+/**/
+
+static unsigned int _hashKey(spAnimation *animation, spSkin *skin, int bucket) {
+	size_t hash = (size_t) animation * 31 + (size_t) skin;
+	hash = (hash ^ (hash >> 16)) * 0x45d9f3b;
+	return (unsigned int) (hash ^ (hash >> 16)) + (unsigned int) bucket * 2654435761u;
+}
+
+static _spPoseEntry **_spPoseCache_findChain(_spPoseCache *self, spAnimation *animation, spSkin *skin, int bucket) {
+	_spPoseEntry **chain = &self->buckets[_hashKey(animation, skin, bucket) & self->bucketsMask];
+	while (*chain && ((*chain)->animation != animation || (*chain)->skin != skin || (*chain)->bucket != bucket))
+		chain = &(*chain)->chain;
+	return chain;
+}
+
+static void _spPoseCache_unlink(_spPoseCache *self, _spPoseEntry *entry) {
+	if (entry->prev)
+		entry->prev->next = entry->next;
+	else
+		self->first = entry->next;
+	if (entry->next)
+		entry->next->prev = entry->prev;
+	else
+		self->last = entry->prev;
+}
+
+static void _spPoseCache_linkFirst(_spPoseCache *self, _spPoseEntry *entry) {
+	entry->prev = 0;
+	entry->next = self->first;
+	if (self->first)
+		self->first->prev = entry;
+	else
+		self->last = entry;
+	self->first = entry;
+}
+
+/* Frees the entry, and its layout once no entry uses it. */
+static void _spPoseCache_release(_spPoseCache *self, _spPoseEntry *entry) {
+	_spPoseLayout *layout = entry->layout, **link;
+	FREE(entry);
+	if (--layout->entriesCount) return;
+	for (link = &self->layouts; *link != layout; link = &(*link)->next)
+		;
+	*link = layout->next;
+	self->super.bytes -= layout->size;
+	_spPoseLayout_dispose(layout);
+}
+
+static void _spPoseCache_remove(_spPoseCache *self, _spPoseEntry *entry) {
+	*_spPoseCache_findChain(self, entry->animation, entry->skin, entry->bucket) = entry->chain;
+	_spPoseCache_unlink(self, entry);
+	self->super.entriesCount--;
+	self->super.bytes -= entry->size;
+	_spPoseCache_release(self, entry);
+}
+
+static void _spPoseCache_insert(_spPoseCache *self, _spPoseEntry *entry) {
+	_spPoseEntry **chain;
+	if (self->super.entriesCount >= self->bucketsMask + 1) {
+		/* Rehash into twice the buckets. */
+		_spPoseEntry *other;
+		FREE(self->buckets);
+		self->bucketsMask = (self->bucketsMask << 1) | 1;
+		self->buckets = CALLOC(_spPoseEntry *, self->bucketsMask + 1);
+		for (other = self->first; other; other = other->next) {
+			chain = &self->buckets[_hashKey(other->animation, other->skin, other->bucket) & self->bucketsMask];
+			other->chain = *chain;
+			*chain = other;
+		}
+	}
+	chain = &self->buckets[_hashKey(entry->animation, entry->skin, entry->bucket) & self->bucketsMask];
+	entry->chain = *chain;
+	*chain = entry;
+	_spPoseCache_linkFirst(self, entry);
+	self->super.entriesCount++;
+	self->super.bytes += entry->size;
+}
+
+/* Copies the pose the layout's targets have in the sampling skeleton into a new entry. */
+static _spPoseEntry *_spPoseCache_record(_spPoseCache *self, _spPoseLayout *layout) {
+	spSkeleton *skeleton = self->skeleton;
+	_spPoseEntry *entry;
+	float *values;
+	int i, deformCount = 0, slot = 0;
+	size_t size;
+	for (i = 0; i < layout->targetsCount; ++i)
+		if (layout->targets[i].properties & SP_PROPERTY_DEFORM) deformCount += skeleton->slots[layout->targets[i].index]->deformCount;
+	size = sizeof(_spPoseEntry) + sizeof(spAttachment *) * layout->slotsCount +
+		   sizeof(int) * (layout->drawOrder ? skeleton->slotsCount : 0) + sizeof(float) * (layout->valuesCount + deformCount);
+	entry = (_spPoseEntry *) MALLOC(char, size);
+	memset(entry, 0, sizeof(_spPoseEntry));
+	entry->layout = layout;
+	layout->entriesCount++;
+	entry->size = size;
+	entry->attachments = (spAttachment **) (entry + 1);
+	entry->drawOrder = (int *) (entry->attachments + layout->slotsCount);
+	entry->values = values = (float *) (entry->drawOrder + (layout->drawOrder ? skeleton->slotsCount : 0));
+
+	for (i = 0; i < layout->targetsCount; ++i) {
+		_spPoseTarget *target = layout->targets + i;
+		switch (target->kind) {
+			case POSE_BONE: {
+				spBone *bone = skeleton->bones[target->index];
+				values[0] = bone->x;
+				values[1] = bone->y;
+				values[2] = bone->rotation;
+				values[3] = bone->scaleX;
+				values[4] = bone->scaleY;
+				values[5] = bone->shearX;
+				values[6] = bone->shearY;
+				values[7] = (float) bone->inherit;
+				break;
+			}
+			case POSE_SLOT: {
+				spSlot *s = skeleton->slots[target->index];
+				values[0] = s->color.r;
+				values[1] = s->color.g;
+				values[2] = s->color.b;
+				values[3] = s->color.a;
+				if (s->darkColor) {
+					values[4] = s->darkColor->r;
+					values[5] = s->darkColor->g;
+					values[6] = s->darkColor->b;
+				}
+				values[7] = (float) s->sequenceIndex;
+				values[8] = (float) (target->properties & SP_PROPERTY_DEFORM ? s->deformCount : 0);
+				entry->attachments[slot++] = s->attachment;
+				break;
+			}
+			case POSE_IK: {
+				spIkConstraint *constraint = skeleton->ikConstraints[target->index];
+				values[0] = constraint->mix;
+				values[1] = constraint->softness;
+				values[2] = (float) constraint->bendDirection;
+				values[3] = (float) constraint->compress;
+				values[4] = (float) constraint->stretch;
+				break;
+			}
+			case POSE_TRANSFORM: {
+				spTransformConstraint *constraint = skeleton->transformConstraints[target->index];
+				values[0] = constraint->mixRotate;
+				values[1] = constraint->mixX;
+				values[2] = constraint->mixY;
+				values[3] = constraint->mixScaleX;
+				values[4] = constraint->mixScaleY;
+				values[5] = constraint->mixShearY;
+				break;
+			}
+			case POSE_PATH: {
+				spPathConstraint *constraint = skeleton->pathConstraints[target->index];
+				values[0] = constraint->position;
+				values[1] = constraint->spacing;
+				values[2] = constraint->mixRotate;
+				values[3] = constraint->mixX;
+				values[4] = constraint->mixY;
+				break;
+			}
+			case POSE_PHYSICS: {
+				spPhysicsConstraint *constraint = skeleton->physicsConstraints[target->index];
+				values[0] = constraint->inertia;
+				values[1] = constraint->strength;
+				values[2] = constraint->damping;
+				values[3] = constraint->massInverse;
+				values[4] = constraint->wind;
+				values[5] = constraint->gravity;
+				values[6] = constraint->mix;
+				break;
+			}
+		}
+		values += _valuesCount[target->kind];
+	}
+	for (i = 0; i < layout->targetsCount; ++i) {
+		spSlot *s;
+		if (!(layout->targets[i].properties & SP_PROPERTY_DEFORM)) continue;
+		s = skeleton->slots[layout->targets[i].index];
+		memcpy(values, s->deform, sizeof(float) * s->deformCount);
+		values += s->deformCount;
+	}
+	if (layout->drawOrder) {
+		for (i = 0; i < skeleton->slotsCount; ++i)
+			entry->drawOrder[i] = skeleton->drawOrder[i]->data->index;
+	}
+	return entry;
+}
+
+/* Returns the setup vertices the deform of the slot's attachment is relative to, or 0 for weighted vertices, which deform
+ * by offsets. */
+static const float *_getSetupVertices(spSlot *slot, int deformCount) {
+	spVertexAttachment *attachment;
+	if (!slot->attachment) return 0;
+	switch (slot->attachment->type) {
+		case SP_ATTACHMENT_BOUNDING_BOX:
+		case SP_ATTACHMENT_CLIPPING:
+		case SP_ATTACHMENT_MESH:
+		case SP_ATTACHMENT_PATH:
+			attachment = SUB_CAST(spVertexAttachment, slot->attachment);
+			return attachment->bones || attachment->verticesCount != deformCount ? 0 : attachment->vertices;
+		default:
+			return 0;
+	}
+}
+
+#define MIX(FROM, TO) (alpha == 1 ? (TO) : (FROM) + ((TO) - (FROM)) * alpha)
+
+static void _spPoseEntry_apply(const _spPoseEntry *self, spSkeleton *skeleton, float alpha) {
+	_spPoseLayout *layout = self->layout;
+	const float *values = self->values, *deform = self->values + layout->valuesCount;
+	int i, ii, slot = 0;
+	for (i = 0; i < layout->targetsCount; ++i) {
+		_spPoseTarget *target = layout->targets + i;
+		int properties = target->properties;
+		switch (target->kind) {
+			case POSE_BONE: {
+				spBone *bone = skeleton->bones[target->index];
+				if (properties & SP_PROPERTY_X) bone->x = MIX(bone->x, values[0]);
+				if (properties & SP_PROPERTY_Y) bone->y = MIX(bone->y, values[1]);
+				if (properties & SP_PROPERTY_ROTATE) bone->rotation = MIX(bone->rotation, values[2]);
+				if (properties & SP_PROPERTY_SCALEX) bone->scaleX = MIX(bone->scaleX, values[3]);
+				if (properties & SP_PROPERTY_SCALEY) bone->scaleY = MIX(bone->scaleY, values[4]);
+				if (properties & SP_PROPERTY_SHEARX) bone->shearX = MIX(bone->shearX, values[5]);
+				if (properties & SP_PROPERTY_SHEARY) bone->shearY = MIX(bone->shearY, values[6]);
+				if (properties & SP_PROPERTY_INHERIT) bone->inherit = (spInherit) values[7];
+				break;
+			}
+			case POSE_SLOT: {
+				spSlot *s = skeleton->slots[target->index];
+				int deformCount = (int) values[8];
+				if (properties & SP_PROPERTY_RGB) {
+					s->color.r = MIX(s->color.r, values[0]);
+					s->color.g = MIX(s->color.g, values[1]);
+					s->color.b = MIX(s->color.b, values[2]);
+				}
+				if (properties & SP_PROPERTY_ALPHA) s->color.a = MIX(s->color.a, values[3]);
+				if (properties & SP_PROPERTY_RGB2 && s->darkColor) {
+					s->darkColor->r = MIX(s->darkColor->r, values[4]);
+					s->darkColor->g = MIX(s->darkColor->g, values[5]);
+					s->darkColor->b = MIX(s->darkColor->b, values[6]);
+				}
+				if (properties & SP_PROPERTY_ATTACHMENT) spSlot_setAttachment(s, self->attachments[slot]);
+				slot++;
+				if (properties & SP_PROPERTY_SEQUENCE) s->sequenceIndex = (int) values[7];
+				if (properties & SP_PROPERTY_DEFORM) {
+					if (s->deformCapacity < deformCount) {
+						/* Only if the slot data's deformCapacity is out of date. */
+						FREE(s->deform);
+						s->deform = MALLOC(float, deformCount);
+						s->deformCapacity = deformCount;
+						s->deformCount = 0;
+					}
+					if (alpha == 1)
+						memcpy(s->deform, deform, sizeof(float) * deformCount);
+					else if (s->deformCount == deformCount) {
+						for (ii = 0; ii < deformCount; ++ii)
+							s->deform[ii] += (deform[ii] - s->deform[ii]) * alpha;
+					} else {
+						/* Mixed from the setup pose, as spDeformTimeline does when the slot has no deform. */
+						const float *setupVertices = _getSetupVertices(s, deformCount);
+						for (ii = 0; ii < deformCount; ++ii)
+							s->deform[ii] = setupVertices ? setupVertices[ii] + (deform[ii] - setupVertices[ii]) * alpha
+														  : deform[ii] * alpha;
+					}
+					s->deformCount = deformCount;
+					deform += deformCount;
+				}
+				break;
+			}
+			case POSE_IK: {
+				spIkConstraint *constraint = skeleton->ikConstraints[target->index];
+				constraint->mix = MIX(constraint->mix, values[0]);
+				constraint->softness = MIX(constraint->softness, values[1]);
+				constraint->bendDirection = (int) values[2];
+				constraint->compress = (int) values[3];
+				constraint->stretch = (int) values[4];
+				break;
+			}
+			case POSE_TRANSFORM: {
+				spTransformConstraint *constraint = skeleton->transformConstraints[target->index];
+				constraint->mixRotate = MIX(constraint->mixRotate, values[0]);
+				constraint->mixX = MIX(constraint->mixX, values[1]);
+				constraint->mixY = MIX(constraint->mixY, values[2]);
+				constraint->mixScaleX = MIX(constraint->mixScaleX, values[3]);
+				constraint->mixScaleY = MIX(constraint->mixScaleY, values[4]);
+				constraint->mixShearY = MIX(constraint->mixShearY, values[5]);
+				break;
+			}
+			case POSE_PATH: {
+				spPathConstraint *constraint = skeleton->pathConstraints[target->index];
+				if (properties & SP_PROPERTY_PATHCONSTRAINT_POSITION)
+					constraint->position = MIX(constraint->position, values[0]);
+				if (properties & SP_PROPERTY_PATHCONSTRAINT_SPACING)
+					constraint->spacing = MIX(constraint->spacing, values[1]);
+				if (properties & SP_PROPERTY_PATHCONSTRAINT_MIX) {
+					constraint->mixRotate = MIX(constraint->mixRotate, values[2]);
+					constraint->mixX = MIX(constraint->mixX, values[3]);
+					constraint->mixY = MIX(constraint->mixY, values[4]);
+				}
+				break;
+			}
+			case POSE_PHYSICS: {
+				spPhysicsConstraint *constraint = skeleton->physicsConstraints[target->index];
+				if (properties & SP_PROPERTY_PHYSICSCONSTRAINT_INERTIA)
+					constraint->inertia = MIX(constraint->inertia, values[0]);
+				if (properties & SP_PROPERTY_PHYSICSCONSTRAINT_STRENGTH)
+					constraint->strength = MIX(constraint->strength, values[1]);
+				if (properties & SP_PROPERTY_PHYSICSCONSTRAINT_DAMPING)
+					constraint->damping = MIX(constraint->damping, values[2]);
+				if (properties & SP_PROPERTY_PHYSICSCONSTRAINT_MASS)
+					constraint->massInverse = MIX(constraint->massInverse, values[3]);
+				if (properties & SP_PROPERTY_PHYSICSCONSTRAINT_WIND)
+					constraint->wind = MIX(constraint->wind, values[4]);
+				if (properties & SP_PROPERTY_PHYSICSCONSTRAINT_GRAVITY)
+					constraint->gravity = MIX(constraint->gravity, values[5]);
+				if (properties & SP_PROPERTY_PHYSICSCONSTRAINT_MIX)
+					constraint->mix = MIX(constraint->mix, values[6]);
+				break;
+			}
+		}
+		values += _valuesCount[target->kind];
+	}
+	if (layout->drawOrder) {
+		for (i = 0; i < skeleton->slotsCount; ++i)
+			skeleton->drawOrder[i] = skeleton->slots[self->drawOrder[i]];
+	}
+}
+
+#undef MIX
+
+/**/
+
+spPoseCache *spPoseCache_create(spSkeletonData *data, float fps, size_t maxBytes) {
+	_spPoseCache *internal = NEW(_spPoseCache);
+	spPoseCache *self = SUPER(internal);
+	self->data = data;
+	self->fps = fps;
+	self->maxBytes = maxBytes;
+	internal->skeleton = spSkeleton_create(data);
+	internal->bucketsMask = 63;
+	internal->buckets = CALLOC(_spPoseEntry *, internal->bucketsMask + 1);
+	return self;
+}
+
+void spPoseCache_dispose(spPoseCache *self) {
+	_spPoseCache *internal = SUB_CAST(_spPoseCache, self);
+	spPoseCache_clear(self);
+	spSkeleton_dispose(internal->skeleton);
+	FREE(internal->buckets);
+	FREE(internal);
+}
+
+void spPoseCache_clear(spPoseCache *self) {
+	_spPoseCache *internal = SUB_CAST(_spPoseCache, self);
+	_spPoseEntry *entry = internal->first, *next;
+	_spPoseLayout *layout = internal->layouts, *nextLayout;
+	while (entry) {
+		next = entry->next;
+		FREE(entry);
+		entry = next;
+	}
+	while (layout) {
+		nextLayout = layout->next;
+		_spPoseLayout_dispose(layout);
+		layout = nextLayout;
+	}
+	internal->first = internal->last = 0;
+	internal->layouts = 0;
+	memset(internal->buckets, 0, sizeof(_spPoseEntry *) * (internal->bucketsMask + 1));
+	self->entriesCount = 0;
+	self->bytes = 0;
+}
+
+void spPoseCache_apply(spPoseCache *self, spSkeleton *skeleton, spAnimation *animation, float time, int /*boolean*/ loop,
+					   float alpha) {
+	_spPoseCache *internal = SUB_CAST(_spPoseCache, self);
+	_spPoseEntry **chain, *entry;
+	_spPoseLayout *layout;
+	int bucket;
+
+	if (loop && animation->duration != 0) time = FMOD(time, animation->duration);
+	if (time < 0) time = 0;
+	if (self->fps > 0) {
+		/* Past the end, the animation holds the pose of its last key. */
+		time = MIN(time, animation->duration);
+		bucket = (int) (time * self->fps);
+		time = MIN(bucket / self->fps, animation->duration);
+	} else
+		memcpy(&bucket, &time, sizeof(int));
+
+	chain = _spPoseCache_findChain(internal, animation, skeleton->skin, bucket);
+	entry = *chain;
+	if (entry) {
+		self->hits++;
+		if (entry != internal->first) {
+			_spPoseCache_unlink(internal, entry);
+			_spPoseCache_linkFirst(internal, entry);
+		}
+		_spPoseEntry_apply(entry, skeleton, alpha);
+		return;
+	}
+
+	self->misses++;
+	for (layout = internal->layouts; layout; layout = layout->next)
+		if (layout->animation == animation) break;
+	if (!layout) {
+		layout = _spPoseLayout_create(self->data, animation);
+		layout->next = internal->layouts;
+		internal->layouts = layout;
+		self->bytes += layout->size;
+	}
+	spSkeleton_setSkin(internal->skeleton, skeleton->skin);
+	spSkeleton_setToSetupPose(internal->skeleton);
+	spAnimation_apply(animation, internal->skeleton, time, time, 0, 0, 0, 1, SP_MIX_BLEND_SETUP, SP_MIX_DIRECTION_IN);
+	entry = _spPoseCache_record(internal, layout);
+	entry->animation = animation;
+	entry->skin = skeleton->skin;
+	entry->bucket = bucket;
+	_spPoseEntry_apply(entry, skeleton, alpha);
+
+	/* The entry's layout stays counted while the entry is kept, so evicting the others makes room for both. */
+	if (entry->size + layout->size > self->maxBytes) {
+		_spPoseCache_release(internal, entry);
+		return;
+	}
+	while (self->bytes + entry->size > self->maxBytes) {
+		_spPoseCache_remove(internal, internal->last);
+		self->evictions++;
+	}
+	_spPoseCache_insert(internal, entry);
+}
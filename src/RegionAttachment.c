@@ -78,29 +78,29 @@ spRegionAttachment *spRegionAttachment_create(const char *name) {
 	return self;
 }
 
-void spRegionAttachment_updateRegion(spRegionAttachment *self) {
+static void _spRegionAttachment_computeRegion(spRegionAttachment *self, spTextureRegion *region, float *offset, float *uvs) {
 	float regionScaleX, regionScaleY, localX, localY, localX2, localY2;
 	float radians, cosine, sine;
 	float localXCos, localXSin, localYCos, localYSin, localX2Cos, localX2Sin, localY2Cos, localY2Sin;
 
-	if (self->region == NULL) {
-		self->uvs[0] = 0;
-		self->uvs[1] = 0;
-		self->uvs[2] = 1;
-		self->uvs[3] = 1;
-		self->uvs[4] = 1;
-		self->uvs[5] = 0;
-		self->uvs[6] = 0;
-		self->uvs[7] = 0;
+	if (region == NULL) {
+		uvs[0] = 0;
+		uvs[1] = 0;
+		uvs[2] = 1;
+		uvs[3] = 1;
+		uvs[4] = 1;
+		uvs[5] = 0;
+		uvs[6] = 0;
+		uvs[7] = 0;
 		return;
 	}
 
-	regionScaleX = self->width / self->region->originalWidth * self->scaleX;
-	regionScaleY = self->height / self->region->originalHeight * self->scaleY;
-	localX = -self->width / 2 * self->scaleX + self->region->offsetX * regionScaleX;
-	localY = -self->height / 2 * self->scaleY + self->region->offsetY * regionScaleY;
-	localX2 = localX + self->region->width * regionScaleX;
-	localY2 = localY + self->region->height * regionScaleY;
+	regionScaleX = self->width / region->originalWidth * self->scaleX;
+	regionScaleY = self->height / region->originalHeight * self->scaleY;
+	localX = -self->width / 2 * self->scaleX + region->offsetX * regionScaleX;
+	localY = -self->height / 2 * self->scaleY + region->offsetY * regionScaleY;
+	localX2 = localX + region->width * regionScaleX;
+	localY2 = localY + region->height * regionScaleY;
 	radians = self->rotation * DEG_RAD;
 	cosine = COS(radians), sine = SIN(radians);
 	localXCos = localX * cosine + self->x;
@@ -112,34 +112,69 @@ void spRegionAttachment_updateRegion(spRegionAttachment *self) {
 	localY2Cos = localY2 * cosine + self->y;
 	localY2Sin = localY2 * sine;
 
-	self->offset[BLX] = localXCos - localYSin;
-	self->offset[BLY] = localYCos + localXSin;
-	self->offset[ULX] = localXCos - localY2Sin;
-	self->offset[ULY] = localY2Cos + localXSin;
-	self->offset[URX] = localX2Cos - localY2Sin;
-	self->offset[URY] = localY2Cos + localX2Sin;
-	self->offset[BRX] = localX2Cos - localYSin;
-	self->offset[BRY] = localYCos + localX2Sin;
-
-	if (self->region->degrees == 90) {
-		self->uvs[URX] = self->region->u;
-		self->uvs[URY] = self->region->v2;
-		self->uvs[BRX] = self->region->u;
-		self->uvs[BRY] = self->region->v;
-		self->uvs[BLX] = self->region->u2;
-		self->uvs[BLY] = self->region->v;
-		self->uvs[ULX] = self->region->u2;
-		self->uvs[ULY] = self->region->v2;
+	offset[BLX] = localXCos - localYSin;
+	offset[BLY] = localYCos + localXSin;
+	offset[ULX] = localXCos - localY2Sin;
+	offset[ULY] = localY2Cos + localXSin;
+	offset[URX] = localX2Cos - localY2Sin;
+	offset[URY] = localY2Cos + localX2Sin;
+	offset[BRX] = localX2Cos - localYSin;
+	offset[BRY] = localYCos + localX2Sin;
+
+	if (region->degrees == 90) {
+		uvs[URX] = region->u;
+		uvs[URY] = region->v2;
+		uvs[BRX] = region->u;
+		uvs[BRY] = region->v;
+		uvs[BLX] = region->u2;
+		uvs[BLY] = region->v;
+		uvs[ULX] = region->u2;
+		uvs[ULY] = region->v2;
 	} else {
-		self->uvs[ULX] = self->region->u;
-		self->uvs[ULY] = self->region->v2;
-		self->uvs[URX] = self->region->u;
-		self->uvs[URY] = self->region->v;
-		self->uvs[BRX] = self->region->u2;
-		self->uvs[BRY] = self->region->v;
-		self->uvs[BLX] = self->region->u2;
-		self->uvs[BLY] = self->region->v2;
+		uvs[ULX] = region->u;
+		uvs[ULY] = region->v2;
+		uvs[URX] = region->u;
+		uvs[URY] = region->v;
+		uvs[BRX] = region->u2;
+		uvs[BRY] = region->v;
+		uvs[BLX] = region->u2;
+		uvs[BLY] = region->v2;
+	}
+}
+
+void spRegionAttachment_updateRegion(spRegionAttachment *self) {
+	spSequence *sequence = self->sequence;
+	if (sequence) {
+		/* Compute every region of the sequence once, so spRegionAttachment_computeWorldVertices and the getters only
+		 * read the attachment. The attachment itself shows the setup region. */
+		int i, n = sequence->regions->size;
+		FREE(sequence->uvs);
+		FREE(sequence->offsets);
+		sequence->uvsCount = 8;
+		sequence->uvs = CALLOC(float, n * 8);
+		sequence->offsets = CALLOC(float, n * 8);
+		for (i = 0; i < n; i++)
+			_spRegionAttachment_computeRegion(self, sequence->regions->items[i], sequence->offsets + i * 8,
+											  sequence->uvs + i * 8);
+		if (n > 0) {
+			i = MIN(sequence->setupIndex, n - 1);
+			self->region = sequence->regions->items[i];
+			self->rendererObject = self->region;
+		}
 	}
+	_spRegionAttachment_computeRegion(self, self->region, self->offset, self->uvs);
+}
+
+float *spRegionAttachment_getUVs(spRegionAttachment *self, spSlot *slot) {
+	spSequence *sequence = self->sequence;
+	if (!sequence || !sequence->uvs) return self->uvs;
+	return sequence->uvs + spSequence_resolveIndex(sequence, slot) * 8;
+}
+
+void *spRegionAttachment_getRendererObject(spRegionAttachment *self, spSlot *slot) {
+	spSequence *sequence = self->sequence;
+	if (!sequence || !sequence->uvs) return self->rendererObject;
+	return sequence->regions->items[spSequence_resolveIndex(sequence, slot)];
 }
 
 void spRegionAttachment_computeWorldVertices(spRegionAttachment *self, spSlot *slot, float *vertices, int offset,
@@ -149,7 +184,8 @@ void spRegionAttachment_computeWorldVertices(spRegionAttachment *self, spSlot *s
 	float x = bone->worldX, y = bone->worldY;
 	float offsetX, offsetY;
 
-	if (self->sequence) spSequence_apply(self->sequence, slot, SUPER(self));
+	if (self->sequence && self->sequence->offsets)
+		offsets = self->sequence->offsets + spSequence_resolveIndex(self->sequence, slot) * 8;
 
 	offsetX = offsets[BRX];
 	offsetY = offsets[BRY];
@@ -33,11 +33,11 @@
 
 _SP_ARRAY_IMPLEMENT_TYPE(spTextureRegionArray, spTextureRegion *)
 
-static int nextSequenceId = 0;
+static volatile long nextSequenceId = 0;
 
 spSequence *spSequence_create(int numRegions) {
 	spSequence *self = NEW(spSequence);
-	self->id = nextSequenceId++;
+	self->id = _spNextId(&nextSequenceId);
 	self->regions = spTextureRegionArray_create(numRegions);
 	spTextureRegionArray_setSize(self->regions, numRegions);
 	return self;
@@ -45,6 +45,8 @@ spSequence *spSequence_create(int numRegions) {
 
 void spSequence_dispose(spSequence *self) {
 	FREE(self->regions);
+	FREE(self->uvs);
+	FREE(self->offsets);
 	FREE(self);
 }
 
@@ -56,31 +58,48 @@ spSequence *spSequence_copy(spSequence *self) {
 	copy->start = self->start;
 	copy->digits = self->digits;
 	copy->setupIndex = self->setupIndex;
+	copy->uvsCount = self->uvsCount;
+	if (self->uvs) {
+		copy->uvs = MALLOC(float, self->regions->size * self->uvsCount);
+		memcpy(copy->uvs, self->uvs, sizeof(float) * self->regions->size * self->uvsCount);
+	}
+	if (self->offsets) {
+		copy->offsets = MALLOC(float, self->regions->size * 8);
+		memcpy(copy->offsets, self->offsets, sizeof(float) * self->regions->size * 8);
+	}
 	return copy;
 }
 
-void spSequence_apply(spSequence *self, spSlot *slot, spAttachment *attachment) {
+int spSequence_resolveIndex(spSequence *self, spSlot *slot) {
 	int index = slot->sequenceIndex;
-	spTextureRegion *region = NULL;
 	if (index == -1) index = self->setupIndex;
 	if (index >= (int) self->regions->size) index = self->regions->size - 1;
-	region = self->regions->items[index];
+	return index;
+}
+
+void spSequence_apply(spSequence *self, spSlot *slot, spAttachment *attachment) {
+	int index = spSequence_resolveIndex(self, slot);
+	spTextureRegion *region = self->regions->items[index];
 
 	if (attachment->type == SP_ATTACHMENT_REGION) {
 		spRegionAttachment *regionAttachment = (spRegionAttachment *) attachment;
+		/* The tables are computed on first use if the attachment's loader did not compute them. */
+		if (!self->offsets) spRegionAttachment_updateRegion(regionAttachment);
 		if (regionAttachment->region != region) {
 			regionAttachment->rendererObject = region;
 			regionAttachment->region = region;
-			spRegionAttachment_updateRegion(regionAttachment);
+			memcpy(regionAttachment->offset, self->offsets + index * 8, sizeof(float) * 8);
+			memcpy(regionAttachment->uvs, self->uvs + index * 8, sizeof(float) * 8);
 		}
 	}
 
 	if (attachment->type == SP_ATTACHMENT_MESH) {
 		spMeshAttachment *meshAttachment = (spMeshAttachment *) attachment;
+		if (!self->uvs) spMeshAttachment_updateRegion(meshAttachment);
 		if (meshAttachment->region != region) {
 			meshAttachment->rendererObject = region;
 			meshAttachment->region = region;
-			spMeshAttachment_updateRegion(meshAttachment);
+			memcpy(meshAttachment->uvs, self->uvs + index * self->uvsCount, sizeof(float) * self->uvsCount);
 		}
 	}
 }
@@ -29,36 +29,68 @@
 
 #include <spine/Skeleton.h>
 #include <spine/extension.h>
+#include <stddef.h>
 #include <stdlib.h>
 #include <string.h>
 
-typedef enum {
-	SP_UPDATE_BONE,
-	SP_UPDATE_IK_CONSTRAINT,
-	SP_UPDATE_PATH_CONSTRAINT,
-	SP_UPDATE_TRANSFORM_CONSTRAINT,
-	SP_UPDATE_PHYSICS_CONSTRAINT
-} _spUpdateType;
-
-typedef struct {
-	_spUpdateType type;
-	void *object;
-} _spUpdate;
-
+/* Memory for the objects of a skeleton, either carved from one block or allocated one by one when base is 0. */
 typedef struct {
-	spSkeleton super;
+	char *base;
+	size_t size;
+} _spSkeletonBlock;
+
+#define BLOCK_ALIGNMENT 16
+#define BLOCK_ALIGN(SIZE) (((SIZE) + (BLOCK_ALIGNMENT - 1)) & ~(size_t) (BLOCK_ALIGNMENT - 1))
+
+static void *_takeBlock(_spSkeletonBlock *block, size_t size) {
+	void *memory;
+	if (!block->base) return CALLOC(char, size);
+	memory = block->base + block->size;
+	block->size += BLOCK_ALIGN(size);
+	return memory;
+}
 
-	int updateCacheCount;
-	int updateCacheCapacity;
-	_spUpdate *updateCache;
-} _spSkeleton;
+#define TAKE(BLOCK, TYPE, COUNT) ((TYPE *) _takeBlock(BLOCK, sizeof(TYPE) * (COUNT)))
 
-spSkeleton *spSkeleton_create(spSkeletonData *data) {
+size_t spSkeleton_getBlockSize(const spSkeletonData *data) {
 	int i;
-	int *childrenCounts;
+	size_t size = BLOCK_ALIGN(sizeof(_spSkeleton));
+	size += BLOCK_ALIGN(sizeof(spBone *) * data->bonesCount);
+	size += BLOCK_ALIGN(sizeof(spBone) * data->bonesCount);
+	size += BLOCK_ALIGN(sizeof(spBone *) * data->bonesCount);
+	size += BLOCK_ALIGN(sizeof(_spBonePose) * data->bonesCount);
+
+	size += BLOCK_ALIGN(sizeof(spSlot *) * data->slotsCount) * 2;
+	for (i = 0; i < data->slotsCount; ++i) {
+		size += BLOCK_ALIGN(sizeof(spSlot));
+		if (data->slots[i]->darkColor) size += BLOCK_ALIGN(sizeof(spColor));
+	}
+
+	size += BLOCK_ALIGN(sizeof(spIkConstraint *) * data->ikConstraintsCount);
+	for (i = 0; i < data->ikConstraintsCount; ++i)
+		size += BLOCK_ALIGN(sizeof(spIkConstraint)) + BLOCK_ALIGN(sizeof(spBone *) * data->ikConstraints[i]->bonesCount);
+
+	size += BLOCK_ALIGN(sizeof(spTransformConstraint *) * data->transformConstraintsCount);
+	for (i = 0; i < data->transformConstraintsCount; ++i)
+		size += BLOCK_ALIGN(sizeof(spTransformConstraint)) +
+				BLOCK_ALIGN(sizeof(spBone *) * data->transformConstraints[i]->bonesCount);
+
+	size += BLOCK_ALIGN(sizeof(spPathConstraint *) * data->pathConstraintsCount);
+	for (i = 0; i < data->pathConstraintsCount; ++i)
+		size += BLOCK_ALIGN(sizeof(spPathConstraint)) +
+				BLOCK_ALIGN(sizeof(spBone *) * data->pathConstraints[i]->bonesCount);
+
+	size += BLOCK_ALIGN(sizeof(spPhysicsConstraint *) * data->physicsConstraintsCount);
+	size += BLOCK_ALIGN(sizeof(spPhysicsConstraint)) * data->physicsConstraintsCount;
+	return size;
+}
+
+static spSkeleton *_spSkeleton_create(spSkeletonData *data, _spSkeletonBlock *block) {
+	int i, ii;
 
-	_spSkeleton *internal = NEW(_spSkeleton);
+	_spSkeleton *internal = TAKE(block, _spSkeleton, 1);
 	spSkeleton *self = SUPER(internal);
+	internal->block = block->base;
 	self->data = data;
 	self->skin = NULL;
 	spColor_setFromFloats(&self->color, 1, 1, 1, 1);
@@ -67,25 +99,28 @@ spSkeleton *spSkeleton_create(spSkeletonData *data) {
 	self->time = 0;
 
 	self->bonesCount = self->data->bonesCount;
-	self->bones = MALLOC(spBone *, self->bonesCount);
-	childrenCounts = CALLOC(int, self->bonesCount);
+	self->bones = TAKE(block, spBone *, self->bonesCount);
+	internal->bonesBlock = TAKE(block, spBone, self->bonesCount);
+	internal->childrenBlock = TAKE(block, spBone *, self->bonesCount);
+	internal->lastPoses = TAKE(block, _spBonePose, self->bonesCount);
 
 	for (i = 0; i < self->bonesCount; ++i) {
 		spBoneData *boneData = self->data->bones[i];
-		spBone *newBone;
+		spBone *newBone = internal->bonesBlock + i;
 		if (!boneData->parent)
-			newBone = spBone_create(boneData, self, 0);
+			_spBone_init(newBone, boneData, self, 0);
 		else {
 			spBone *parent = self->bones[boneData->parent->index];
-			newBone = spBone_create(boneData, self, parent);
-			++childrenCounts[boneData->parent->index];
+			_spBone_init(newBone, boneData, self, parent);
+			++parent->childrenCount;
 		}
 		self->bones[i] = newBone;
 	}
-	for (i = 0; i < self->bonesCount; ++i) {
-		spBoneData *boneData = self->data->bones[i];
+	for (i = 0, ii = 0; i < self->bonesCount; ++i) {
 		spBone *bone = self->bones[i];
-		bone->children = MALLOC(spBone *, childrenCounts[boneData->index]);
+		bone->children = internal->childrenBlock + ii;
+		ii += bone->childrenCount;
+		bone->childrenCount = 0;
 	}
 	for (i = 0; i < self->bonesCount; ++i) {
 		spBone *bone = self->bones[i];
@@ -96,47 +131,219 @@ spSkeleton *spSkeleton_create(spSkeletonData *data) {
 	self->root = (self->bonesCount > 0 ? self->bones[0] : NULL);
 
 	self->slotsCount = data->slotsCount;
-	self->slots = MALLOC(spSlot *, self->slotsCount);
+	self->slots = TAKE(block, spSlot *, self->slotsCount);
+	self->drawOrder = TAKE(block, spSlot *, self->slotsCount);
 	for (i = 0; i < self->slotsCount; ++i) {
 		spSlotData *slotData = data->slots[i];
 		spBone *bone = self->bones[slotData->boneData->index];
-		self->slots[i] = spSlot_create(slotData, bone);
+		spSlot *slot = TAKE(block, spSlot, 1);
+		_spSlot_init(slot, slotData, bone, slotData->darkColor ? TAKE(block, spColor, 1) : 0);
+		self->slots[i] = slot;
 	}
-
-	self->drawOrder = MALLOC(spSlot *, self->slotsCount);
 	memcpy(self->drawOrder, self->slots, sizeof(spSlot *) * self->slotsCount);
 
 	self->ikConstraintsCount = data->ikConstraintsCount;
-	self->ikConstraints = MALLOC(spIkConstraint *, self->ikConstraintsCount);
-	for (i = 0; i < self->data->ikConstraintsCount; ++i)
-		self->ikConstraints[i] = spIkConstraint_create(self->data->ikConstraints[i], self);
+	self->ikConstraints = TAKE(block, spIkConstraint *, self->ikConstraintsCount);
+	for (i = 0; i < self->data->ikConstraintsCount; ++i) {
+		spIkConstraintData *constraintData = self->data->ikConstraints[i];
+		spIkConstraint *constraint = TAKE(block, spIkConstraint, 1);
+		_spIkConstraint_init(constraint, constraintData, self, TAKE(block, spBone *, constraintData->bonesCount));
+		self->ikConstraints[i] = constraint;
+	}
 
 	self->transformConstraintsCount = data->transformConstraintsCount;
-	self->transformConstraints = MALLOC(spTransformConstraint *, self->transformConstraintsCount);
-	for (i = 0; i < self->data->transformConstraintsCount; ++i)
-		self->transformConstraints[i] = spTransformConstraint_create(self->data->transformConstraints[i], self);
+	self->transformConstraints = TAKE(block, spTransformConstraint *, self->transformConstraintsCount);
+	for (i = 0; i < self->data->transformConstraintsCount; ++i) {
+		spTransformConstraintData *constraintData = self->data->transformConstraints[i];
+		spTransformConstraint *constraint = TAKE(block, spTransformConstraint, 1);
+		_spTransformConstraint_init(constraint, constraintData, self, TAKE(block, spBone *, constraintData->bonesCount));
+		self->transformConstraints[i] = constraint;
+	}
 
 	self->pathConstraintsCount = data->pathConstraintsCount;
-	self->pathConstraints = MALLOC(spPathConstraint *, self->pathConstraintsCount);
-	for (i = 0; i < self->data->pathConstraintsCount; i++)
-		self->pathConstraints[i] = spPathConstraint_create(self->data->pathConstraints[i], self);
+	self->pathConstraints = TAKE(block, spPathConstraint *, self->pathConstraintsCount);
+	for (i = 0; i < self->data->pathConstraintsCount; i++) {
+		spPathConstraintData *constraintData = self->data->pathConstraints[i];
+		spPathConstraint *constraint = TAKE(block, spPathConstraint, 1);
+		_spPathConstraint_init(constraint, constraintData, self, TAKE(block, spBone *, constraintData->bonesCount));
+		self->pathConstraints[i] = constraint;
+	}
 
 	self->physicsConstraintsCount = data->physicsConstraintsCount;
-	self->physicsConstraints = MALLOC(spPhysicsConstraint *, self->physicsConstraintsCount);
-	for (i = 0; i < self->data->physicsConstraintsCount; i++)
-		self->physicsConstraints[i] = spPhysicsConstraint_create(self->data->physicsConstraints[i], self);
+	self->physicsConstraints = TAKE(block, spPhysicsConstraint *, self->physicsConstraintsCount);
+	for (i = 0; i < self->data->physicsConstraintsCount; i++) {
+		spPhysicsConstraint *constraint = TAKE(block, spPhysicsConstraint, 1);
+		_spPhysicsConstraint_init(constraint, self->data->physicsConstraints[i], self);
+		self->physicsConstraints[i] = constraint;
+	}
 
+	spSkeleton_updateCache(self);
 
-	spColor_setFromFloats(&self->color, 1, 1, 1, 1);
+	return self;
+}
 
-	self->scaleX = 1;
-	self->scaleY = 1;
+spSkeleton *spSkeleton_create(spSkeletonData *data) {
+	_spSkeletonBlock block = {0, 0};
+	return _spSkeleton_create(data, &block);
+}
 
-	self->time = 0;
+spSkeleton *spSkeleton_createInBlock(spSkeletonData *data, void *memory) {
+	spSkeleton *self;
+	_spSkeletonBlock block;
+	int /*boolean*/ ownsBlock = !memory;
+	size_t size = spSkeleton_getBlockSize(data);
+	if (ownsBlock) memory = MALLOC(char, size);
+	memset(memory, 0, size);
+	block.base = (char *) memory;
+	block.size = 0;
+	self = _spSkeleton_create(data, &block);
+	SUB_CAST(_spSkeleton, self)->ownsBlock = ownsBlock;
+	return self;
+}
 
-	spSkeleton_updateCache(self);
+static int _indexOf(void *const *items, int count, const void *item) {
+	int i;
+	for (i = 0; i < count; ++i)
+		if (items[i] == item) return i;
+	return -1;
+}
+
+static void *_cloneUpdateObject(const spSkeleton *source, spSkeleton *self, const _spUpdate *update) {
+	switch (update->type) {
+		case SP_UPDATE_BONE:
+			return self->bones[((spBone *) update->object)->data->index];
+		case SP_UPDATE_IK_CONSTRAINT:
+			return self->ikConstraints[_indexOf((void *const *) source->ikConstraints, source->ikConstraintsCount,
+												update->object)];
+		case SP_UPDATE_TRANSFORM_CONSTRAINT:
+			return self->transformConstraints[_indexOf((void *const *) source->transformConstraints,
+													   source->transformConstraintsCount, update->object)];
+		case SP_UPDATE_PATH_CONSTRAINT:
+			return self->pathConstraints[_indexOf((void *const *) source->pathConstraints,
+												  source->pathConstraintsCount, update->object)];
+		case SP_UPDATE_PHYSICS_CONSTRAINT:
+			return self->physicsConstraints[_indexOf((void *const *) source->physicsConstraints,
+													 source->physicsConstraintsCount, update->object)];
+	}
+	return 0;
+}
+
+spSkeleton *spSkeleton_clone(const spSkeleton *source) {
+	return spSkeleton_cloneInBlock(source, 0);
+}
+
+spSkeleton *spSkeleton_cloneInBlock(const spSkeleton *source, void *memory) {
+	const _spSkeleton *sourceInternal = (const _spSkeleton *) source;
+	_spSkeleton *internal;
+	spSkeleton *self;
+	_spSkeletonBlock block;
+	int i, ii;
+
+	/* Same layout as _spSkeleton_create, but each object is copied from the source and its pointers relocated. */
+	block.base = (char *) (memory ? memory : MALLOC(char, spSkeleton_getBlockSize(source->data)));
+	block.size = 0;
+	internal = TAKE(&block, _spSkeleton, 1);
+	*internal = *sourceInternal;
+	self = SUPER(internal);
+	internal->block = block.base;
+	internal->ownsBlock = !memory;
+	internal->timelineCursor = 0;
+	internal->attachments = MALLOC(spAttachment *, internal->attachmentsCount);
+	memcpy(internal->attachments, sourceInternal->attachments, sizeof(spAttachment *) * internal->attachmentsCount);
+
+	self->bones = TAKE(&block, spBone *, self->bonesCount);
+	internal->bonesBlock = TAKE(&block, spBone, self->bonesCount);
+	internal->childrenBlock = TAKE(&block, spBone *, self->bonesCount);
+	internal->lastPoses = TAKE(&block, _spBonePose, self->bonesCount);
+	memcpy(internal->lastPoses, sourceInternal->lastPoses, sizeof(_spBonePose) * self->bonesCount);
+	for (i = 0; i < self->bonesCount; ++i) {
+		spBone *bone = internal->bonesBlock + i;
+		*bone = *source->bones[i];
+		bone->skeleton = self;
+		self->bones[i] = bone;
+	}
+	for (i = 0, ii = 0; i < self->bonesCount; ++i) {
+		spBone *bone = self->bones[i];
+		int c;
+		if (bone->parent) bone->parent = self->bones[bone->parent->data->index];
+		bone->children = internal->childrenBlock + ii;
+		for (c = 0; c < bone->childrenCount; ++c)
+			bone->children[c] = self->bones[source->bones[i]->children[c]->data->index];
+		ii += bone->childrenCount;
+	}
+	self->root = (self->bonesCount > 0 ? self->bones[0] : NULL);
+
+	self->slots = TAKE(&block, spSlot *, self->slotsCount);
+	self->drawOrder = TAKE(&block, spSlot *, self->slotsCount);
+	for (i = 0; i < self->slotsCount; ++i) {
+		spSlot *slot = TAKE(&block, spSlot, 1);
+		*slot = *source->slots[i];
+		slot->bone = self->bones[slot->bone->data->index];
+		if (slot->data->darkColor) {
+			slot->darkColor = TAKE(&block, spColor, 1);
+			*slot->darkColor = *source->slots[i]->darkColor;
+		}
+		if (slot->deform) {
+			slot->deform = MALLOC(float, slot->deformCapacity);
+			memcpy(slot->deform, source->slots[i]->deform, sizeof(float) * slot->deformCount);
+		}
+		self->slots[i] = slot;
+	}
+	for (i = 0; i < self->slotsCount; ++i)
+		self->drawOrder[i] = self->slots[source->drawOrder[i]->data->index];
+
+	self->ikConstraints = TAKE(&block, spIkConstraint *, self->ikConstraintsCount);
+	for (i = 0; i < self->ikConstraintsCount; ++i) {
+		spIkConstraint *constraint = TAKE(&block, spIkConstraint, 1);
+		*constraint = *source->ikConstraints[i];
+		constraint->bones = TAKE(&block, spBone *, constraint->bonesCount);
+		for (ii = 0; ii < constraint->bonesCount; ++ii)
+			constraint->bones[ii] = self->bones[source->ikConstraints[i]->bones[ii]->data->index];
+		constraint->target = self->bones[constraint->target->data->index];
+		self->ikConstraints[i] = constraint;
+	}
+
+	self->transformConstraints = TAKE(&block, spTransformConstraint *, self->transformConstraintsCount);
+	for (i = 0; i < self->transformConstraintsCount; ++i) {
+		spTransformConstraint *constraint = TAKE(&block, spTransformConstraint, 1);
+		*constraint = *source->transformConstraints[i];
+		constraint->bones = TAKE(&block, spBone *, constraint->bonesCount);
+		for (ii = 0; ii < constraint->bonesCount; ++ii)
+			constraint->bones[ii] = self->bones[source->transformConstraints[i]->bones[ii]->data->index];
+		constraint->target = self->bones[constraint->target->data->index];
+		self->transformConstraints[i] = constraint;
+	}
+
+	self->pathConstraints = TAKE(&block, spPathConstraint *, self->pathConstraintsCount);
+	for (i = 0; i < self->pathConstraintsCount; i++) {
+		spPathConstraint *constraint = TAKE(&block, spPathConstraint, 1);
+		*constraint = *source->pathConstraints[i];
+		constraint->bones = TAKE(&block, spBone *, constraint->bonesCount);
+		for (ii = 0; ii < constraint->bonesCount; ++ii)
+			constraint->bones[ii] = self->bones[source->pathConstraints[i]->bones[ii]->data->index];
+		constraint->target = self->slots[constraint->target->data->index];
+		/* Scratch buffers, reallocated on the next update. */
+		constraint->spacesCount = constraint->positionsCount = constraint->worldCount = 0;
+		constraint->curvesCount = constraint->lengthsCount = 0;
+		constraint->spaces = constraint->positions = constraint->world = constraint->curves = constraint->lengths = 0;
+		self->pathConstraints[i] = constraint;
+	}
 
-	FREE(childrenCounts);
+	self->physicsConstraints = TAKE(&block, spPhysicsConstraint *, self->physicsConstraintsCount);
+	for (i = 0; i < self->physicsConstraintsCount; i++) {
+		spPhysicsConstraint *constraint = TAKE(&block, spPhysicsConstraint, 1);
+		*constraint = *source->physicsConstraints[i];
+		constraint->skeleton = self;
+		constraint->bone = self->bones[constraint->bone->data->index];
+		self->physicsConstraints[i] = constraint;
+	}
+
+	internal->updateCache = MALLOC(_spUpdate, internal->updateCacheCapacity);
+	for (i = 0; i < internal->updateCacheCount; ++i) {
+		_spUpdate *update = internal->updateCache + i;
+		*update = sourceInternal->updateCache[i];
+		update->object = _cloneUpdateObject(source, self, update);
+	}
 
 	return self;
 }
@@ -146,9 +353,22 @@ void spSkeleton_dispose(spSkeleton *self) {
 	_spSkeleton *internal = SUB_CAST(_spSkeleton, self);
 
 	FREE(internal->updateCache);
+	FREE(internal->attachments);
+
+	if (internal->block) {
+		/* Only the update cache, resolved attachments, deform buffers, and path constraint buffers are outside the
+		 * block. */
+		for (i = 0; i < self->slotsCount; ++i)
+			FREE(self->slots[i]->deform);
+		for (i = 0; i < self->pathConstraintsCount; i++)
+			_spPathConstraint_disposeBuffers(self->pathConstraints[i]);
+		if (internal->ownsBlock) FREE(internal->block);
+		return;
+	}
 
-	for (i = 0; i < self->bonesCount; ++i)
-		spBone_dispose(self->bones[i]);
+	FREE(internal->bonesBlock);
+	FREE(internal->childrenBlock);
+	FREE(internal->lastPoses);
 	FREE(self->bones);
 
 	for (i = 0; i < self->slotsCount; ++i)
@@ -184,6 +404,7 @@ static void _addToUpdateCache(_spSkeleton *const internal, _spUpdateType type, v
 	update = internal->updateCache + internal->updateCacheCount;
 	update->type = type;
 	update->object = object;
+	update->count = 1;
 	++internal->updateCacheCount;
 }
 
@@ -355,6 +576,127 @@ static void _sortPhysicsConstraint(_spSkeleton *const internal, spPhysicsConstra
 	bone->sorted = -1;
 }
 
+static int _boneDepth(spBone *bone) {
+	int depth = 0;
+	while ((bone = bone->parent) != 0)
+		depth++;
+	return depth;
+}
+
+static int _isBoneRunUpdate(_spUpdate *update) {
+	spBone *bone = (spBone *) update->object;
+	return update->type == SP_UPDATE_BONE && bone->parent && bone->data->inherit == SP_INHERIT_NORMAL;
+}
+
+/* Bones between two constraints depend only on their parents, so each such span of the update cache is reordered by
+ * hierarchy depth and the bones at the same depth are marked to be computed together. */
+static void _groupBoneUpdates(_spSkeleton *const internal) {
+	_spUpdate *updates = internal->updateCache;
+	int i, ii, start, n = internal->updateCacheCount;
+	int *depths = MALLOC(int, n);
+	for (i = 0; i < n; i++)
+		depths[i] = updates[i].type == SP_UPDATE_BONE ? _boneDepth((spBone *) updates[i].object) : -1;
+
+	for (start = 0; start < n; start = i) {
+		if (updates[start].type != SP_UPDATE_BONE) {
+			i = start + 1;
+			continue;
+		}
+		for (i = start + 1; i < n && updates[i].type == SP_UPDATE_BONE; i++) {
+			_spUpdate update = updates[i];
+			int depth = depths[i];
+			for (ii = i; ii > start && depths[ii - 1] > depth; ii--) {
+				updates[ii] = updates[ii - 1];
+				depths[ii] = depths[ii - 1];
+			}
+			updates[ii] = update;
+			depths[ii] = depth;
+		}
+	}
+
+	for (i = 0; i < n; i += ii) {
+		ii = 1;
+		if (!_isBoneRunUpdate(updates + i)) continue;
+		while (i + ii < n && depths[i + ii] == depths[i] && _isBoneRunUpdate(updates + i + ii))
+			ii++;
+		updates[i].count = ii;
+	}
+	FREE(depths);
+}
+
+static void _markConstrainedBones(_spSkeleton *const internal) {
+	spSkeleton *self = SUPER(internal);
+	_spBonePose *poses = internal->lastPoses;
+	int i, ii;
+	for (i = 0; i < self->bonesCount; i++)
+		poses[i].constrained = 0;
+	for (i = 0; i < self->ikConstraintsCount; i++)
+		for (ii = 0; ii < self->ikConstraints[i]->bonesCount; ii++)
+			poses[self->ikConstraints[i]->bones[ii]->data->index].constrained = 1;
+	for (i = 0; i < self->transformConstraintsCount; i++)
+		for (ii = 0; ii < self->transformConstraints[i]->bonesCount; ii++)
+			poses[self->transformConstraints[i]->bones[ii]->data->index].constrained = 1;
+	for (i = 0; i < self->pathConstraintsCount; i++)
+		for (ii = 0; ii < self->pathConstraints[i]->bonesCount; ii++)
+			poses[self->pathConstraints[i]->bones[ii]->data->index].constrained = 1;
+	for (i = 0; i < self->physicsConstraintsCount; i++)
+		poses[self->physicsConstraints[i]->bone->data->index].constrained = 1;
+	/* Parents come before their children. */
+	for (i = 0; i < self->bonesCount; i++) {
+		spBone *parent = self->bones[i]->parent;
+		if (parent && poses[parent->data->index].constrained) poses[i].constrained = 1;
+	}
+	internal->lastPosesValid = 0;
+}
+
+/* Looks up the attachment for each of the skeleton data's attachment keys in the skin, then the default skin. */
+static void _spSkeleton_resolveAttachments(spSkeleton *self) {
+	_spSkeleton *internal = SUB_CAST(_spSkeleton, self);
+	_spSkeletonData *data = SUB_CAST(_spSkeletonData, self->data);
+	int i;
+	if (internal->attachmentsCount != data->attachmentKeysCount) {
+		FREE(internal->attachments);
+		internal->attachments = MALLOC(spAttachment *, data->attachmentKeysCount);
+		internal->attachmentsCount = data->attachmentKeysCount;
+	}
+	for (i = 0; i < internal->attachmentsCount; ++i)
+		internal->attachments[i] = spSkeleton_getAttachmentForSlotIndex(self, data->attachmentKeySlots[i],
+																		data->attachmentKeyNames[i]);
+	internal->resolvedSkin = self->skin;
+	internal->resolvedSkinModifications = self->skin ? SUB_CAST(_spSkin, self->skin)->modifications : 0;
+	internal->resolvedDefaultSkin = self->data->defaultSkin;
+	internal->resolvedDefaultSkinModifications =
+			self->data->defaultSkin ? SUB_CAST(_spSkin, self->data->defaultSkin)->modifications : 0;
+}
+
+/* Returns true if the skin or default skin was set or had attachments changed since the keys were resolved. */
+static int /*boolean*/ _spSkeleton_isSkinChanged(const spSkeleton *self) {
+	const _spSkeleton *internal = SUB_CAST(const _spSkeleton, self);
+	spSkin *skin = self->skin, *defaultSkin = self->data->defaultSkin;
+	if (skin != internal->resolvedSkin || defaultSkin != internal->resolvedDefaultSkin) return 1;
+	if (skin && SUB_CAST(_spSkin, skin)->modifications != internal->resolvedSkinModifications) return 1;
+	return defaultSkin && SUB_CAST(_spSkin, defaultSkin)->modifications != internal->resolvedDefaultSkinModifications;
+}
+
+spAttachment *
+_spSkeleton_getAttachmentForKey(const spSkeleton *self, int slotIndex, int key, const char *attachmentName) {
+	const _spSkeleton *internal = SUB_CAST(const _spSkeleton, self);
+	if (!attachmentName) return 0;
+	if (key >= 0 && key < internal->attachmentsCount) {
+		/* The table belongs to the skeleton, only its lookups are const. */
+		if (_spSkeleton_isSkinChanged(self)) _spSkeleton_resolveAttachments((spSkeleton *) self);
+		return internal->attachments[key];
+	}
+	return spSkeleton_getAttachmentForSlotIndex(self, slotIndex, attachmentName);
+}
+
+spAttachment *_spSkeleton_getSetupAttachment(const spSkeleton *self, const spSlotData *slotData) {
+	const _spSkeletonData *data = SUB_CAST(const _spSkeletonData, self->data);
+	int key = -1;
+	if (data->setupAttachmentKeys && slotData->index < data->slots.count) key = data->setupAttachmentKeys[slotData->index];
+	return _spSkeleton_getAttachmentForKey(self, slotData->index, key, slotData->attachmentName);
+}
+
 void spSkeleton_updateCache(spSkeleton *self) {
 	int i, ii;
 	spBone **bones;
@@ -365,6 +707,8 @@ void spSkeleton_updateCache(spSkeleton *self) {
 	int ikCount, transformCount, pathCount, physicsCount, constraintCount;
 	_spSkeleton *internal = SUB_CAST(_spSkeleton, self);
 
+	_spSkeleton_resolveAttachments(self);
+
 	internal->updateCacheCapacity =
 			self->bonesCount + self->ikConstraintsCount + self->transformConstraintsCount + self->pathConstraintsCount +
 			self->physicsConstraintsCount;
@@ -444,29 +788,341 @@ continue_outer:
 
 	for (i = 0; i < self->bonesCount; ++i)
 		_sortBone(internal, self->bones[i]);
+
+	_groupBoneUpdates(internal);
+	_markConstrainedBones(internal);
 }
 
+/* Bones at the same depth that normally inherit from their parents are computed BONE_LANES at a time. The poses are
+ * gathered into lane arrays, the local matrices and world transforms of all lanes are computed with SSE2, AVX2 or NEON
+ * instructions when available, then the results are scattered back to the bones. Define SPINE_NO_SIMD to always use the
+ * scalar loop, which has the same operations as spBone_updateWorldTransformWith.
+ *
+ * The SIMD sine and cosine are the Cephes single precision polynomials with a three part reduction by pi / 4, within
+ * 6e-8 of sinf and cosf for angles up to 8192 radians. Chunks with a larger angle use the scalar loop. Given the same
+ * parent, a bone's a, b, c and d are within 2.4e-7 of spBone_updateWorldTransformWith, relative to the bone's scale times
+ * the sum of the magnitudes of the parent's a, b, c and d. worldX and worldY are computed with the same operations as
+ * the scalar path. bench/bones.c checks this tolerance. */
+#if defined(SPINE_NO_SIMD)
+#define BONE_LANES 8
+#elif defined(__AVX2__)
+#include <immintrin.h>
+#define BONE_SIMD
+#define BONE_LANES 8
+typedef __m256 _spVec;
+typedef __m256i _spVecInt;
+#define VEC_LOAD(P) _mm256_loadu_ps(P)
+#define VEC_STORE(P, A) _mm256_storeu_ps(P, A)
+#define VEC_SET1(F) _mm256_set1_ps(F)
+#define VEC_ADD(A, B) _mm256_add_ps(A, B)
+#define VEC_SUB(A, B) _mm256_sub_ps(A, B)
+#define VEC_MUL(A, B) _mm256_mul_ps(A, B)
+#define VEC_AND(A, B) _mm256_and_ps(A, B)
+#define VEC_ANDNOT(A, B) _mm256_andnot_ps(A, B)
+#define VEC_XOR(A, B) _mm256_xor_ps(A, B)
+#define VEC_TRUNC(A) _mm256_cvttps_epi32(A)
+#define VEC_FROM_INT(I) _mm256_cvtepi32_ps(I)
+#define VEC_FROM_BITS(I) _mm256_castsi256_ps(I)
+#define INT_SET1(I) _mm256_set1_epi32(I)
+#define INT_ADD(A, B) _mm256_add_epi32(A, B)
+#define INT_SUB(A, B) _mm256_sub_epi32(A, B)
+#define INT_AND(A, B) _mm256_and_si256(A, B)
+#define INT_ANDNOT(A, B) _mm256_andnot_si256(A, B)
+#define INT_SIGN(I) _mm256_slli_epi32(I, 29)
+#define INT_IS_ZERO(I) _mm256_cmpeq_epi32(I, _mm256_setzero_si256())
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BONE_SIMD
+#define BONE_LANES 4
+typedef __m128 _spVec;
+typedef __m128i _spVecInt;
+#define VEC_LOAD(P) _mm_loadu_ps(P)
+#define VEC_STORE(P, A) _mm_storeu_ps(P, A)
+#define VEC_SET1(F) _mm_set1_ps(F)
+#define VEC_ADD(A, B) _mm_add_ps(A, B)
+#define VEC_SUB(A, B) _mm_sub_ps(A, B)
+#define VEC_MUL(A, B) _mm_mul_ps(A, B)
+#define VEC_AND(A, B) _mm_and_ps(A, B)
+#define VEC_ANDNOT(A, B) _mm_andnot_ps(A, B)
+#define VEC_XOR(A, B) _mm_xor_ps(A, B)
+#define VEC_TRUNC(A) _mm_cvttps_epi32(A)
+#define VEC_FROM_INT(I) _mm_cvtepi32_ps(I)
+#define VEC_FROM_BITS(I) _mm_castsi128_ps(I)
+#define INT_SET1(I) _mm_set1_epi32(I)
+#define INT_ADD(A, B) _mm_add_epi32(A, B)
+#define INT_SUB(A, B) _mm_sub_epi32(A, B)
+#define INT_AND(A, B) _mm_and_si128(A, B)
+#define INT_ANDNOT(A, B) _mm_andnot_si128(A, B)
+#define INT_SIGN(I) _mm_slli_epi32(I, 29)
+#define INT_IS_ZERO(I) _mm_cmpeq_epi32(I, _mm_setzero_si128())
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define BONE_SIMD
+#define BONE_LANES 4
+typedef float32x4_t _spVec;
+typedef int32x4_t _spVecInt;
+#define VEC_LOAD(P) vld1q_f32(P)
+#define VEC_STORE(P, A) vst1q_f32(P, A)
+#define VEC_SET1(F) vdupq_n_f32(F)
+#define VEC_ADD(A, B) vaddq_f32(A, B)
+#define VEC_SUB(A, B) vsubq_f32(A, B)
+#define VEC_MUL(A, B) vmulq_f32(A, B)
+#define VEC_AND(A, B) vreinterpretq_f32_s32(vandq_s32(vreinterpretq_s32_f32(A), vreinterpretq_s32_f32(B)))
+#define VEC_ANDNOT(A, B) vreinterpretq_f32_s32(vbicq_s32(vreinterpretq_s32_f32(B), vreinterpretq_s32_f32(A)))
+#define VEC_XOR(A, B) vreinterpretq_f32_s32(veorq_s32(vreinterpretq_s32_f32(A), vreinterpretq_s32_f32(B)))
+#define VEC_TRUNC(A) vcvtq_s32_f32(A)
+#define VEC_FROM_INT(I) vcvtq_f32_s32(I)
+#define VEC_FROM_BITS(I) vreinterpretq_f32_s32(I)
+#define INT_SET1(I) vdupq_n_s32(I)
+#define INT_ADD(A, B) vaddq_s32(A, B)
+#define INT_SUB(A, B) vsubq_s32(A, B)
+#define INT_AND(A, B) vandq_s32(A, B)
+#define INT_ANDNOT(A, B) vbicq_s32(B, A)
+#define INT_SIGN(I) vshlq_n_s32(I, 29)
+#define INT_IS_ZERO(I) vreinterpretq_s32_u32(vceqq_s32(I, vdupq_n_s32(0)))
+#else
+#define BONE_LANES 8
+#endif
+
+#define BONE_RUN_MAX_ANGLE 8192
+
+/* The inputs and outputs of one chunk, each BONE_LANES floats. */
+enum {
+	RUN_RX, RUN_RY, RUN_SCALE_X, RUN_SCALE_Y, RUN_X, RUN_Y,
+	RUN_PA, RUN_PB, RUN_PC, RUN_PD, RUN_PWORLD_X, RUN_PWORLD_Y,
+	RUN_INPUTS,
+	RUN_A = 0, RUN_B, RUN_C, RUN_D, RUN_WORLD_X, RUN_WORLD_Y,
+	RUN_OUTPUTS
+};
+
+#ifdef BONE_SIMD
+/* Computes the sine and cosine of each lane. */
+static void _sinCos(_spVec x, _spVec *s, _spVec *c) {
+	_spVec signMask = VEC_FROM_BITS(INT_SET1(~0x7fffffff));
+	_spVec sinSign = VEC_AND(x, signMask), cosSign, y, y2, z, polyMask, sinPoly, cosPoly;
+	_spVecInt j;
+	x = VEC_ANDNOT(signMask, x);
+
+	/* j is the octant rounded up to even, y is j as a float. */
+	j = VEC_TRUNC(VEC_MUL(x, VEC_SET1(1.27323954473516f)));
+	j = INT_AND(INT_ADD(j, INT_SET1(1)), INT_SET1(~1));
+	y = VEC_FROM_INT(j);
+	sinSign = VEC_XOR(sinSign, VEC_FROM_BITS(INT_SIGN(INT_AND(j, INT_SET1(4)))));
+	cosSign = VEC_FROM_BITS(INT_SIGN(INT_ANDNOT(INT_SUB(j, INT_SET1(2)), INT_SET1(4))));
+	polyMask = VEC_FROM_BITS(INT_IS_ZERO(INT_AND(j, INT_SET1(2))));
+
+	/* x = x - y * pi / 4, with pi / 4 split in three parts. */
+	x = VEC_SUB(x, VEC_MUL(y, VEC_SET1(0.78515625f)));
+	x = VEC_SUB(x, VEC_MUL(y, VEC_SET1(2.4187564849853515625e-4f)));
+	x = VEC_SUB(x, VEC_MUL(y, VEC_SET1(3.77489497744594108e-8f)));
+	z = VEC_MUL(x, x);
+
+	y = VEC_ADD(VEC_MUL(VEC_SET1(2.443315711809948e-5f), z), VEC_SET1(-1.388731625493765e-3f));
+	y = VEC_ADD(VEC_MUL(y, z), VEC_SET1(4.166664568298827e-2f));
+	y = VEC_MUL(VEC_MUL(y, z), z);
+	y = VEC_ADD(VEC_SUB(y, VEC_MUL(z, VEC_SET1(0.5f))), VEC_SET1(1));
+
+	y2 = VEC_ADD(VEC_MUL(VEC_SET1(-1.9515295891e-4f), z), VEC_SET1(8.3321608736e-3f));
+	y2 = VEC_ADD(VEC_MUL(y2, z), VEC_SET1(-1.6666654611e-1f));
+	y2 = VEC_ADD(VEC_MUL(VEC_MUL(y2, z), x), x);
+
+	/* Octants 0 and 3 mod 4 use the sine polynomial for the sine, the others use the cosine polynomial. */
+	sinPoly = VEC_ADD(VEC_AND(polyMask, y2), VEC_ANDNOT(polyMask, y));
+	cosPoly = VEC_ADD(VEC_AND(polyMask, y), VEC_ANDNOT(polyMask, y2));
+	*s = VEC_XOR(sinPoly, sinSign);
+	*c = VEC_XOR(cosPoly, cosSign);
+}
+
+static void _computeBoneRunChunk(float in[RUN_INPUTS][BONE_LANES], float out[RUN_OUTPUTS][BONE_LANES]) {
+	_spVec sinX, cosX, sinY, cosY, la, lb, lc, ld, pa, pb, pc, pd, x, y;
+	_sinCos(VEC_LOAD(in[RUN_RX]), &sinX, &cosX);
+	_sinCos(VEC_LOAD(in[RUN_RY]), &sinY, &cosY);
+	la = VEC_MUL(cosX, VEC_LOAD(in[RUN_SCALE_X]));
+	lb = VEC_MUL(cosY, VEC_LOAD(in[RUN_SCALE_Y]));
+	lc = VEC_MUL(sinX, VEC_LOAD(in[RUN_SCALE_X]));
+	ld = VEC_MUL(sinY, VEC_LOAD(in[RUN_SCALE_Y]));
+	pa = VEC_LOAD(in[RUN_PA]);
+	pb = VEC_LOAD(in[RUN_PB]);
+	pc = VEC_LOAD(in[RUN_PC]);
+	pd = VEC_LOAD(in[RUN_PD]);
+	x = VEC_LOAD(in[RUN_X]);
+	y = VEC_LOAD(in[RUN_Y]);
+	VEC_STORE(out[RUN_WORLD_X], VEC_ADD(VEC_ADD(VEC_MUL(pa, x), VEC_MUL(pb, y)), VEC_LOAD(in[RUN_PWORLD_X])));
+	VEC_STORE(out[RUN_WORLD_Y], VEC_ADD(VEC_ADD(VEC_MUL(pc, x), VEC_MUL(pd, y)), VEC_LOAD(in[RUN_PWORLD_Y])));
+	VEC_STORE(out[RUN_A], VEC_ADD(VEC_MUL(pa, la), VEC_MUL(pb, lc)));
+	VEC_STORE(out[RUN_B], VEC_ADD(VEC_MUL(pa, lb), VEC_MUL(pb, ld)));
+	VEC_STORE(out[RUN_C], VEC_ADD(VEC_MUL(pc, la), VEC_MUL(pd, lc)));
+	VEC_STORE(out[RUN_D], VEC_ADD(VEC_MUL(pc, lb), VEC_MUL(pd, ld)));
+}
+#endif
+
+/* Computes a chunk with the same operations as spBone_updateWorldTransformWith. */
+static void _computeBoneRunChunkScalar(float in[RUN_INPUTS][BONE_LANES], float out[RUN_OUTPUTS][BONE_LANES], int n) {
+	int i;
+	for (i = 0; i < n; i++) {
+		float la = COS(in[RUN_RX][i]) * in[RUN_SCALE_X][i];
+		float lb = COS(in[RUN_RY][i]) * in[RUN_SCALE_Y][i];
+		float lc = SIN(in[RUN_RX][i]) * in[RUN_SCALE_X][i];
+		float ld = SIN(in[RUN_RY][i]) * in[RUN_SCALE_Y][i];
+		float pa = in[RUN_PA][i], pb = in[RUN_PB][i], pc = in[RUN_PC][i], pd = in[RUN_PD][i];
+		out[RUN_WORLD_X][i] = pa * in[RUN_X][i] + pb * in[RUN_Y][i] + in[RUN_PWORLD_X][i];
+		out[RUN_WORLD_Y][i] = pc * in[RUN_X][i] + pd * in[RUN_Y][i] + in[RUN_PWORLD_Y][i];
+		out[RUN_A][i] = pa * la + pb * lc;
+		out[RUN_B][i] = pa * lb + pb * ld;
+		out[RUN_C][i] = pc * la + pd * lc;
+		out[RUN_D][i] = pc * lb + pd * ld;
+	}
+}
+
+/* Computes the world transforms of bones at the same hierarchy depth that normally inherit from their parents. */
+static void _updateBoneRun(_spUpdate *updates, int count) {
+	float in[RUN_INPUTS][BONE_LANES], out[RUN_OUTPUTS][BONE_LANES];
+	int i, ii, n;
+#ifdef BONE_SIMD
+	int wide;
+#endif
+	for (i = 0; i < count; i += n) {
+		n = MIN(count - i, BONE_LANES);
+#ifdef BONE_SIMD
+		wide = n > 1;
+#endif
+		for (ii = 0; ii < n; ii++) {
+			spBone *bone = (spBone *) updates[i + ii].object;
+			spBone *parent = bone->parent;
+			float rx = (bone->arotation + bone->ashearX) * DEG_RAD;
+			float ry = (bone->arotation + 90 + bone->ashearY) * DEG_RAD;
+#ifdef BONE_SIMD
+			if (!(ABS(rx) <= BONE_RUN_MAX_ANGLE && ABS(ry) <= BONE_RUN_MAX_ANGLE)) wide = 0;
+#endif
+			in[RUN_RX][ii] = rx;
+			in[RUN_RY][ii] = ry;
+			in[RUN_SCALE_X][ii] = bone->ascaleX;
+			in[RUN_SCALE_Y][ii] = bone->ascaleY;
+			in[RUN_X][ii] = bone->ax;
+			in[RUN_Y][ii] = bone->ay;
+			in[RUN_PA][ii] = parent->a;
+			in[RUN_PB][ii] = parent->b;
+			in[RUN_PC][ii] = parent->c;
+			in[RUN_PD][ii] = parent->d;
+			in[RUN_PWORLD_X][ii] = parent->worldX;
+			in[RUN_PWORLD_Y][ii] = parent->worldY;
+		}
+#ifdef BONE_SIMD
+		if (wide) {
+			for (ii = n; ii < BONE_LANES; ii++) {
+				int iii;
+				for (iii = 0; iii < RUN_INPUTS; iii++)
+					in[iii][ii] = 0;
+			}
+			_computeBoneRunChunk(in, out);
+		} else
+#endif
+			_computeBoneRunChunkScalar(in, out, n);
+		for (ii = 0; ii < n; ii++) {
+			spBone *bone = (spBone *) updates[i + ii].object;
+			if (bone->inherit != SP_INHERIT_NORMAL) {
+				/* Changed by an inherit timeline. */
+				spBone_update(bone);
+				continue;
+			}
+			bone->a = out[RUN_A][ii];
+			bone->b = out[RUN_B][ii];
+			bone->c = out[RUN_C][ii];
+			bone->d = out[RUN_D][ii];
+			bone->worldX = out[RUN_WORLD_X][ii];
+			bone->worldY = out[RUN_WORLD_Y][ii];
+		}
+	}
+}
+
+/* The applied pose fields directly follow the local pose fields in spBone, in the same order, so the local pose is copied
+ * to the applied pose with one memcpy per bone. */
+#define COPY_LOCAL_TO_APPLIED(BONE) memcpy(&(BONE)->ax, &(BONE)->x, 7 * sizeof(float))
+
+/* Fails to compile, with a negative array size, if the fields are reordered. */
+typedef char _spBoneLocalPoseIsContiguous[offsetof(spBone, shearY) - offsetof(spBone, x) == 6 * sizeof(float) ? 1 : -1];
+typedef char _spBoneAppliedPoseFollowsLocal[offsetof(spBone, ax) - offsetof(spBone, x) == 7 * sizeof(float) ? 1 : -1];
+typedef char _spBoneAppliedPoseIsContiguous[offsetof(spBone, ashearY) - offsetof(spBone, ax) == 6 * sizeof(float) ? 1 : -1];
+
 void spSkeleton_updateWorldTransform(const spSkeleton *self, spPhysics physics) {
 	int i, n;
 	_spSkeleton *internal = SUB_CAST(_spSkeleton, self);
+	internal->lastPosesValid = 0;
 
 	for (i = 0, n = self->bonesCount; i < n; i++) {
-		spBone *bone = self->bones[i];
-		bone->ax = bone->x;
-		bone->ay = bone->y;
-		bone->arotation = bone->rotation;
-		bone->ascaleX = bone->scaleX;
-		bone->ascaleY = bone->scaleY;
-		bone->ashearX = bone->shearX;
-		bone->ashearY = bone->shearY;
+		spBone *bone = internal->bonesBlock + i;
+		COPY_LOCAL_TO_APPLIED(bone);
 	}
 
 	for (i = 0; i < internal->updateCacheCount; ++i) {
 		_spUpdate *update = internal->updateCache + i;
 		switch (update->type) {
 			case SP_UPDATE_BONE:
-				spBone_update((spBone *) update->object);
+				if (update->count > 1) {
+					_updateBoneRun(update, update->count);
+					i += update->count - 1;
+				} else
+					spBone_update((spBone *) update->object);
+				break;
+			case SP_UPDATE_IK_CONSTRAINT:
+				spIkConstraint_update((spIkConstraint *) update->object);
+				break;
+			case SP_UPDATE_TRANSFORM_CONSTRAINT:
+				spTransformConstraint_update((spTransformConstraint *) update->object);
+				break;
+			case SP_UPDATE_PATH_CONSTRAINT:
+				spPathConstraint_update((spPathConstraint *) update->object);
+				break;
+			case SP_UPDATE_PHYSICS_CONSTRAINT:
+				spPhysicsConstraint_update((spPhysicsConstraint *) update->object, physics);
+		}
+	}
+}
+
+int spSkeleton_updateWorldTransformIncremental(const spSkeleton *self, spPhysics physics) {
+	int i, n, skipped = 0;
+	_spSkeleton *internal = SUB_CAST(_spSkeleton, self);
+	_spBonePose *poses = internal->lastPoses;
+	int /*boolean*/ yDown = spSkeleton_isYDown(self);
+	int /*boolean*/ all = !internal->lastPosesValid || self->x != internal->lastX || self->y != internal->lastY ||
+						  self->scaleX != internal->lastScaleX || self->scaleY != internal->lastScaleY ||
+						  yDown != internal->lastYDown;
+
+	for (i = 0, n = self->bonesCount; i < n; i++) {
+		spBone *bone = internal->bonesBlock + i;
+		_spBonePose *pose = poses + i;
+		COPY_LOCAL_TO_APPLIED(bone);
+		pose->dirty = all || pose->constrained || pose->inherit != bone->inherit || pose->x != bone->x ||
+					  pose->y != bone->y || pose->rotation != bone->rotation || pose->scaleX != bone->scaleX ||
+					  pose->scaleY != bone->scaleY || pose->shearX != bone->shearX || pose->shearY != bone->shearY;
+		if (pose->dirty) {
+			pose->x = bone->x;
+			pose->y = bone->y;
+			pose->rotation = bone->rotation;
+			pose->scaleX = bone->scaleX;
+			pose->scaleY = bone->scaleY;
+			pose->shearX = bone->shearX;
+			pose->shearY = bone->shearY;
+			pose->inherit = bone->inherit;
+		}
+	}
+
+	for (i = 0; i < internal->updateCacheCount; ++i) {
+		_spUpdate *update = internal->updateCache + i;
+		switch (update->type) {
+			case SP_UPDATE_BONE: {
+				spBone *bone = (spBone *) update->object;
+				_spBonePose *pose = poses + bone->data->index;
+				if (!pose->dirty) {
+					if (!bone->parent || !poses[bone->parent->data->index].dirty) {
+						skipped++;
+						break;
+					}
+					pose->dirty = 1;
+				}
+				spBone_update(bone);
 				break;
+			}
 			case SP_UPDATE_IK_CONSTRAINT:
 				spIkConstraint_update((spIkConstraint *) update->object);
 				break;
@@ -480,6 +1136,25 @@ void spSkeleton_updateWorldTransform(const spSkeleton *self, spPhysics physics)
 				spPhysicsConstraint_update((spPhysicsConstraint *) update->object, physics);
 		}
 	}
+
+	internal->lastPosesValid = -1;
+	internal->lastX = self->x;
+	internal->lastY = self->y;
+	internal->lastScaleX = self->scaleX;
+	internal->lastScaleY = self->scaleY;
+	internal->lastYDown = yDown;
+	return skipped;
+}
+
+void spSkeleton_setYDown(spSkeleton *self, int /*bool*/ yDown) {
+	_spSkeleton *internal = SUB_CAST(_spSkeleton, self);
+	internal->hasYDown = -1;
+	internal->yDown = yDown;
+}
+
+int /*bool*/ spSkeleton_isYDown(const spSkeleton *self) {
+	_spSkeleton *internal = SUB_CAST(_spSkeleton, self);
+	return internal->hasYDown ? internal->yDown : spBone_isYDown();
 }
 
 void spSkeleton_update(spSkeleton *self, float delta) {
@@ -493,6 +1168,7 @@ void spSkeleton_updateWorldTransformWith(const spSkeleton *self, const spBone *p
 	_spSkeleton *internal = SUB_CAST(_spSkeleton, self);
 	spBone *rootBone = self->root;
 	float pa = parent->a, pb = parent->b, pc = parent->c, pd = parent->d;
+	internal->lastPosesValid = 0;
 	rootBone->worldX = pa * self->x + pb * self->y + parent->worldX;
 	rootBone->worldY = pc * self->x + pd * self->y + parent->worldY;
 
@@ -563,17 +1239,13 @@ void spSkeleton_setSlotsToSetupPose(const spSkeleton *self) {
 }
 
 spBone *spSkeleton_findBone(const spSkeleton *self, const char *boneName) {
-	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->data->bones[i]->name, boneName) == 0) return self->bones[i];
-	return 0;
+	int index = spSkeletonData_findBoneIndex(self->data, boneName);
+	return index == -1 ? 0 : self->bones[index];
 }
 
 spSlot *spSkeleton_findSlot(const spSkeleton *self, const char *slotName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->data->slots[i]->name, slotName) == 0) return self->slots[i];
-	return 0;
+	int index = spSkeletonData_findSlotIndex(self->data, slotName);
+	return index == -1 ? 0 : self->slots[index];
 }
 
 int spSkeleton_setSkinByName(spSkeleton *self, const char *skinName) {
@@ -589,7 +1261,10 @@ int spSkeleton_setSkinByName(spSkeleton *self, const char *skinName) {
 }
 
 void spSkeleton_setSkin(spSkeleton *self, spSkin *newSkin) {
-	if (self->skin == newSkin) return;
+	if (self->skin == newSkin) {
+		_spSkeleton_resolveAttachments(self);
+		return;
+	}
 	if (newSkin) {
 		if (self->skin)
 			spSkin_attachAll(newSkin, self, self->skin);
@@ -611,8 +1286,7 @@ void spSkeleton_setSkin(spSkeleton *self, spSkin *newSkin) {
 
 spAttachment *
 spSkeleton_getAttachmentForSlotName(const spSkeleton *self, const char *slotName, const char *attachmentName) {
-	int slotIndex = spSkeletonData_findSlot(self->data, slotName)->index;
-	return spSkeleton_getAttachmentForSlotIndex(self, slotIndex, attachmentName);
+	return spSkeleton_getAttachmentForSlotIndex(self, spSkeletonData_findSlotIndex(self->data, slotName), attachmentName);
 }
 
 spAttachment *spSkeleton_getAttachmentForSlotIndex(const spSkeleton *self, int slotIndex, const char *attachmentName) {
@@ -629,51 +1303,42 @@ spAttachment *spSkeleton_getAttachmentForSlotIndex(const spSkeleton *self, int s
 }
 
 int spSkeleton_setAttachment(spSkeleton *self, const char *slotName, const char *attachmentName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i) {
-		spSlot *slot = self->slots[i];
-		if (strcmp(slot->data->name, slotName) == 0) {
-			if (!attachmentName)
-				spSlot_setAttachment(slot, 0);
-			else {
-				spAttachment *attachment = spSkeleton_getAttachmentForSlotIndex(self, i, attachmentName);
-				if (!attachment) return 0;
-				spSlot_setAttachment(slot, attachment);
-			}
-			return 1;
-		}
+	return spSkeleton_setAttachmentForSlotIndex(self, spSkeletonData_findSlotIndex(self->data, slotName), attachmentName);
+}
+
+int spSkeleton_setAttachmentForSlotIndex(spSkeleton *self, int slotIndex, const char *attachmentName) {
+	spSlot *slot;
+	if (slotIndex == -1) return 0;
+	slot = self->slots[slotIndex];
+	if (!attachmentName)
+		spSlot_setAttachment(slot, 0);
+	else {
+		spAttachment *attachment = spSkeleton_getAttachmentForSlotIndex(self, slotIndex, attachmentName);
+		if (!attachment) return 0;
+		spSlot_setAttachment(slot, attachment);
 	}
-	return 0;
+	return 1;
 }
 
 spIkConstraint *spSkeleton_findIkConstraint(const spSkeleton *self, const char *constraintName) {
-	int i;
-	for (i = 0; i < self->ikConstraintsCount; ++i)
-		if (strcmp(self->ikConstraints[i]->data->name, constraintName) == 0) return self->ikConstraints[i];
-	return 0;
+	int index = spSkeletonData_findIkConstraintIndex(self->data, constraintName);
+	return index == -1 ? 0 : self->ikConstraints[index];
 }
 
 spTransformConstraint *spSkeleton_findTransformConstraint(const spSkeleton *self, const char *constraintName) {
-	int i;
-	for (i = 0; i < self->transformConstraintsCount; ++i)
-		if (strcmp(self->transformConstraints[i]->data->name, constraintName) == 0)
-			return self->transformConstraints[i];
-	return 0;
+	int index = spSkeletonData_findTransformConstraintIndex(self->data, constraintName);
+	return index == -1 ? 0 : self->transformConstraints[index];
 }
 
 spPathConstraint *spSkeleton_findPathConstraint(const spSkeleton *self, const char *constraintName) {
-	int i;
-	for (i = 0; i < self->pathConstraintsCount; ++i)
-		if (strcmp(self->pathConstraints[i]->data->name, constraintName) == 0) return self->pathConstraints[i];
-	return 0;
+	int index = spSkeletonData_findPathConstraintIndex(self->data, constraintName);
+	return index == -1 ? 0 : self->pathConstraints[index];
 }
 
 
 spPhysicsConstraint *spSkeleton_findPhysicsConstraint(const spSkeleton *self, const char *constraintName) {
-	int i;
-	for (i = 0; i < self->physicsConstraintsCount; ++i)
-		if (strcmp(self->physicsConstraints[i]->data->name, constraintName) == 0) return self->physicsConstraints[i];
-	return 0;
+	int index = spSkeletonData_findPhysicsConstraintIndex(self->data, constraintName);
+	return index == -1 ? 0 : self->physicsConstraints[index];
 }
 
 void spSkeleton_physicsTranslate(spSkeleton *self, float x, float y) {
@@ -871,7 +871,7 @@ static spAnimation *_spSkeletonBinary_readAnimation(spSkeletonBinary *self, cons
 						time = readFloat(input);
 						for (frame = 0, bezier = 0;; ++frame) {
 							float *deform;
-							int end = readVarint(input, 1);
+							int start = 0, end = readVarint(input, 1);
 							if (!end) {
 								if (weighted) {
 									deform = tempDeform;
@@ -879,7 +879,8 @@ static spAnimation *_spSkeletonBinary_readAnimation(spSkeletonBinary *self, cons
 								} else
 									deform = attachment->vertices;
 							} else {
-								int v, start = readVarint(input, 1);
+								int v;
+								start = readVarint(input, 1);
 								deform = tempDeform;
 								memset(deform, 0, sizeof(float) * start);
 								end += start;
@@ -897,7 +898,7 @@ static spAnimation *_spSkeletonBinary_readAnimation(spSkeletonBinary *self, cons
 										deform[v] += vertices[v];
 								}
 							}
-							spDeformTimeline_setFrame(timeline, frame, time, deform);
+							spDeformTimeline_setFrameRange(timeline, frame, time, deform, start, end);
 							if (frame == frameLast) break;
 							time2 = readFloat(input);
 							switch (readSByte(input)) {
@@ -993,6 +994,8 @@ static spAnimation *_spSkeletonBinary_readAnimation(spSkeletonBinary *self, cons
 		duration = MAX(duration, spTimeline_getDuration(timelines->items[i]));
 	}
 	animation = spAnimation_create(name, timelines, duration);
+	spAnimation_setBezierEvaluation(animation, self->bezierEvaluation);
+	spAnimation_quantizeCurves(animation, self->curveBits, &self->curveReport);
 	return animation;
 }
 
@@ -1082,7 +1085,7 @@ spAttachment *spSkeletonBinary_readAttachment(spSkeletonBinary *self, _dataInput
 			region->height = height;
 			spColor_setFromColor(&region->color, &color);
 			region->sequence = sequence;
-			if (sequence == NULL) spRegionAttachment_updateRegion(region);
+			spRegionAttachment_updateRegion(region);
 			spAttachmentLoader_configureAttachment(self->attachmentLoader, SUPER(region));
 			return SUPER(region);
 		}
@@ -1153,7 +1156,7 @@ spAttachment *spSkeletonBinary_readAttachment(spSkeletonBinary *self, _dataInput
 			mesh->width = width;
 			mesh->height = height;
 			mesh->sequence = sequence;
-			if (sequence == NULL) spMeshAttachment_updateRegion(mesh);
+			spMeshAttachment_updateRegion(mesh);
 			spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
 			return attachment;
 		}
@@ -1326,6 +1329,7 @@ spSkeletonData *spSkeletonBinary_readSkeletonData(spSkeletonBinary *self, const
 	FREE(self->error);
 	self->error = 0;
 	internal->linkedMeshCount = 0;
+	memset(&self->curveReport, 0, sizeof(spCurveQuantizeReport));
 
 	skeletonData = spSkeletonData_create();
 	lowHash = readInt(input);
@@ -1609,7 +1613,7 @@ spSkeletonData *spSkeletonBinary_readSkeletonData(spSkeletonBinary *self, const
 		linkedMesh->mesh->super.timelineAttachment = linkedMesh->inheritTimeline ? parent
 																				 : SUPER(SUPER(linkedMesh->mesh));
 		spMeshAttachment_setParentMesh(linkedMesh->mesh, SUB_CAST(spMeshAttachment, parent));
-		if (linkedMesh->mesh->region) spMeshAttachment_updateRegion(linkedMesh->mesh);
+		if (linkedMesh->mesh->region || linkedMesh->mesh->sequence) spMeshAttachment_updateRegion(linkedMesh->mesh);
 		spAttachmentLoader_configureAttachment(self->attachmentLoader, SUPER(SUPER(linkedMesh->mesh)));
 	}
 
@@ -1649,5 +1653,8 @@ spSkeletonData *spSkeletonBinary_readSkeletonData(spSkeletonBinary *self, const
 	}
 
 	FREE(input);
+	spSkeletonData_updateIndex(skeletonData);
+	_spSkeletonData_updateAttachmentKeys(skeletonData);
+	_spSkeletonData_updateDeformCapacities(skeletonData);
 	return skeletonData;
 }
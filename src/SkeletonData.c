@@ -31,11 +31,174 @@
 #include <spine/extension.h>
 #include <string.h>
 
+static unsigned int _hashName(const char *name) {
+	/* FNV-1a. */
+	unsigned int hash = 2166136261u;
+	while (*name) {
+		hash ^= (unsigned char) *name++;
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void _spNameIndex_dispose(_spNameIndex *self) {
+	FREE(self->buckets);
+	FREE(self->names);
+	self->count = 0;
+	self->mask = 0;
+}
+
+/* Hashes the names, which must have been set for count items. */
+static void _spNameIndex_build(_spNameIndex *self, int count) {
+	int i, size = 1;
+	while (size < count * 2) size <<= 1;
+	self->count = count;
+	self->mask = size - 1;
+	self->buckets = CALLOC(int, size);
+	for (i = 0; i < count; ++i) {
+		unsigned int bucket = _hashName(self->names[i]) & self->mask;
+		while (self->buckets[bucket]) {
+			/* The first item with a name wins, as with a linear search. */
+			if (strcmp(self->names[self->buckets[bucket] - 1], self->names[i]) == 0) break;
+			bucket = (bucket + 1) & self->mask;
+		}
+		if (!self->buckets[bucket]) self->buckets[bucket] = i + 1;
+	}
+}
+
+static int _spNameIndex_find(const _spNameIndex *self, const char *name) {
+	unsigned int bucket;
+	if (!self->buckets) return -1;
+	bucket = _hashName(name) & self->mask;
+	while (self->buckets[bucket]) {
+		int index = self->buckets[bucket] - 1;
+		if (strcmp(self->names[index], name) == 0) return index;
+		bucket = (bucket + 1) & self->mask;
+	}
+	return -1;
+}
+
+#define BUILD_INDEX(INDEX, ITEMS, COUNT) \
+	_spNameIndex_dispose(&INDEX); \
+	INDEX.names = MALLOC(const char *, COUNT); \
+	for (i = 0; i < COUNT; ++i) INDEX.names[i] = ITEMS[i]->name; \
+	_spNameIndex_build(&INDEX, COUNT);
+
+/* Uses the index if it was built for the current number of items, else searches linearly. */
+#define FIND_INDEX(INDEX, ITEMS, COUNT, NAME) \
+	int i; \
+	if (INDEX.count == COUNT) return _spNameIndex_find(&INDEX, NAME); \
+	for (i = 0; i < COUNT; ++i) \
+		if (strcmp(ITEMS[i]->name, NAME) == 0) return i; \
+	return -1;
+
+/* Open addressing table of slot and attachment name pairs, used while the keys are assigned. */
+typedef struct {
+	_spSkeletonData *data;
+	int mask;
+	int *buckets; /* Key + 1, or 0 for an empty bucket. */
+} _spAttachmentKeys;
+
+static int _spAttachmentKeys_add(_spAttachmentKeys *self, int slotIndex, const char *name) {
+	_spSkeletonData *data = self->data;
+	unsigned int bucket = (_hashName(name) ^ (unsigned int) slotIndex * 2654435761u) & self->mask;
+	int key;
+	while (self->buckets[bucket]) {
+		key = self->buckets[bucket] - 1;
+		if (data->attachmentKeySlots[key] == slotIndex && strcmp(data->attachmentKeyNames[key], name) == 0) return key;
+		bucket = (bucket + 1) & self->mask;
+	}
+	key = data->attachmentKeysCount++;
+	data->attachmentKeySlots[key] = slotIndex;
+	data->attachmentKeyNames[key] = name;
+	self->buckets[bucket] = key + 1;
+	return key;
+}
+
+static void _spSkeletonData_disposeAttachmentKeys(_spSkeletonData *self) {
+	FREE(self->attachmentKeySlots);
+	FREE(self->attachmentKeyNames);
+	FREE(self->setupAttachmentKeys);
+	self->attachmentKeysCount = 0;
+}
+
+void _spSkeletonData_updateAttachmentKeys(spSkeletonData *data) {
+	_spSkeletonData *self = SUB_CAST(_spSkeletonData, data);
+	_spAttachmentKeys keys;
+	int i, ii, iii, size = 1, maxKeys = data->slotsCount;
+
+	for (i = 0; i < data->animationsCount; ++i) {
+		spTimelineArray *timelines = data->animations[i]->timelines;
+		for (ii = 0; ii < timelines->size; ++ii)
+			if (timelines->items[ii]->type == SP_TIMELINE_ATTACHMENT) maxKeys += timelines->items[ii]->frameCount;
+	}
+	_spSkeletonData_disposeAttachmentKeys(self);
+	self->attachmentKeySlots = MALLOC(int, maxKeys);
+	self->attachmentKeyNames = MALLOC(const char *, maxKeys);
+	self->setupAttachmentKeys = MALLOC(int, data->slotsCount);
+	while (size < maxKeys * 2) size <<= 1;
+	keys.data = self;
+	keys.mask = size - 1;
+	keys.buckets = CALLOC(int, size);
+
+	for (i = 0; i < data->slotsCount; ++i) {
+		const char *name = data->slots[i]->attachmentName;
+		self->setupAttachmentKeys[i] = name ? _spAttachmentKeys_add(&keys, i, name) : -1;
+	}
+	for (i = 0; i < data->animationsCount; ++i) {
+		spTimelineArray *timelines = data->animations[i]->timelines;
+		for (ii = 0; ii < timelines->size; ++ii) {
+			spAttachmentTimeline *timeline;
+			if (timelines->items[ii]->type != SP_TIMELINE_ATTACHMENT) continue;
+			timeline = SUB_CAST(spAttachmentTimeline, timelines->items[ii]);
+			if (!timeline->attachmentKeys) timeline->attachmentKeys = MALLOC(int, timeline->super.frameCount);
+			for (iii = 0; iii < timeline->super.frameCount; ++iii) {
+				const char *name = timeline->attachmentNames[iii];
+				timeline->attachmentKeys[iii] = name ? _spAttachmentKeys_add(&keys, timeline->slotIndex, name) : -1;
+			}
+		}
+	}
+	FREE(keys.buckets);
+}
+
 spSkeletonData *spSkeletonData_create(void) {
-	return NEW(spSkeletonData);
+	return SUPER(NEW(_spSkeletonData));
+}
+
+void spSkeletonData_updateIndex(spSkeletonData *self) {
+	_spSkeletonData *internal = SUB_CAST(_spSkeletonData, self);
+	int i;
+	BUILD_INDEX(internal->bones, self->bones, self->bonesCount)
+	BUILD_INDEX(internal->slots, self->slots, self->slotsCount)
+	BUILD_INDEX(internal->skins, self->skins, self->skinsCount)
+	BUILD_INDEX(internal->events, self->events, self->eventsCount)
+	BUILD_INDEX(internal->animations, self->animations, self->animationsCount)
+	BUILD_INDEX(internal->ikConstraints, self->ikConstraints, self->ikConstraintsCount)
+	BUILD_INDEX(internal->transformConstraints, self->transformConstraints, self->transformConstraintsCount)
+	BUILD_INDEX(internal->pathConstraints, self->pathConstraints, self->pathConstraintsCount)
+	BUILD_INDEX(internal->physicsConstraints, self->physicsConstraints, self->physicsConstraintsCount)
+}
+
+void _spSkeletonData_updateDeformCapacities(spSkeletonData *self) {
+	int i;
+	for (i = 0; i < self->slotsCount; ++i)
+		self->slots[i]->deformCapacity = 0;
+	for (i = 0; i < self->animationsCount; ++i) {
+		spTimelineArray *timelines = self->animations[i]->timelines;
+		int ii;
+		for (ii = 0; ii < timelines->size; ++ii) {
+			spDeformTimeline *timeline;
+			spSlotData *slot;
+			if (timelines->items[ii]->type != SP_TIMELINE_DEFORM) continue;
+			timeline = SUB_CAST(spDeformTimeline, timelines->items[ii]);
+			slot = self->slots[timeline->slotIndex];
+			slot->deformCapacity = MAX(slot->deformCapacity, timeline->frameVerticesCount);
+		}
+	}
 }
 
 void spSkeletonData_dispose(spSkeletonData *self) {
+	_spSkeletonData *internal = SUB_CAST(_spSkeletonData, self);
 	int i;
 
 	for (i = 0; i < self->stringsCount; ++i)
@@ -78,6 +241,17 @@ void spSkeletonData_dispose(spSkeletonData *self) {
 		spPhysicsConstraintData_dispose(self->physicsConstraints[i]);
 	FREE(self->physicsConstraints);
 
+	_spSkeletonData_disposeAttachmentKeys(internal);
+	_spNameIndex_dispose(&internal->bones);
+	_spNameIndex_dispose(&internal->slots);
+	_spNameIndex_dispose(&internal->skins);
+	_spNameIndex_dispose(&internal->events);
+	_spNameIndex_dispose(&internal->animations);
+	_spNameIndex_dispose(&internal->ikConstraints);
+	_spNameIndex_dispose(&internal->transformConstraints);
+	_spNameIndex_dispose(&internal->pathConstraints);
+	_spNameIndex_dispose(&internal->physicsConstraints);
+
 	FREE(self->hash);
 	FREE(self->version);
 	FREE(self->imagesPath);
@@ -86,66 +260,92 @@ void spSkeletonData_dispose(spSkeletonData *self) {
 	FREE(self);
 }
 
+int spSkeletonData_findBoneIndex(const spSkeletonData *self, const char *boneName) {
+	const _spSkeletonData *internal = SUB_CAST(const _spSkeletonData, self);
+	FIND_INDEX(internal->bones, self->bones, self->bonesCount, boneName)
+}
+
 spBoneData *spSkeletonData_findBone(const spSkeletonData *self, const char *boneName) {
-	int i;
-	for (i = 0; i < self->bonesCount; ++i)
-		if (strcmp(self->bones[i]->name, boneName) == 0) return self->bones[i];
-	return 0;
+	int index = spSkeletonData_findBoneIndex(self, boneName);
+	return index == -1 ? 0 : self->bones[index];
+}
+
+int spSkeletonData_findSlotIndex(const spSkeletonData *self, const char *slotName) {
+	const _spSkeletonData *internal = SUB_CAST(const _spSkeletonData, self);
+	FIND_INDEX(internal->slots, self->slots, self->slotsCount, slotName)
 }
 
 spSlotData *spSkeletonData_findSlot(const spSkeletonData *self, const char *slotName) {
-	int i;
-	for (i = 0; i < self->slotsCount; ++i)
-		if (strcmp(self->slots[i]->name, slotName) == 0) return self->slots[i];
-	return 0;
+	int index = spSkeletonData_findSlotIndex(self, slotName);
+	return index == -1 ? 0 : self->slots[index];
+}
+
+static int _spSkeletonData_findSkinIndex(const spSkeletonData *self, const char *skinName) {
+	const _spSkeletonData *internal = SUB_CAST(const _spSkeletonData, self);
+	FIND_INDEX(internal->skins, self->skins, self->skinsCount, skinName)
 }
 
 spSkin *spSkeletonData_findSkin(const spSkeletonData *self, const char *skinName) {
-	int i;
-	for (i = 0; i < self->skinsCount; ++i)
-		if (strcmp(self->skins[i]->name, skinName) == 0) return self->skins[i];
-	return 0;
+	int index = _spSkeletonData_findSkinIndex(self, skinName);
+	return index == -1 ? 0 : self->skins[index];
+}
+
+static int _spSkeletonData_findEventIndex(const spSkeletonData *self, const char *eventName) {
+	const _spSkeletonData *internal = SUB_CAST(const _spSkeletonData, self);
+	FIND_INDEX(internal->events, self->events, self->eventsCount, eventName)
 }
 
 spEventData *spSkeletonData_findEvent(const spSkeletonData *self, const char *eventName) {
-	int i;
-	for (i = 0; i < self->eventsCount; ++i)
-		if (strcmp(self->events[i]->name, eventName) == 0) return self->events[i];
-	return 0;
+	int index = _spSkeletonData_findEventIndex(self, eventName);
+	return index == -1 ? 0 : self->events[index];
+}
+
+static int _spSkeletonData_findAnimationIndex(const spSkeletonData *self, const char *animationName) {
+	const _spSkeletonData *internal = SUB_CAST(const _spSkeletonData, self);
+	FIND_INDEX(internal->animations, self->animations, self->animationsCount, animationName)
 }
 
 spAnimation *spSkeletonData_findAnimation(const spSkeletonData *self, const char *animationName) {
-	int i;
-	for (i = 0; i < self->animationsCount; ++i)
-		if (strcmp(self->animations[i]->name, animationName) == 0) return self->animations[i];
-	return 0;
+	int index = _spSkeletonData_findAnimationIndex(self, animationName);
+	return index == -1 ? 0 : self->animations[index];
+}
+
+int spSkeletonData_findIkConstraintIndex(const spSkeletonData *self, const char *constraintName) {
+	const _spSkeletonData *internal = SUB_CAST(const _spSkeletonData, self);
+	FIND_INDEX(internal->ikConstraints, self->ikConstraints, self->ikConstraintsCount, constraintName)
 }
 
 spIkConstraintData *spSkeletonData_findIkConstraint(const spSkeletonData *self, const char *constraintName) {
-	int i;
-	for (i = 0; i < self->ikConstraintsCount; ++i)
-		if (strcmp(self->ikConstraints[i]->name, constraintName) == 0) return self->ikConstraints[i];
-	return 0;
+	int index = spSkeletonData_findIkConstraintIndex(self, constraintName);
+	return index == -1 ? 0 : self->ikConstraints[index];
 }
 
-spTransformConstraintData *
-spSkeletonData_findTransformConstraint(const spSkeletonData *self, const char *constraintName) {
-	int i;
-	for (i = 0; i < self->transformConstraintsCount; ++i)
-		if (strcmp(self->transformConstraints[i]->name, constraintName) == 0) return self->transformConstraints[i];
-	return 0;
+int spSkeletonData_findTransformConstraintIndex(const spSkeletonData *self, const char *constraintName) {
+	const _spSkeletonData *internal = SUB_CAST(const _spSkeletonData, self);
+	FIND_INDEX(internal->transformConstraints, self->transformConstraints, self->transformConstraintsCount, constraintName)
+}
+
+spTransformConstraintData *spSkeletonData_findTransformConstraint(const spSkeletonData *self, const char *constraintName) {
+	int index = spSkeletonData_findTransformConstraintIndex(self, constraintName);
+	return index == -1 ? 0 : self->transformConstraints[index];
+}
+
+int spSkeletonData_findPathConstraintIndex(const spSkeletonData *self, const char *constraintName) {
+	const _spSkeletonData *internal = SUB_CAST(const _spSkeletonData, self);
+	FIND_INDEX(internal->pathConstraints, self->pathConstraints, self->pathConstraintsCount, constraintName)
 }
 
 spPathConstraintData *spSkeletonData_findPathConstraint(const spSkeletonData *self, const char *constraintName) {
-	int i;
-	for (i = 0; i < self->pathConstraintsCount; ++i)
-		if (strcmp(self->pathConstraints[i]->name, constraintName) == 0) return self->pathConstraints[i];
-	return 0;
+	int index = spSkeletonData_findPathConstraintIndex(self, constraintName);
+	return index == -1 ? 0 : self->pathConstraints[index];
+}
+
+int spSkeletonData_findPhysicsConstraintIndex(const spSkeletonData *self, const char *constraintName) {
+	const _spSkeletonData *internal = SUB_CAST(const _spSkeletonData, self);
+	FIND_INDEX(internal->physicsConstraints, self->physicsConstraints, self->physicsConstraintsCount, constraintName)
 }
 
 spPhysicsConstraintData *spSkeletonData_findPhysicsConstraint(const spSkeletonData *self, const char *constraintName) {
-	int i;
-	for (i = 0; i < self->physicsConstraintsCount; ++i)
-		if (strcmp(self->physicsConstraints[i]->name, constraintName) == 0) return self->physicsConstraints[i];
-	return 0;
+	int index = spSkeletonData_findPhysicsConstraintIndex(self, constraintName);
+	return index == -1 ? 0 : self->physicsConstraints[index];
 }
@@ -283,6 +283,7 @@ static spAnimation *_spSkeletonJson_readAnimation(spSkeletonJson *self, Json *ro
 	spTimelineArray *timelines = spTimelineArray_create(8);
 
 	float scale = self->scale, duration;
+	spAnimation *animation;
 	Json *bones = Json_getItem(root, "bones");
 	Json *slots = Json_getItem(root, "slots");
 	Json *ik = Json_getItem(root, "ik");
@@ -822,6 +823,7 @@ static spAnimation *_spSkeletonJson_readAnimation(spSkeletonJson *self, Json *ro
 							Json *vertices = Json_getItem(keyMap, "vertices");
 							float *deform;
 							float time2;
+							int start = 0, end = 0;
 
 							if (!vertices) {
 								if (weighted) {
@@ -830,8 +832,9 @@ static spAnimation *_spSkeletonJson_readAnimation(spSkeletonJson *self, Json *ro
 								} else
 									deform = vertexAttachment->vertices;
 							} else {
-								int v, start = Json_getInt(keyMap, "offset", 0);
+								int v;
 								Json *vertex;
+								start = Json_getInt(keyMap, "offset", 0);
 								deform = tempDeform;
 								memset(deform, 0, sizeof(float) * start);
 								if (self->scale == 1) {
@@ -842,13 +845,14 @@ static spAnimation *_spSkeletonJson_readAnimation(spSkeletonJson *self, Json *ro
 										deform[v] = vertex->valueFloat * self->scale;
 								}
 								memset(deform + v, 0, sizeof(float) * (deformLength - v));
+								end = v;
 								if (!weighted) {
 									float *verticesValues = vertexAttachment->vertices;
 									for (v = 0; v < deformLength; ++v)
 										deform[v] += verticesValues[v];
 								}
 							}
-							spDeformTimeline_setFrame(timeline, frame, time, deform);
+							spDeformTimeline_setFrameRange(timeline, frame, time, deform, start, end);
 							nextMap = keyMap->next;
 							if (!nextMap) {
 								/* timeline.shrink(); // BOZO */
@@ -961,7 +965,10 @@ static spAnimation *_spSkeletonJson_readAnimation(spSkeletonJson *self, Json *ro
 	duration = 0;
 	for (i = 0, n = timelines->size; i < n; ++i)
 		duration = MAX(duration, spTimeline_getDuration(timelines->items[i]));
-	return spAnimation_create(root->name, timelines, duration);
+	animation = spAnimation_create(root->name, timelines, duration);
+	spAnimation_setBezierEvaluation(animation, self->bezierEvaluation);
+	spAnimation_quantizeCurves(animation, self->curveBits, &self->curveReport);
+	return animation;
 }
 
 static void
@@ -1045,15 +1052,17 @@ spSkeletonData *spSkeletonJson_readSkeletonData(spSkeletonJson *self, const char
 	int i, ii;
 	spSkeletonData *skeletonData;
 	Json *root, *skeleton, *bones, *boneMap, *ik, *transform, *pathJson, *physics, *slots, *skins, *animations, *events;
+	const char *parseError;
 	_spSkeletonJson *internal = SUB_CAST(_spSkeletonJson, self);
 
 	FREE(self->error);
 	self->error = 0;
 	internal->linkedMeshCount = 0;
+	memset(&self->curveReport, 0, sizeof(spCurveQuantizeReport));
 
-	root = Json_create(json);
+	root = Json_create(json, &parseError);
 	if (!root) {
-		_spSkeletonJson_setError(self, 0, "Invalid skeleton JSON: ", Json_getError());
+		_spSkeletonJson_setError(self, 0, "Invalid skeleton JSON: ", parseError);
 		return NULL;
 	}
 
@@ -1586,7 +1595,7 @@ spSkeletonData *spSkeletonJson_readSkeletonData(spSkeletonJson *self, const char
 														  toColor(color, 3));
 								}
 
-								if (region->region != NULL) spRegionAttachment_updateRegion(region);
+								if (region->region != NULL || region->sequence != NULL) spRegionAttachment_updateRegion(region);
 
 								spAttachmentLoader_configureAttachment(self->attachmentLoader, attachment);
 								break;
@@ -1627,7 +1636,7 @@ spSkeletonData *spSkeletonJson_readSkeletonData(spSkeletonJson *self, const char
 
 									_readVertices(self, attachmentMap, SUPER(mesh), verticesLength);
 
-									if (mesh->region != NULL) spMeshAttachment_updateRegion(mesh);
+									if (mesh->region != NULL || mesh->sequence != NULL) spMeshAttachment_updateRegion(mesh);
 
 									mesh->hullLength = Json_getInt(attachmentMap, "hull", 0);
 
@@ -1753,7 +1762,7 @@ spSkeletonData *spSkeletonJson_readSkeletonData(spSkeletonJson *self, const char
 		linkedMesh->mesh->super.timelineAttachment = linkedMesh->inheritTimeline ? parent
 																				 : SUPER(SUPER(linkedMesh->mesh));
 		spMeshAttachment_setParentMesh(linkedMesh->mesh, SUB_CAST(spMeshAttachment, parent));
-		if (linkedMesh->mesh->region != NULL) spMeshAttachment_updateRegion(linkedMesh->mesh);
+		if (linkedMesh->mesh->region != NULL || linkedMesh->mesh->sequence != NULL) spMeshAttachment_updateRegion(linkedMesh->mesh);
 		spAttachmentLoader_configureAttachment(self->attachmentLoader, SUPER(SUPER(linkedMesh->mesh)));
 	}
 
@@ -1798,5 +1807,8 @@ spSkeletonData *spSkeletonJson_readSkeletonData(spSkeletonJson *self, const char
 	}
 
 	Json_dispose(root);
+	spSkeletonData_updateIndex(skeletonData);
+	_spSkeletonData_updateAttachmentKeys(skeletonData);
+	_spSkeletonData_updateDeformCapacities(skeletonData);
 	return skeletonData;
 }
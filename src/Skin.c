@@ -124,6 +124,7 @@ void spSkin_setAttachment(spSkin *self, int slotIndex, const char *name, spAttac
 	}
 
 	if (attachment) attachment->refCount++;
+	SUB_CAST(_spSkin, self)->modifications++;
 
 	if (existingEntry) {
 		if (hashEntry->entry->attachment) spAttachment_dispose(hashEntry->entry->attachment);
@@ -271,6 +272,7 @@ void spSkin_clear(spSkin *self) {
 	}
 
 	SUB_CAST(_spSkin, self)->entries = 0;
+	SUB_CAST(_spSkin, self)->modifications++;
 
 	{
 		_SkinHashTableEntry **currentHashtableEntry = SUB_CAST(_spSkin, self)->entriesHashTable;
@@ -32,12 +32,20 @@
 
 spSlot *spSlot_create(spSlotData *data, spBone *bone) {
 	spSlot *self = NEW(spSlot);
+	_spSlot_init(self, data, bone, data->darkColor == 0 ? 0 : spColor_create());
+	return self;
+}
+
+void _spSlot_init(spSlot *self, spSlotData *data, spBone *bone, spColor *darkColor) {
 	self->data = data;
 	self->bone = bone;
 	spColor_setFromFloats(&self->color, 1, 1, 1, 1);
-	self->darkColor = data->darkColor == 0 ? 0 : spColor_create();
+	self->darkColor = data->darkColor == 0 ? 0 : darkColor;
+	if (data->deformCapacity > 0) {
+		self->deform = MALLOC(float, data->deformCapacity);
+		self->deformCapacity = data->deformCapacity;
+	}
 	spSlot_setToSetupPose(self);
-	return self;
 }
 
 void spSlot_dispose(spSlot *self) {
@@ -78,8 +86,7 @@ void spSlot_setToSetupPose(spSlot *self) {
 	if (!self->data->attachmentName)
 		spSlot_setAttachment(self, 0);
 	else {
-		spAttachment *attachment = spSkeleton_getAttachmentForSlotIndex(
-				self->bone->skeleton, self->data->index, self->data->attachmentName);
+		spAttachment *attachment = _spSkeleton_getSetupAttachment(self->bone->skeleton, self->data);
 		self->attachment = 0;
 		spSlot_setAttachment(self, attachment);
 	}
@@ -0,0 +1,245 @@
+/******************************************************************************
+ * Spine Runtimes License Agreement
+ * Last updated July 28, 2023. Replaces all prior versions.
+ *
+ * Copyright (c) 2013-2023, Esoteric Software LLC
+ *
+ * Integration of the Spine Runtimes into software or otherwise creating
+ * derivative works of the Spine Runtimes is permitted under the terms and
+ * conditions of Section 2 of the Spine Editor License Agreement:
+ * http://esotericsoftware.com/spine-editor-license
+ *
+ * Otherwise, it is permitted to integrate the Spine Runtimes into software or
+ * otherwise create derivative works of the Spine Runtimes (collectively,
+ * "Products"), provided that each user of the Products must obtain their own
+ * Spine Editor license and redistribution of the Products in any form must
+ * include this license and copyright notice.
+ *
+ * THE SPINE RUNTIMES ARE PROVIDED BY ESOTERIC SOFTWARE LLC "AS IS" AND ANY
+ * EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ * WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL ESOTERIC SOFTWARE LLC BE LIABLE FOR ANY
+ * DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ * (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES,
+ * BUSINESS INTERRUPTION, OR LOSS OF USE, DATA, OR PROFITS) HOWEVER CAUSED AND
+ * ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THE
+ * SPINE RUNTIMES, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *****************************************************************************/
+
+
+#ifndef _DEFAULT_SOURCE
+/* Bring sysconf into unistd.h. */
+#define _DEFAULT_SOURCE
+#endif
+
+#include <spine/TickPool.h>
+#include <spine/extension.h>
+
+/* The platform layer: threads, a mutex, and condition variables. Without threads, starting a thread fails. */
+#if defined(SPINE_NO_THREADS)
+typedef int _spThread;
+typedef int _spMutex;
+typedef int _spCondition;
+#define THREAD_RESULT int
+#define THREAD_CALL
+#define THREAD_START(THREAD, FUNCTION, ARG) ((void) (FUNCTION), 0)
+#define THREAD_JOIN(THREAD) ((void) (THREAD))
+#define MUTEX_INIT(MUTEX) ((void) (MUTEX))
+#define MUTEX_DESTROY(MUTEX) ((void) (MUTEX))
+#define MUTEX_LOCK(MUTEX) ((void) (MUTEX))
+#define MUTEX_UNLOCK(MUTEX) ((void) (MUTEX))
+#define CONDITION_INIT(CONDITION) ((void) (CONDITION))
+#define CONDITION_DESTROY(CONDITION) ((void) (CONDITION))
+#define CONDITION_WAIT(CONDITION, MUTEX) ((void) (CONDITION))
+#define CONDITION_SIGNAL(CONDITION) ((void) (CONDITION))
+#define CONDITION_BROADCAST(CONDITION) ((void) (CONDITION))
+#define PROCESSOR_COUNT() 1
+#elif defined(_WIN32)
+#include <windows.h>
+typedef HANDLE _spThread;
+typedef CRITICAL_SECTION _spMutex;
+typedef CONDITION_VARIABLE _spCondition;
+#define THREAD_RESULT DWORD
+#define THREAD_CALL WINAPI
+#define THREAD_START(THREAD, FUNCTION, ARG) ((*(THREAD) = CreateThread(0, 0, FUNCTION, ARG, 0, 0)) != 0)
+#define THREAD_JOIN(THREAD) (WaitForSingleObject(THREAD, INFINITE), CloseHandle(THREAD))
+#define MUTEX_INIT(MUTEX) InitializeCriticalSection(MUTEX)
+#define MUTEX_DESTROY(MUTEX) DeleteCriticalSection(MUTEX)
+#define MUTEX_LOCK(MUTEX) EnterCriticalSection(MUTEX)
+#define MUTEX_UNLOCK(MUTEX) LeaveCriticalSection(MUTEX)
+#define CONDITION_INIT(CONDITION) InitializeConditionVariable(CONDITION)
+#define CONDITION_DESTROY(CONDITION)
+#define CONDITION_WAIT(CONDITION, MUTEX) SleepConditionVariableCS(CONDITION, MUTEX, INFINITE)
+#define CONDITION_SIGNAL(CONDITION) WakeConditionVariable(CONDITION)
+#define CONDITION_BROADCAST(CONDITION) WakeAllConditionVariable(CONDITION)
+static int _spProcessorCount(void) {
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return (int) info.dwNumberOfProcessors;
+}
+#define PROCESSOR_COUNT() _spProcessorCount()
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t _spThread;
+typedef pthread_mutex_t _spMutex;
+typedef pthread_cond_t _spCondition;
+#define THREAD_RESULT void *
+#define THREAD_CALL
+#define THREAD_START(THREAD, FUNCTION, ARG) (pthread_create(THREAD, 0, FUNCTION, ARG) == 0)
+#define THREAD_JOIN(THREAD) pthread_join(THREAD, 0)
+#define MUTEX_INIT(MUTEX) pthread_mutex_init(MUTEX, 0)
+#define MUTEX_DESTROY(MUTEX) pthread_mutex_destroy(MUTEX)
+#define MUTEX_LOCK(MUTEX) pthread_mutex_lock(MUTEX)
+#define MUTEX_UNLOCK(MUTEX) pthread_mutex_unlock(MUTEX)
+#define CONDITION_INIT(CONDITION) pthread_cond_init(CONDITION, 0)
+#define CONDITION_DESTROY(CONDITION) pthread_cond_destroy(CONDITION)
+#define CONDITION_WAIT(CONDITION, MUTEX) pthread_cond_wait(CONDITION, MUTEX)
+#define CONDITION_SIGNAL(CONDITION) pthread_cond_signal(CONDITION)
+#define CONDITION_BROADCAST(CONDITION) pthread_cond_broadcast(CONDITION)
+#define PROCESSOR_COUNT() ((int) sysconf(_SC_NPROCESSORS_ONLN))
+#endif
+
+/* The chunks a thread was given. Any thread claims the next chunk by incrementing next. */
+typedef struct {
+	volatile long next;
+	long end;
+	char padding[64]; /* Keeps the queues of different threads off the same cache line. */
+} _spTickQueue;
+
+typedef struct {
+	struct _spTickPool *pool;
+	int index;
+	_spThread thread;
+} _spTickWorker;
+
+typedef struct _spTickPool {
+	spTickPool super;
+	_spTickQueue *queues; /* One per thread, the calling thread's first. */
+	_spTickWorker *workers;
+
+	_spMutex mutex;
+	_spCondition start, done;
+	int generation, busyCount, shutdown;
+
+	spTickInstance *instances;
+	int count, chunkSize;
+	float delta;
+	spPhysics physics;
+} _spTickPool;
+
+/* Ticks the chunks of the thread's own queue, then steals the chunks left in the other queues. */
+static void _spTickPool_work(_spTickPool *self, int index) {
+	int i, chunk, start, threadsCount = self->super.threadsCount;
+	for (i = 0; i < threadsCount; i++) {
+		_spTickQueue *queue = self->queues + (index + i) % threadsCount;
+		while ((chunk = _spNextId(&queue->next)) < queue->end) {
+			start = chunk * self->chunkSize;
+			spAnimationState_tickInstances(self->instances, start, MIN(start + self->chunkSize, self->count),
+										   self->delta, self->physics);
+		}
+	}
+}
+
+static THREAD_RESULT THREAD_CALL _spTickPool_run(void *arg) {
+	_spTickWorker *worker = (_spTickWorker *) arg;
+	_spTickPool *self = worker->pool;
+	int generation = 0;
+	while (1) {
+		MUTEX_LOCK(&self->mutex);
+		while (self->generation == generation && !self->shutdown)
+			CONDITION_WAIT(&self->start, &self->mutex);
+		if (self->shutdown) {
+			MUTEX_UNLOCK(&self->mutex);
+			break;
+		}
+		generation = self->generation;
+		MUTEX_UNLOCK(&self->mutex);
+
+		_spTickPool_work(self, worker->index);
+
+		MUTEX_LOCK(&self->mutex);
+		if (--self->busyCount == 0) CONDITION_SIGNAL(&self->done);
+		MUTEX_UNLOCK(&self->mutex);
+	}
+	return 0;
+}
+
+spTickPool *spTickPool_create(int threadsCount) {
+	_spTickPool *internal = NEW(_spTickPool);
+	spTickPool *self = SUPER(internal);
+	int i;
+	if (threadsCount <= 0) threadsCount = MAX(1, PROCESSOR_COUNT());
+	self->chunkSize = 16;
+
+	MUTEX_INIT(&internal->mutex);
+	CONDITION_INIT(&internal->start);
+	CONDITION_INIT(&internal->done);
+	internal->queues = CALLOC(_spTickQueue, threadsCount);
+	internal->workers = CALLOC(_spTickWorker, threadsCount);
+	self->threadsCount = 1;
+	for (i = 1; i < threadsCount; i++) {
+		_spTickWorker *worker = internal->workers + i;
+		worker->pool = internal;
+		worker->index = i;
+		if (!THREAD_START(&worker->thread, _spTickPool_run, worker)) break;
+		self->threadsCount++;
+	}
+	return self;
+}
+
+void spTickPool_dispose(spTickPool *self) {
+	_spTickPool *internal = SUB_CAST(_spTickPool, self);
+	int i;
+	MUTEX_LOCK(&internal->mutex);
+	internal->shutdown = 1;
+	CONDITION_BROADCAST(&internal->start);
+	MUTEX_UNLOCK(&internal->mutex);
+	for (i = 1; i < self->threadsCount; i++)
+		THREAD_JOIN(internal->workers[i].thread);
+
+	CONDITION_DESTROY(&internal->start);
+	CONDITION_DESTROY(&internal->done);
+	MUTEX_DESTROY(&internal->mutex);
+	FREE(internal->queues);
+	FREE(internal->workers);
+	FREE(internal);
+}
+
+void spTickPool_tick(spTickPool *self, spTickInstance *instances, int count, float delta, spPhysics physics) {
+	_spTickPool *internal = SUB_CAST(_spTickPool, self);
+	int i, chunkSize = MAX(1, self->chunkSize), chunksCount = (count + chunkSize - 1) / chunkSize;
+	int threadsCount = self->threadsCount;
+
+	if (threadsCount == 1 || chunksCount <= 1) {
+		spAnimationState_tickInstances(instances, 0, count, delta, physics);
+		spAnimationState_deliverTickEvents(instances, count);
+		return;
+	}
+
+	internal->instances = instances;
+	internal->count = count;
+	internal->chunkSize = chunkSize;
+	internal->delta = delta;
+	internal->physics = physics;
+	for (i = 0; i < threadsCount; i++) {
+		internal->queues[i].next = (long) chunksCount * i / threadsCount;
+		internal->queues[i].end = (long) chunksCount * (i + 1) / threadsCount;
+	}
+
+	MUTEX_LOCK(&internal->mutex);
+	internal->generation++;
+	internal->busyCount = threadsCount - 1;
+	CONDITION_BROADCAST(&internal->start);
+	MUTEX_UNLOCK(&internal->mutex);
+
+	_spTickPool_work(internal, 0);
+
+	MUTEX_LOCK(&internal->mutex);
+	while (internal->busyCount > 0)
+		CONDITION_WAIT(&internal->done, &internal->mutex);
+	MUTEX_UNLOCK(&internal->mutex);
+
+	spAnimationState_deliverTickEvents(instances, count);
+}
@@ -32,8 +32,14 @@
 #include <spine/extension.h>
 
 spTransformConstraint *spTransformConstraint_create(spTransformConstraintData *data, const spSkeleton *skeleton) {
-	int i;
 	spTransformConstraint *self = NEW(spTransformConstraint);
+	_spTransformConstraint_init(self, data, skeleton, MALLOC(spBone *, data->bonesCount));
+	return self;
+}
+
+void _spTransformConstraint_init(spTransformConstraint *self, spTransformConstraintData *data,
+								 const spSkeleton *skeleton, spBone **bones) {
+	int i;
 	self->data = data;
 	self->mixRotate = data->mixRotate;
 	self->mixX = data->mixX;
@@ -42,11 +48,10 @@ spTransformConstraint *spTransformConstraint_create(spTransformConstraintData *d
 	self->mixScaleY = data->mixScaleY;
 	self->mixShearY = data->mixShearY;
 	self->bonesCount = data->bonesCount;
-	self->bones = MALLOC(spBone *, self->bonesCount);
+	self->bones = bones;
 	for (i = 0; i < self->bonesCount; ++i)
 		self->bones[i] = spSkeleton_findBone(skeleton, self->data->bones[i]->name);
 	self->target = spSkeleton_findBone(skeleton, self->data->target->name);
-	return self;
 }
 
 void spTransformConstraint_dispose(spTransformConstraint *self) {
@@ -30,11 +30,10 @@
 #include <spine/VertexAttachment.h>
 #include <spine/extension.h>
 
-/* FIXME this is not thread-safe */
-static int nextID = 0;
+static volatile long nextID = 0;
 
 void _spVertexAttachment_init(spVertexAttachment *attachment) {
-	attachment->id = nextID++;
+	attachment->id = _spNextId(&nextID);
 	attachment->timelineAttachment = SUPER(attachment);
 }
 
@@ -52,11 +51,6 @@ void spVertexAttachment_computeWorldVertices(spVertexAttachment *self, spSlot *s
 	float *vertices;
 	int *bones;
 
-	if (self->super.type == SP_ATTACHMENT_MESH || self->super.type == SP_ATTACHMENT_LINKED_MESH) {
-		spMeshAttachment *mesh = SUB_CAST(spMeshAttachment, self);
-		if (mesh->sequence) spSequence_apply(mesh->sequence, slot, SUPER(self));
-	}
-
 	count = offset + (count >> 1) * stride;
 	skeleton = slot->bone->skeleton;
 	deformLength = slot->deformCount;
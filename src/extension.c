@@ -30,6 +30,10 @@
 #include <spine/extension.h>
 #include <stdio.h>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 float _spInternalRandom(void) {
 	return rand() / (float) RAND_MAX;
 }
@@ -65,6 +69,40 @@ void _spFree(void *ptr) {
 	freeFunc(ptr);
 }
 
+int _spNextId(volatile long *counter) {
+#if defined(_MSC_VER)
+	return (int) _InterlockedExchangeAdd(counter, 1);
+#elif defined(__GNUC__)
+	return (int) __sync_fetch_and_add(counter, 1);
+#else
+	return (int) (*counter)++;
+#endif
+}
+
+int /*boolean*/ _spCompareAndSwap(void *volatile *target, void *expected, void *value) {
+#if defined(_MSC_VER)
+	return _InterlockedCompareExchangePointer(target, value, expected) == expected;
+#elif defined(__GNUC__)
+	return __sync_bool_compare_and_swap(target, expected, value);
+#else
+	if (*target != expected) return 0;
+	*target = value;
+	return 1;
+#endif
+}
+
+int /*boolean*/ _spCompareAndSwapCount(volatile long *counter, long expected, long value) {
+#if defined(_MSC_VER)
+	return _InterlockedCompareExchange(counter, value, expected) == expected;
+#elif defined(__GNUC__)
+	return __sync_bool_compare_and_swap(counter, expected, value);
+#else
+	if (*counter != expected) return 0;
+	*counter = value;
+	return 1;
+#endif
+}
+
 float _spRandom(void) {
 	return randomFunc();
 }